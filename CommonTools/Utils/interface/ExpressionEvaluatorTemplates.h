@@ -2,13 +2,34 @@
 #define	CommonToolsUtilsExpressionEvaluatorTemplates_H
 #include <vector>
 #include <algorithm>
+#include <cmath>
 #include<numeric>
 #include<limits>
 #include<memory>
 #include<tuple>
+#include<stdexcept>
+
+#include "DataFormats/Math/interface/deltaPhi.h"
+#include "DataFormats/Math/interface/deltaR.h"
 
 namespace reco {
 
+  // used by the code generated from cut strings (StringCutObjectSelector)
+  namespace exprEvalCpp {
+    template<typename T> T const & deref(T const & t) { return t; }
+    template<typename T> T const & deref(T * t) {
+      if (!t) throw std::runtime_error("null pointer returned in a compiled cut string");
+      return *t;
+    }
+    inline double test_bit(double mask, double iBit) { return (int(mask) >> int(iBit)) & 1; }
+    // the arguments of the generated calls can be of any arithmetic type:
+    // convert them to double, as the interpreted functions do
+    inline double deltaPhi(double phi1, double phi2) { return reco::deltaPhi(phi1, phi2); }
+    inline double deltaR(double eta1, double phi1, double eta2, double phi2) {
+      return std::sqrt(reco::deltaR2(eta1, phi1, eta2, phi2));
+    }
+  }
+
   template<typename Ret, typename... Args>
   struct genericExpression {
     virtual Ret operator()(Args ...) const =0;
@@ -11,28 +11,55 @@
 #include "CommonTools/Utils/src/SelectorBase.h"
 #include "CommonTools/Utils/interface/cutParser.h"
 #include "FWCore/Utilities/interface/ObjectWithDict.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "CommonTools/Utils/interface/ExpressionEvaluator.h"
+#include "CommonTools/Utils/interface/ExpressionEvaluatorTemplates.h"
 
 template<typename T, bool DefaultLazyness=false>
 struct StringCutObjectSelector {
   StringCutObjectSelector(const std::string & cut, bool lazy=DefaultLazyness) : 
-    type_(typeid(T)) {
+    type_(typeid(T)), compiled_(0) {
     if(! reco::parser::cutParser<T>(cut, select_, lazy)) {
       throw edm::Exception(edm::errors::Configuration,
 			   "failed to parse \"" + cut + "\"");
     }
   }
+  /// as above, then translates the cut to C++ and compiles it with
+  /// reco::ExpressionEvaluator against pkg/src/precompile.h, which must
+  /// declare T. If that is not possible (lazy cuts, functions without a
+  /// C++ counterpart, compilation errors) the cut is interpreted as usual.
+  /// Compiled cuts are kept across jobs if CMSSW_EXPRESSION_CACHE is set.
+  StringCutObjectSelector(const std::string & cut, bool lazy, const char * pkg) :
+    StringCutObjectSelector(cut, lazy) {
+    std::string code;
+    if(select_->cppCode(code)) {
+      std::string type = type_.cppName();
+      try {
+	reco::ExpressionEvaluator eval(pkg, ("reco::CutOnObject<" + type + ">").c_str(),
+				       "bool eval(" + type + " const & obj) const override { return " + code + "; }");
+	compiled_ = eval.expr<reco::CutOnObject<T> >();
+      } catch(cms::Exception const &) {
+	compiled_ = 0;
+      }
+    }
+  }
   StringCutObjectSelector(const reco::parser::SelectorPtr & select) : 
     select_(select),
-    type_(typeid(T)) {
+    type_(typeid(T)), compiled_(0) {
   }
   bool operator()(const T & t) const {
+    if(compiled_) return compiled_->eval(t);
     edm::ObjectWithDict o(type_, const_cast<T *>(& t));
     return (*select_)(o);  
   }
+  /// true if the cut runs as compiled code
+  bool isCompiled() const { return compiled_ != 0; }
 
 private:
   reco::parser::SelectorPtr select_;
   edm::TypeWithDict type_;
+  // owned by the library loaded by ExpressionEvaluator, which is never unloaded
+  reco::CutOnObject<T> const * compiled_;
 };
 
 #endif
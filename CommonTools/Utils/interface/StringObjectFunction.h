@@ -11,28 +11,52 @@
 #include "CommonTools/Utils/src/ExpressionBase.h"
 #include "CommonTools/Utils/interface/expressionParser.h"
 #include "FWCore/Utilities/interface/ObjectWithDict.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "CommonTools/Utils/interface/ExpressionEvaluator.h"
+#include "CommonTools/Utils/interface/ExpressionEvaluatorTemplates.h"
 
 template<typename T, bool DefaultLazyness=false>
 struct StringObjectFunction {
   StringObjectFunction(const std::string & expr, bool lazy=DefaultLazyness) : 
-    type_(typeid(T)) {
+    type_(typeid(T)), compiled_(0) {
     if(! reco::parser::expressionParser<T>(expr, expr_, lazy)) {
       throw edm::Exception(edm::errors::Configuration,
 			   "failed to parse \"" + expr + "\"");
     }
   }
+  /// as above, then compiles the expression to C++ with
+  /// reco::ExpressionEvaluator (see StringCutObjectSelector)
+  StringObjectFunction(const std::string & expr, bool lazy, const char * pkg) :
+    StringObjectFunction(expr, lazy) {
+    std::string code;
+    if(expr_->cppCode(code)) {
+      std::string type = type_.cppName();
+      try {
+	reco::ExpressionEvaluator eval(pkg, ("reco::ValueOnObject<" + type + ">").c_str(),
+				       "double eval(" + type + " const & obj) const override { return " + code + "; }");
+	compiled_ = eval.expr<reco::ValueOnObject<T> >();
+      } catch(cms::Exception const &) {
+	compiled_ = 0;
+      }
+    }
+  }
   StringObjectFunction(const reco::parser::ExpressionPtr & expr) : 
     expr_(expr),
-    type_(typeid(T)) {
+    type_(typeid(T)), compiled_(0) {
   }
   double operator()(const T & t) const {
+    if(compiled_) return compiled_->eval(t);
     edm::ObjectWithDict o(type_, const_cast<T *>(& t));
     return expr_->value(o);  
   }
+  /// true if the expression runs as compiled code
+  bool isCompiled() const { return compiled_ != 0; }
 
 private:
   reco::parser::ExpressionPtr expr_;
   edm::TypeWithDict type_;
+  // owned by the library loaded by ExpressionEvaluator, which is never unloaded
+  reco::ValueOnObject<T> const * compiled_;
 };
 
 #endif
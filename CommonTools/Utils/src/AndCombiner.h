@@ -21,6 +21,14 @@ namespace reco {
       virtual bool operator()(const edm::ObjectWithDict& o) const {
 	return (*lhs_)(o) && (*rhs_)(o);
       }
+      virtual bool cppCode(std::string & code) const {
+	code += '(';
+	if (!lhs_->cppCode(code)) return false;
+	code += " && ";
+	if (!rhs_->cppCode(code)) return false;
+	code += ')';
+	return true;
+      }
     private:
       SelectorPtr lhs_, rhs_;
     };
@@ -6,6 +6,7 @@ namespace reco {
   namespace parser {
     class AnyObjSelector : public SelectorBase {
       virtual bool operator()(const edm::ObjectWithDict & c) const { return true; }
+      virtual bool cppCode(std::string & code) const { code += "true"; return true; }
     };
   }
 }
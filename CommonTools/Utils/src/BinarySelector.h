@@ -25,6 +25,15 @@ namespace reco {
       virtual bool operator()( const edm::ObjectWithDict & o ) const {
 	return cmp_->compare( lhs_->value( o ), rhs_->value( o ) );
       }
+      virtual bool cppCode( std::string & code ) const {
+	if( cmp_->cppName() == 0 ) return false;
+	code += cmp_->cppName(); code += '(';
+	if( !lhs_->cppCode( code ) ) return false;
+	code += ", ";
+	if( !rhs_->cppCode( code ) ) return false;
+	code += ')';
+	return true;
+      }
       boost::shared_ptr<ExpressionBase> lhs_;
       boost::shared_ptr<ComparisonBase> cmp_;
       boost::shared_ptr<ExpressionBase> rhs_;
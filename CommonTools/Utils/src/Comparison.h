@@ -11,12 +11,14 @@
  *
  */
 #include "CommonTools/Utils/src/ComparisonBase.h"
+#include "CommonTools/Utils/src/CppOperator.h"
 
 namespace reco {
   namespace parser {
     template<class CompT>
     struct Comparison : public ComparisonBase {
       virtual bool compare(double lhs, double rhs) const { return comp(lhs, rhs); }
+      virtual const char * cppName() const { return CppOperator<CompT>::name(); }
     private:
       CompT comp;
     };
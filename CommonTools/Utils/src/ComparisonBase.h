@@ -16,6 +16,8 @@ namespace reco {
     struct ComparisonBase {
       virtual ~ComparisonBase() { }
       virtual bool compare( double, double ) const = 0;
+      /// callable doing the comparison in generated C++ code, 0 if none
+      virtual const char * cppName() const { return 0; }
     };
   }
 }
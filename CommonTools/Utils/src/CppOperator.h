@@ -0,0 +1,60 @@
+#ifndef CommonTools_Utils_CppOperator_h
+#define CommonTools_Utils_CppOperator_h
+/* \class reco::parser::CppOperator
+ *
+ * C++ spelling of the functors used by the parsed expressions,
+ * for the code generated from them (see ExpressionBase::cppCode)
+ *
+ */
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+
+namespace reco {
+  namespace parser {
+    /// callable doing in the generated code what Op does, 0 if there is none
+    template<typename Op>
+    struct CppOperator { static const char * name() { return 0; } };
+
+    template<> struct CppOperator<std::plus<double> >          { static const char * name() { return "std::plus<double>()"; } };
+    template<> struct CppOperator<std::minus<double> >         { static const char * name() { return "std::minus<double>()"; } };
+    template<> struct CppOperator<std::multiplies<double> >    { static const char * name() { return "std::multiplies<double>()"; } };
+    template<> struct CppOperator<std::divides<double> >       { static const char * name() { return "std::divides<double>()"; } };
+    template<> struct CppOperator<std::negate<double> >        { static const char * name() { return "std::negate<double>()"; } };
+    template<> struct CppOperator<std::less<double> >          { static const char * name() { return "std::less<double>()"; } };
+    template<> struct CppOperator<std::greater<double> >       { static const char * name() { return "std::greater<double>()"; } };
+    template<> struct CppOperator<std::less_equal<double> >    { static const char * name() { return "std::less_equal<double>()"; } };
+    template<> struct CppOperator<std::greater_equal<double> > { static const char * name() { return "std::greater_equal<double>()"; } };
+    template<> struct CppOperator<std::equal_to<double> >      { static const char * name() { return "std::equal_to<double>()"; } };
+    template<> struct CppOperator<std::not_equal_to<double> >  { static const char * name() { return "std::not_equal_to<double>()"; } };
+    template<> struct CppOperator<std::logical_not<bool> >     { static const char * name() { return "std::logical_not<bool>()"; } };
+
+    /// appends a double literal with the exact value
+    inline bool cppNumber(double value, std::string & code) {
+      if(!std::isfinite(value)) return false;
+      char buf[32];
+      snprintf(buf, sizeof(buf), "%.17g", value);
+      code += "double("; code += buf; code += ')';
+      return true;
+    }
+
+    /// appends "fun(arg0, arg1, ...)", each argument being something with a cppCode method
+    template<typename Op, typename... Args>
+    bool cppCall(std::string & code, Args const&... args) {
+      const char * fun = CppOperator<Op>::name();
+      if(fun == 0) return false;
+      code += fun; code += '(';
+      bool ok = true, first = true;
+      for(auto arg : { &args... }) {
+	if(!first) code += ", ";
+	first = false;
+	ok = ok && (*arg)->cppCode(code);
+      }
+      code += ')';
+      return ok;
+    }
+  }
+}
+
+#endif
@@ -9,6 +9,7 @@
  *
  */
 #include <boost/shared_ptr.hpp>
+#include <string>
 #include <vector>
 
 namespace edm { class ObjectWithDict; }
@@ -18,6 +19,9 @@ namespace reco {
     struct ExpressionBase {
       virtual ~ExpressionBase() { }
       virtual double value( const edm::ObjectWithDict & ) const = 0;
+      /// appends the C++ code computing the same value for an object named
+      /// "obj"; false if this expression cannot be translated
+      virtual bool cppCode( std::string & ) const { return false; }
     };
     typedef boost::shared_ptr<ExpressionBase> ExpressionPtr;
   }
@@ -12,6 +12,7 @@
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
 #include "CommonTools/Utils/src/ExpressionStack.h"
+#include "CommonTools/Utils/src/CppOperator.h"
 
 namespace reco {
   namespace parser {
@@ -20,6 +21,9 @@ namespace reco {
       virtual double value(const edm::ObjectWithDict& o) const { 
 	return op_((*lhs_).value(o), (*rhs_).value(o));
       }
+      virtual bool cppCode(std::string & code) const {
+	return cppCall<Op>(code, lhs_, rhs_);
+      }
       ExpressionBinaryOperator(ExpressionStack & expStack) { 
 	rhs_ = expStack.back(); expStack.pop_back();
 	lhs_ = expStack.back(); expStack.pop_back();
@@ -22,6 +22,8 @@ namespace reco {
       T operator()(T lhs, T rhs) const { return pow(lhs, rhs); }
     };
 
+    template<> struct CppOperator<power_of<double> > { static const char * name() { return "std::pow"; } };
+
     template<typename Op>
     struct ExpressionBinaryOperatorSetter {
       ExpressionBinaryOperatorSetter(ExpressionStack & stack) : stack_(stack) { }
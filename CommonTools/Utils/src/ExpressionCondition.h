@@ -20,6 +20,16 @@ namespace reco {
       virtual double value(const edm::ObjectWithDict& o) const { 
 	return (*cond_)(o) ? true_->value(o) : false_->value(o);
       }
+      virtual bool cppCode(std::string & code) const {
+	code += '(';
+	if(!cond_->cppCode(code)) return false;
+	code += " ? ";
+	if(!true_->cppCode(code)) return false;
+	code += " : ";
+	if(!false_->cppCode(code)) return false;
+	code += ')';
+	return true;
+      }
       ExpressionCondition(ExpressionStack & expStack, SelectorStack & selStack) { 
 	false_ = expStack.back(); expStack.pop_back();
 	true_  = expStack.back(); expStack.pop_back();
@@ -2,13 +2,17 @@
 #include "FWCore/Version/interface/GetReleaseVersion.h"
 #include "FWCore/Utilities/interface/GetEnvironmentVariable.h"
 #include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/Digest.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 #include "popenCPP.h"
 
+#include <cstdio>
 #include <fstream>
 #include <regex>
+#include <sstream>
 #include <dlfcn.h>
+#include <sys/stat.h>
 
 // #define VI_DEBUG
 
@@ -64,6 +68,7 @@ ExpressionEvaluator::ExpressionEvaluator(const char * pkg, const char * iname, s
   std::string ofile = "/tmp/"+m_name+".so";
 
   auto arch = edm::getEnvironmentVariable("SCRAM_ARCH");
+
   auto baseDir = edm::getEnvironmentVariable("CMSSW_BASE");
   auto relDir = edm::getEnvironmentVariable("CMSSW_RELEASE_BASE");
 
@@ -106,6 +111,46 @@ ExpressionEvaluator::ExpressionEvaluator(const char * pkg, const char * iname, s
 
   }
 
+  // if CMSSW_EXPRESSION_CACHE names a directory the libraries are kept there,
+  // named after the expression and everything the compilation depends on:
+  // the release, the developer area, the flags and the precompiled header
+  // actually used, so that a rebuilt header or a patched area compiles anew
+  std::string cname = m_name;
+  std::string cfile;
+  auto cacheDir = edm::getEnvironmentVariable("CMSSW_EXPRESSION_CACHE");
+  if (!cacheDir.empty()) {
+    cms::Digest digest(edm::getReleaseVersion());
+    digest.append(arch);
+    digest.append(baseDir);
+    digest.append(incDir);
+    digest.append(cxxf);
+    digest.append(pch);
+    {
+      std::ifstream header((incDir + pch).c_str());
+      std::ostringstream content;
+      content << header.rdbuf();
+      digest.append(content.str());
+    }
+    struct stat st;
+    if (0 == ::stat((incDir + pch + ".gch").c_str(), &st)) {
+      std::ostringstream gch;
+      gch << st.st_mtime << ' ' << st.st_size;
+      digest.append(gch.str());
+    }
+    digest.append(iname);
+    digest.append(iexpr);
+    cname = "VI_" + digest.digest().toString();
+    cfile = cacheDir + '/' + cname + ".so";
+    ofile = cacheDir + '/' + m_name + ".so";
+
+    void * dl = dlopen(cfile.c_str(),RTLD_LAZY);
+    if (dl) {
+      COUT << "using cached " << cfile << std::endl;
+      m_expr = dlsym(dl,("factory" + cname).c_str());
+      if (m_expr) return;
+    }
+  }
+
   std::string cpp = "c++ -H -Wall -shared -Winvalid-pch "; cpp+=cxxf;
   cpp += " -I" + incDir; 
   cpp += " -o " + ofile + ' ' + sfile+" 2>&1\n";
@@ -114,16 +159,16 @@ ExpressionEvaluator::ExpressionEvaluator(const char * pkg, const char * iname, s
 
 
   //  prepare the file to compile
-  std::string factory = "factory" + m_name;
+  std::string factory = "factory" + cname;
 
   std::string source = std::string("#include ")+quote+ pch +quote+"\n";
-  source+="struct "+m_name+" final : public "+iname + "{\n";
+  source+="struct "+cname+" final : public "+iname + "{\n";
   source+=iexpr;
   source+="\n};\n";
 
 
   source += "extern " + quote+'C'+quote+' ' + std::string(iname) + "* "+factory+"() {\n";
-  source += "static "+m_name+" local;\n";
+  source += "static "+cname+" local;\n";
   source += "return &local;\n}\n";
 
 
@@ -140,7 +185,12 @@ ExpressionEvaluator::ExpressionEvaluator(const char * pkg, const char * iname, s
   auto ss = execSysCommand(cpp);
   COUT << ss << std::endl;
 
+  // publish the library in the cache in one go: concurrent jobs
+  // compiling the same expression just replace each other's copy
+  if (!cfile.empty() && 0 == std::rename(ofile.c_str(), cfile.c_str())) ofile = cfile;
+
   void * dl = dlopen(ofile.c_str(),RTLD_LAZY);
+  if (!cfile.empty() && ofile != cfile) std::remove(ofile.c_str());
   if (!dl) {
      remove(m_name);
      throw  cms::Exception("ExpressionEvaluator", std::string("compilation/linking failed\n") +  cpp + ss + "dlerror " + dlerror());
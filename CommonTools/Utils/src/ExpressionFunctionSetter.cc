@@ -32,6 +32,30 @@ namespace reco {
     struct tan_f { double operator()( double x ) const { return tan( x ); } };
     struct tanh_f { double operator()( double x ) const { return tanh( x ); } };
     struct test_bit_f { double operator()( double mask, double iBit ) const { return (int(mask) >> int(iBit)) & 1; } };
+
+    template<> struct CppOperator<abs_f>      { static const char * name() { return "std::abs"; } };
+    template<> struct CppOperator<acos_f>     { static const char * name() { return "std::acos"; } };
+    template<> struct CppOperator<asin_f>     { static const char * name() { return "std::asin"; } };
+    template<> struct CppOperator<atan_f>     { static const char * name() { return "std::atan"; } };
+    template<> struct CppOperator<atan2_f>    { static const char * name() { return "std::atan2"; } };
+    template<> struct CppOperator<cos_f>      { static const char * name() { return "std::cos"; } };
+    template<> struct CppOperator<cosh_f>     { static const char * name() { return "std::cosh"; } };
+    template<> struct CppOperator<deltaR_f>   { static const char * name() { return "reco::exprEvalCpp::deltaR"; } };
+    template<> struct CppOperator<deltaPhi_f> { static const char * name() { return "reco::exprEvalCpp::deltaPhi"; } };
+    template<> struct CppOperator<exp_f>      { static const char * name() { return "std::exp"; } };
+    template<> struct CppOperator<hypot_f>    { static const char * name() { return "std::hypot"; } };
+    template<> struct CppOperator<log_f>      { static const char * name() { return "std::log"; } };
+    template<> struct CppOperator<log10_f>    { static const char * name() { return "std::log10"; } };
+    template<> struct CppOperator<max_f>      { static const char * name() { return "std::max<double>"; } };
+    template<> struct CppOperator<min_f>      { static const char * name() { return "std::min<double>"; } };
+    template<> struct CppOperator<pow_f>      { static const char * name() { return "std::pow"; } };
+    template<> struct CppOperator<sin_f>      { static const char * name() { return "std::sin"; } };
+    template<> struct CppOperator<sinh_f>     { static const char * name() { return "std::sinh"; } };
+    template<> struct CppOperator<sqrt_f>     { static const char * name() { return "std::sqrt"; } };
+    template<> struct CppOperator<tan_f>      { static const char * name() { return "std::tan"; } };
+    template<> struct CppOperator<tanh_f>     { static const char * name() { return "std::tanh"; } };
+    template<> struct CppOperator<test_bit_f> { static const char * name() { return "reco::exprEvalCpp::test_bit"; } };
+    // chi2prob has no counterpart in the generated code: cuts using it stay interpreted
   }
 }
 
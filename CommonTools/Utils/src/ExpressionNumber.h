@@ -11,11 +11,13 @@
  *
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
+#include "CommonTools/Utils/src/CppOperator.h"
 
 namespace reco {
   namespace parser {
     struct ExpressionNumber : public ExpressionBase {
       virtual double value( const edm::ObjectWithDict& ) const { return value_; }
+      virtual bool cppCode( std::string & code ) const { return cppNumber( value_, code ); }
       ExpressionNumber( double value ) : value_( value ) { }
     private:
       double value_;
@@ -12,6 +12,7 @@
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
 #include "CommonTools/Utils/src/ExpressionStack.h"
+#include "CommonTools/Utils/src/CppOperator.h"
 
 namespace reco {
   namespace parser {
@@ -20,6 +21,9 @@ namespace reco {
       virtual double value(const edm::ObjectWithDict& o) const { 
 	return op_(args_[0]->value(o), args_[1]->value(o), args_[2]->value(o), args_[3]->value(o));
       }
+      virtual bool cppCode(std::string & code) const {
+	return cppCall<Op>(code, args_[0], args_[1], args_[2], args_[3]);
+      }
       ExpressionQuaterOperator(ExpressionStack & expStack) { 
 	args_[3] = expStack.back(); expStack.pop_back();
 	args_[2] = expStack.back(); expStack.pop_back();
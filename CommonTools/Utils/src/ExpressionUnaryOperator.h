@@ -12,6 +12,7 @@
  */
 #include "CommonTools/Utils/src/ExpressionBase.h"
 #include "CommonTools/Utils/src/ExpressionStack.h"
+#include "CommonTools/Utils/src/CppOperator.h"
 
 namespace reco {
   namespace parser {
@@ -20,6 +21,9 @@ namespace reco {
       virtual double value(const edm::ObjectWithDict& o) const { 
 	return op_((*exp_).value(o));
       }
+      virtual bool cppCode(std::string & code) const {
+	return cppCall<Op>(code, exp_);
+      }
       ExpressionUnaryOperator(ExpressionStack & expStack) { 
 	exp_ = expStack.back(); expStack.pop_back();
       }
@@ -14,8 +14,9 @@ using namespace std;
 
 void ExpressionVar::initObjects_()
 {
-  objects_.resize(methods_.size());
-  std::vector<edm::ObjectWithDict>::iterator IO = objects_.begin();
+  std::vector<edm::ObjectWithDict>& objects = objects_.local();
+  objects.resize(methods_.size());
+  std::vector<edm::ObjectWithDict>::iterator IO = objects.begin();
   for (std::vector<MethodInvoker>::const_iterator I = methods_.begin(), E = methods_.end(); I != E; ++IO, ++I) {
     if (I->isFunction()) {
       edm::TypeWithDict retType = I->method().finalReturnType();
@@ -28,6 +29,23 @@ void ExpressionVar::initObjects_()
   }
 }
 
+std::vector<edm::ObjectWithDict>& ExpressionVar::objects() const
+{
+  bool exists = false;
+  std::vector<edm::ObjectWithDict>& objects = objects_.local(exists);
+  if (!exists) {
+    // first call on this thread: the slots of the constructing thread
+    // are made in initObjects_
+    objects.resize(methods_.size());
+    for (size_t i = 0; i < methods_.size(); ++i) {
+      if (methods_[i].isFunction()) {
+        makeStorage(objects[i], methods_[i].method().finalReturnType());
+      }
+    }
+  }
+  return objects;
+}
+
 ExpressionVar::ExpressionVar(const vector<MethodInvoker>& methods,
                              method::TypeCode retType)
   : methods_(methods)
@@ -45,9 +63,10 @@ ExpressionVar::ExpressionVar(const ExpressionVar& rhs)
 
 ExpressionVar::~ExpressionVar()
 {
-  for (std::vector<edm::ObjectWithDict>::iterator I = objects_.begin(),
-      E = objects_.end(); I != E; ++I) {
-    delStorage(*I);
+  for (auto& objects : objects_) {
+    for (auto& obj : objects) {
+      delStorage(obj);
+    }
   }
   objects_.clear();
 }
@@ -144,13 +163,14 @@ bool ExpressionVar::isValidReturnType(method::TypeCode retType)
 double ExpressionVar::value(const edm::ObjectWithDict& obj) const
 {
   edm::ObjectWithDict val(obj);
-  std::vector<edm::ObjectWithDict>::iterator IO = objects_.begin();
+  std::vector<edm::ObjectWithDict>& objects = this->objects();
+  std::vector<edm::ObjectWithDict>::iterator IO = objects.begin();
   for (std::vector<MethodInvoker>::const_iterator I = methods_.begin(), E = methods_.end(); I != E; ++I, ++IO) {
     val = I->invoke(val, *IO);
   }
   double ret = objToDouble(val, retType_);
   std::vector<bool>::const_reverse_iterator RIB = needsDestructor_.rbegin();
-  for (std::vector<edm::ObjectWithDict>::reverse_iterator RI = objects_.rbegin(), RE = objects_.rend(); RI != RE; ++RIB, ++RI) {
+  for (std::vector<edm::ObjectWithDict>::reverse_iterator RI = objects.rbegin(), RE = objects.rend(); RI != RE; ++RIB, ++RI) {
     if (*RIB) {
       RI->destruct(false);
     }
@@ -158,6 +178,21 @@ double ExpressionVar::value(const edm::ObjectWithDict& obj) const
   return ret;
 }
 
+bool ExpressionVar::cppCode(std::string& code) const
+{
+  // pointers returned along the chain (also by Ref::get) are
+  // dereferenced by exprEvalCpp::deref, references pass through
+  std::string var("obj");
+  for (auto const& method : methods_) {
+    var = "reco::exprEvalCpp::deref(" + var + ")";
+    if (!method.cppCode(var)) {
+      return false;
+    }
+  }
+  code += "static_cast<double>(" + var + ")";
+  return true;
+}
+
 double
 ExpressionVar::objToDouble(const edm::ObjectWithDict& obj,
                            method::TypeCode type)
@@ -222,18 +257,20 @@ ExpressionLazyVar::~ExpressionLazyVar()
 double
 ExpressionLazyVar::value(const edm::ObjectWithDict& o) const
 {
+  // only class objects returned by value are collected here, getters
+  // returning numbers or references never allocate
+  std::vector<edm::ObjectWithDict> objects;
   edm::ObjectWithDict val = o;
   std::vector<LazyInvoker>::const_iterator I = methods_.begin();
   std::vector<LazyInvoker>::const_iterator E = methods_.end() - 1;
   for (; I < E; ++I) {
-    val = I->invoke(val, objects_);
+    val = I->invoke(val, objects);
   }
-  double ret = I->invokeLast(val, objects_);
+  double ret = I->invokeLast(val, objects);
   for (std::vector<edm::ObjectWithDict>::reverse_iterator RI =
-      objects_.rbegin(), RE = objects_.rend(); RI != RE; ++RI) {
+      objects.rbegin(), RE = objects.rend(); RI != RE; ++RI) {
     RI->destruct(false);
   }
-  objects_.clear();
   return ret;
 }
 
@@ -16,6 +16,8 @@
 
 #include <vector>
 
+#include "tbb/enumerable_thread_specific.h"
+
 namespace reco {
 namespace parser {
 
@@ -23,12 +25,14 @@ namespace parser {
 class ExpressionVar : public ExpressionBase {
 private: // Private Data Members
   std::vector<MethodInvoker> methods_;
-  mutable std::vector<edm::ObjectWithDict> objects_;
-  mutable std::vector<bool> needsDestructor_;
+  /// return slots of each method, one set per thread
+  mutable tbb::enumerable_thread_specific<std::vector<edm::ObjectWithDict> > objects_;
+  std::vector<bool> needsDestructor_;
   method::TypeCode retType_;
 
 private: // Private Methods
   void initObjects_();
+  std::vector<edm::ObjectWithDict>& objects() const;
 
 public: // Public Static Methods
   static bool isValidReturnType(method::TypeCode);
@@ -54,6 +58,7 @@ public: // Public Methods
   ExpressionVar(const ExpressionVar&);
   ~ExpressionVar();
   virtual double value(const edm::ObjectWithDict&) const;
+  virtual bool cppCode(std::string&) const;
 };
 
 /// Same as ExpressionVar but with lazy resolution of object methods
@@ -61,7 +66,6 @@ public: // Public Methods
 class ExpressionLazyVar : public ExpressionBase {
 private: // Private Data Members
   std::vector<LazyInvoker> methods_;
-  mutable std::vector<edm::ObjectWithDict> objects_;
 public:
   ExpressionLazyVar(const std::vector<LazyInvoker>& methods);
   ~ExpressionLazyVar();
@@ -10,3 +10,23 @@ bool LogicalBinaryOperator<std::logical_or<bool> >::operator()(const edm::Object
    return (*lhs_)(o) || (*rhs_)(o);
 }
 
+namespace {
+  bool cppLogical(const SelectorPtr & lhs, const char * op, const SelectorPtr & rhs, std::string & code) {
+    code += '(';
+    if (!lhs->cppCode(code)) return false;
+    code += op;
+    if (!rhs->cppCode(code)) return false;
+    code += ')';
+    return true;
+  }
+}
+
+template <>
+bool LogicalBinaryOperator<std::logical_and<bool> >::cppCode(std::string & code) const {
+   return cppLogical(lhs_, " && ", rhs_, code);
+}
+
+template <>
+bool LogicalBinaryOperator<std::logical_or<bool> >::cppCode(std::string & code) const {
+   return cppLogical(lhs_, " || ", rhs_, code);
+}
@@ -22,6 +22,7 @@ namespace reco {
 	lhs_ = selStack.back(); selStack.pop_back();
       }
       virtual bool operator()(const edm::ObjectWithDict& o) const ;
+      virtual bool cppCode(std::string & code) const ;
       private:
       Op op_;
       SelectorPtr lhs_, rhs_;
@@ -31,6 +32,12 @@ template <>
 bool LogicalBinaryOperator<std::logical_and<bool> >::operator()(const edm::ObjectWithDict &o) const ;
 template <>
 bool LogicalBinaryOperator<std::logical_or<bool> >::operator()(const edm::ObjectWithDict &o) const ;
+
+template <>
+bool LogicalBinaryOperator<std::logical_and<bool> >::cppCode(std::string & code) const ;
+
+template <>
+bool LogicalBinaryOperator<std::logical_or<bool> >::cppCode(std::string & code) const ;
   }
 }
 
@@ -12,6 +12,7 @@
  */
 #include "CommonTools/Utils/src/SelectorBase.h"
 #include "CommonTools/Utils/src/SelectorStack.h"
+#include "CommonTools/Utils/src/CppOperator.h"
 
 namespace reco {
   namespace parser {    
@@ -23,6 +24,9 @@ namespace reco {
       virtual bool operator()(const edm::ObjectWithDict& o) const {
 	return op_((*rhs_)(o));
       }
+      virtual bool cppCode(std::string & code) const {
+	return cppCall<Op>(code, rhs_);
+      }
       private:
       Op op_;
       SelectorPtr rhs_;
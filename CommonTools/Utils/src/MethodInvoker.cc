@@ -7,9 +7,40 @@
 #include "FWCore/Utilities/interface/EDMException.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <type_traits>
 using namespace reco::parser;
 using namespace std;
 
+namespace {
+  /// C++ literal for an already fixed up method argument
+  struct AnyMethodArgument2Cpp : public boost::static_visitor<std::string> {
+    template<typename T>
+    std::string operator()(const T& t) const {
+      if (std::is_signed<T>::value) {
+        return std::to_string(static_cast<long long>(t)) + "LL";
+      }
+      return std::to_string(static_cast<unsigned long long>(t)) + "ULL";
+    }
+    std::string operator()(const double& t) const {
+      char buf[32];
+      snprintf(buf, sizeof(buf), "%.17g", t);
+      return std::string("double(") + buf + ")";
+    }
+    std::string operator()(const float& t) const {
+      return operator()(static_cast<double>(t));
+    }
+    std::string operator()(const std::string& t) const {
+      std::string ret("std::string(\"");
+      for (char c : t) {
+        if (c == '"' || c == '\\') ret += '\\';
+        ret += c;
+      }
+      return ret + "\")";
+    }
+  };
+}
+
 MethodInvoker::
 MethodInvoker(const edm::FunctionWithDict& method,
               const vector<AnyMethodArgument>& ints)
@@ -17,11 +48,13 @@ MethodInvoker(const edm::FunctionWithDict& method,
   , member_()
   , ints_(ints)
   , isFunction_(true)
+  , memberOffset_(0)
 {
   setArgs();
   if (isFunction_) {
     retTypeFinal_ = method_.finalReturnType();
   }
+  setReturnType();
   //std::cout <<
   //   "Booking " <<
   //   methodName() <<
@@ -42,8 +75,11 @@ MethodInvoker(const edm::MemberWithDict& member)
   , member_(member)
   , ints_()
   , isFunction_(false)
+  , memberType_(member.typeOf())
+  , memberOffset_(member.offset())
 {
   setArgs();
+  setReturnType();
   //std::cout <<
   //  "Booking " <<
   //  methodName() <<
@@ -65,6 +101,10 @@ MethodInvoker(const MethodInvoker& rhs)
   , ints_(rhs.ints_)
   , isFunction_(rhs.isFunction_)
   , retTypeFinal_(rhs.retTypeFinal_)
+  , memberType_(rhs.memberType_)
+  , memberOffset_(rhs.memberOffset_)
+  , retTypeStripped_(rhs.retTypeStripped_)
+  , retIsPtrOrRef_(rhs.retIsPtrOrRef_)
 {
   setArgs();
 }
@@ -79,7 +119,12 @@ operator=(const MethodInvoker& rhs)
     ints_ = rhs.ints_;
     isFunction_ = rhs.isFunction_;
     retTypeFinal_ =rhs.retTypeFinal_;
+    memberType_ = rhs.memberType_;
+    memberOffset_ = rhs.memberOffset_;
+    retTypeStripped_ = rhs.retTypeStripped_;
+    retIsPtrOrRef_ = rhs.retIsPtrOrRef_;
 
+    args_.clear();
     setArgs();
   }
   return *this;
@@ -94,6 +139,23 @@ setArgs()
   }
 }
 
+void
+MethodInvoker::
+setReturnType()
+{
+  retTypeStripped_ = isFunction_ ? retTypeFinal_ : memberType_;
+  retIsPtrOrRef_ = retTypeStripped_.isPointer() || retTypeStripped_.isReference();
+  if (retTypeStripped_.isPointer()) {
+    retTypeStripped_ = retTypeStripped_.toType();
+  }
+  else if (retTypeStripped_.isReference()) {
+    // strip cv & ref flags
+    // FIXME: This is only true if the propery passed to the constructor
+    //       overrides the const and reference flags.
+    retTypeStripped_.stripConstRef();
+  }
+}
+
 std::string
 MethodInvoker::
 methodName() const
@@ -119,7 +181,6 @@ MethodInvoker::
 invoke(const edm::ObjectWithDict& o, edm::ObjectWithDict& retstore) const
 {
   edm::ObjectWithDict ret = retstore;
-  edm::TypeWithDict retType;
   if (isFunction_) {
     //std::cout << "Invoking " << methodName()
     //  << " from " << method_.declaringType().qualifiedName()
@@ -128,8 +189,6 @@ invoke(const edm::ObjectWithDict& o, edm::ObjectWithDict& retstore) const
     //  << " with " << args_.size() << " arguments"
     //  << std::endl;
     method_.invoke(o, &ret, args_);
-    // this is correct, it takes pointers and refs into account
-    retType = retTypeFinal_; 
   }
   else {
     //std::cout << "Invoking " << methodName()
@@ -138,8 +197,8 @@ invoke(const edm::ObjectWithDict& o, edm::ObjectWithDict& retstore) const
     //  << " at " << o.address()
     //  << " with " << args_.size() << " arguments"
     //  << std::endl;
-    ret = member_.get(o);
-    retType = member_.typeOf();
+    ret = edm::ObjectWithDict(memberType_,
+                              static_cast<char*>(o.address()) + memberOffset_);
   }
   void* addr = ret.address();
   //std::cout << "Stored result of " <<  methodName() << " (type " <<
@@ -149,20 +208,10 @@ invoke(const edm::ObjectWithDict& o, edm::ObjectWithDict& retstore) const
         << "method \"" << methodName() << "\" called with " << args_.size()
         << " arguments returned a null pointer ";
   }
-  //std::cout << "Return type is " << retType.qualifiedName() << std::endl;
-  if (retType.isPointer() || retType.isReference()) {
+  if (retIsPtrOrRef_) {
     // both need void** -> void* conversion
-    if (retType.isPointer()) {
-      retType = retType.toType();
-    }
-    else {
-      // strip cv & ref flags
-      // FIXME: This is only true if the propery passed to the constructor
-      //       overrides the const and reference flags.
-      retType = retType.stripConstRef();
-    }
-    ret = edm::ObjectWithDict(retType, *static_cast<void**>(addr));
-    //std::cout << "Now type is " << retType.qualifiedName() << std::endl;
+    ret = edm::ObjectWithDict(retTypeStripped_, *static_cast<void**>(addr));
+    //std::cout << "Now type is " << retTypeStripped_.qualifiedName() << std::endl;
   }
   if (!bool(ret)) {
     throw edm::Exception(edm::errors::Configuration)
@@ -173,12 +222,65 @@ invoke(const edm::ObjectWithDict& o, edm::ObjectWithDict& retstore) const
   return ret;
 }
 
+bool
+MethodInvoker::
+cppCode(std::string& code) const
+{
+  code += '.';
+  code += methodName();
+  if (!isFunction_) {
+    return true;
+  }
+  code += '(';
+  size_t i = 0;
+  for (auto const& param : method_) {
+    if (i == ints_.size()) {
+      break;
+    }
+    edm::TypeWithDict parameter(param);
+    std::string type = parameter.stripConstRef().cppName();
+    if (type.empty()) {
+      return false;
+    }
+    if (i != 0) {
+      code += ", ";
+    }
+    code += "static_cast<" + type + ">(" +
+            boost::apply_visitor(AnyMethodArgument2Cpp(), ints_[i]) + ")";
+    ++i;
+  }
+  code += ')';
+  return i == ints_.size();
+}
+
 LazyInvoker::
 LazyInvoker(const std::string& name,
             const std::vector<AnyMethodArgument>& args)
   : name_(name)
   , argsBeforeFixups_(args)
+  , last_(nullptr)
+{
+}
+
+LazyInvoker::
+LazyInvoker(const LazyInvoker& rhs)
+  : name_(rhs.name_)
+  , argsBeforeFixups_(rhs.argsBeforeFixups_)
+  , last_(nullptr)
+{
+}
+
+LazyInvoker&
+LazyInvoker::
+operator=(const LazyInvoker& rhs)
 {
+  if (this != &rhs) {
+    name_ = rhs.name_;
+    argsBeforeFixups_ = rhs.argsBeforeFixups_;
+    last_ = nullptr;
+    invokers_.clear();
+  }
+  return *this;
 }
 
 LazyInvoker::~LazyInvoker()
@@ -187,18 +289,24 @@ LazyInvoker::~LazyInvoker()
 
 const SingleInvoker&
 LazyInvoker::
-invoker(const edm::TypeWithDict& type) const
+invoker(const edm::ObjectWithDict& o) const
 {
   //std::cout << "LazyInvoker for " << name_ << " called on type " <<
-  //  type.qualifiedName() << std::endl;
-  const edm::TypeID thetype(type.typeInfo());
+  //  o.typeOf().qualifiedName() << std::endl;
+  const edm::TypeID thetype(o.dynamicTypeInfo());
+  InvokerMap::value_type const* last = last_.load(std::memory_order_acquire);
+  if (last != nullptr && last->first == thetype) {
+    return *(last->second);
+  }
   auto found = invokers_.find(thetype);
-  if( found != invokers_.cend() ) {
-    return *(found->second);
+  if (found == invokers_.end()) {
+    // the dictionary is only needed to build the invoker of a new type
+    edm::TypeWithDict type(thetype.typeInfo());
+    auto to_add = std::make_shared<SingleInvoker>(type, name_, argsBeforeFixups_);
+    found = invokers_.insert(std::make_pair(thetype,to_add)).first;
   }
-  auto to_add = std::make_shared<SingleInvoker>(type, name_, argsBeforeFixups_);
-  auto emplace_result = invokers_.insert(std::make_pair(thetype,to_add) );
-  return *(emplace_result.first->second);
+  last_.store(&*found, std::memory_order_release);
+  return *(found->second);
 }
 
 edm::ObjectWithDict
@@ -207,11 +315,8 @@ invoke(const edm::ObjectWithDict& o, std::vector<edm::ObjectWithDict>& v) const
 {
   pair<edm::ObjectWithDict, bool> ret(o, false);
   do {
-    edm::TypeWithDict type = ret.first.typeOf();
-    if (type.isClass()) {
-      type = ret.first.dynamicType();
-    }
-    ret = invoker(type).invoke(edm::ObjectWithDict(type, ret.first.address()), v);
+    const SingleInvoker& i = invoker(ret.first);
+    ret = i.invoke(edm::ObjectWithDict(i.type(), ret.first.address()), v);
   }
   while (ret.second == false);
   return ret.first;
@@ -225,12 +330,8 @@ invokeLast(const edm::ObjectWithDict& o,
   pair<edm::ObjectWithDict, bool> ret(o, false);
   const SingleInvoker* i = 0;
   do {
-    edm::TypeWithDict type = ret.first.typeOf();
-    if (type.isClass()) {
-      type = ret.first.dynamicType();
-    }
-    i = &invoker(type);
-    ret = i->invoke(edm::ObjectWithDict(type, ret.first.address()), v);
+    i = &invoker(ret.first);
+    ret = i->invoke(edm::ObjectWithDict(i->type(), ret.first.address()), v);
   }
   while (ret.second == false);
   return i->retToDouble(ret.first);
@@ -239,6 +340,8 @@ invokeLast(const edm::ObjectWithDict& o,
 SingleInvoker::
 SingleInvoker(const edm::TypeWithDict& type, const std::string& name,
               const std::vector<AnyMethodArgument>& args)
+  : type_(type)
+  , storageNeedsDestructor_(false)
 {
   TypeStack typeStack(1, type);
   LazyMethodStack dummy;
@@ -250,11 +353,7 @@ SingleInvoker(const edm::TypeWithDict& type, const std::string& name,
   //  std::endl;
   if (invokers_.front().isFunction()) {
     edm::TypeWithDict retType = invokers_.front().method().finalReturnType();
-    storageNeedsDestructor_ = ExpressionVar::makeStorage(storage_, retType);
-  }
-  else {
-    storage_ = edm::ObjectWithDict();
-    storageNeedsDestructor_ = false;
+    storageNeedsDestructor_ = ExpressionVar::makeStorage(storage_.local(), retType);
   }
   // typeStack[0] = type of self
   // typeStack[1] = type of ret
@@ -264,7 +363,21 @@ SingleInvoker(const edm::TypeWithDict& type, const std::string& name,
 SingleInvoker::
 ~SingleInvoker()
 {
-  ExpressionVar::delStorage(storage_);
+  for (auto& storage : storage_) {
+    ExpressionVar::delStorage(storage);
+  }
+}
+
+edm::ObjectWithDict&
+SingleInvoker::
+storage() const
+{
+  bool exists = false;
+  edm::ObjectWithDict& storage = storage_.local(exists);
+  if (!exists && invokers_.front().isFunction()) {
+    ExpressionVar::makeStorage(storage, invokers_.front().method().finalReturnType());
+  }
+  return storage;
 }
 
 pair<edm::ObjectWithDict, bool>
@@ -277,12 +390,13 @@ invoke(const edm::ObjectWithDict& o, std::vector<edm::ObjectWithDict>& v) const
   //   o.typeOf().qualifiedName() <<
   //   (!isRefGet_ ? " is one shot" : " needs another round") <<
   //   std::endl;
+  edm::ObjectWithDict& storage = this->storage();
   pair<edm::ObjectWithDict, bool>
-  ret(invokers_.front().invoke(o, storage_), !isRefGet_);
+  ret(invokers_.front().invoke(o, storage), !isRefGet_);
   if (storageNeedsDestructor_) {
-    //std::cerr << "Storage type: " << storage_.typeOf().qualifiedName() <<
+    //std::cerr << "Storage type: " << storage.typeOf().qualifiedName() <<
     //  ", I have to call the destructor." << std::endl;
-    v.push_back(storage_);
+    v.push_back(storage);
   }
   return ret;
 }
@@ -11,16 +11,17 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/utility.hpp>
 
+#include <atomic>
 #include <map>
 #include <vector>
 
 #include "tbb/concurrent_unordered_map.h"
+#include "tbb/enumerable_thread_specific.h"
 
 namespace edm {
   struct TypeIDHasher {
     size_t operator()(TypeID const& tid) const {
-      tbb::tbb_hash<std::string> hasher;
-      return hasher(std::string(tid.name()));
+      return tid.typeInfo().hash_code();
     }
   };
 }
@@ -37,8 +38,14 @@ private: // Private Data Members
 
   bool isFunction_;
   edm::TypeWithDict retTypeFinal_;
+  // resolved once, so that invoke does no dictionary lookup
+  edm::TypeWithDict memberType_;
+  size_t memberOffset_;
+  edm::TypeWithDict retTypeStripped_; // after removing "*" and "&"
+  bool retIsPtrOrRef_;
 private: // Private Function Members
   void setArgs();
+  void setReturnType();
 public: // Public Function Members
   explicit MethodInvoker(const edm::FunctionWithDict& method,
                          const std::vector<AnyMethodArgument>& ints =
@@ -60,6 +67,10 @@ public: // Public Function Members
   /// before calling 'invoke', and of deallocating it afterwards
   edm::ObjectWithDict invoke(const edm::ObjectWithDict& obj,
                              edm::ObjectWithDict& retstore) const;
+
+  /// Appends ".name" or ".name(args)" doing the same access in
+  /// generated C++ code; returns false if that is not possible
+  bool cppCode(std::string& code) const;
 };
 
 /// A bigger brother of the MethodInvoker:
@@ -68,17 +79,24 @@ public: // Public Function Members
 /// in this way, it can map 1-1 to a name and set of args
 struct SingleInvoker : boost::noncopyable {
 private: // Private Data Members
+  edm::TypeWithDict type_;
   method::TypeCode retType_;
   std::vector<MethodInvoker> invokers_;
-  mutable edm::ObjectWithDict storage_;
+  /// one return slot per thread, so that concurrent calls do not share it
+  mutable tbb::enumerable_thread_specific<edm::ObjectWithDict> storage_;
   bool storageNeedsDestructor_;
   /// true if this invoker just pops out a ref and returns (ref.get(), false)
   bool isRefGet_;
+private: // Private Function Members
+  edm::ObjectWithDict& storage() const;
 public:
   SingleInvoker(const edm::TypeWithDict&, const std::string& name,
                 const std::vector<AnyMethodArgument>& args);
   ~SingleInvoker();
 
+  /// the (dynamic) type of the objects this invoker was made for
+  const edm::TypeWithDict& type() const { return type_; }
+
   /// If the member is found in object o, evaluate and
   /// return (value,true)
   /// If the member is not found but o is a Ref/RefToBase/Ptr,
@@ -108,11 +126,17 @@ private: // Private Data Members
   // otherwise I think it could leak if the constructor of
   // SingleInvoker throws an exception (which can happen) 
   mutable InvokerMap invokers_;
+  // last entry found in invokers_ (entries are never erased): collections
+  // usually hold a single dynamic type, which then skips the map lookup
+  mutable std::atomic<InvokerMap::value_type const*> last_;
 private: // Private Function Members
-  const SingleInvoker& invoker(const edm::TypeWithDict&) const;
+  /// SingleInvoker for the dynamic type of o
+  const SingleInvoker& invoker(const edm::ObjectWithDict& o) const;
 public: // Public Function Members
   explicit LazyInvoker(const std::string& name,
                        const std::vector<AnyMethodArgument>& args);
+  LazyInvoker(const LazyInvoker&);
+  LazyInvoker& operator=(const LazyInvoker&);
   ~LazyInvoker();
 
   /// invoke method, returns object that points to result
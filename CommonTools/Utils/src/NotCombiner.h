@@ -21,6 +21,12 @@ namespace reco {
       virtual bool operator()( const edm::ObjectWithDict& o ) const {
 	return ! (*arg_)( o );
       }
+      virtual bool cppCode( std::string & code ) const {
+	code += "!(";
+	if( !arg_->cppCode( code ) ) return false;
+	code += ')';
+	return true;
+      }
     private:
       SelectorPtr arg_;
     };
@@ -9,6 +9,7 @@
  * \version $Revision: 1.2 $
  *
  */
+#include <string>
 
 namespace edm {class ObjectWithDict;}
 
@@ -20,6 +21,9 @@ namespace reco {
       virtual ~SelectorBase() { }
       /// return true if the object is selected
       virtual bool operator()(const edm::ObjectWithDict & c) const = 0;
+      /// appends the C++ code of the same selection on an object named
+      /// "obj"; false if this selector cannot be translated
+      virtual bool cppCode(std::string &) const { return false; }
     };
   }
 }
@@ -29,6 +29,19 @@ namespace reco {
 	  cmp1_->compare( lhs_->value( o ), mid_->value( o ) ) &&
 	  cmp2_->compare( mid_->value( o ), rhs_->value( o ) );
       }
+      virtual bool cppCode( std::string & code ) const {
+	if( cmp1_->cppName() == 0 || cmp2_->cppName() == 0 ) return false;
+	code += '('; code += cmp1_->cppName(); code += '(';
+	if( !lhs_->cppCode( code ) ) return false;
+	code += ", ";
+	if( !mid_->cppCode( code ) ) return false;
+	code += ") && "; code += cmp2_->cppName(); code += '(';
+	if( !mid_->cppCode( code ) ) return false;
+	code += ", ";
+	if( !rhs_->cppCode( code ) ) return false;
+	code += "))";
+	return true;
+      }
       boost::shared_ptr<ExpressionBase> lhs_;
       boost::shared_ptr<ComparisonBase> cmp1_;
       boost::shared_ptr<ExpressionBase> mid_;
@@ -0,0 +1,94 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "CommonTools/Utils/interface/StringObjectFunction.h"
+#include "DataFormats/Candidate/interface/LeafCandidate.h"
+
+#include <chrono>
+#include <iostream>
+
+class testCompiledCut : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testCompiledCut);
+  CPPUNIT_TEST(checkAll);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  testCompiledCut() {}
+  ~testCompiledCut() {}
+  void checkAll();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( testCompiledCut );
+
+namespace {
+  const char * pkg = "CommonTools/CandUtils";
+
+  std::vector<reco::LeafCandidate> generate(unsigned int n) {
+    std::vector<reco::LeafCandidate> ret;
+    reco::Candidate::LorentzVector p1(10, -10, -10, 15);
+    reco::Candidate::LorentzVector incr(0.1, 0.3, 0.7, 0.5);
+    int sign = 1;
+    for (unsigned int i = 0; i < n; ++i) {
+      ret.emplace_back(sign, p1);
+      sign = -sign;
+      p1 += incr;
+    }
+    return ret;
+  }
+
+  template<typename F>
+  double nsPerObject(F const & f, std::vector<reco::LeafCandidate> const & cands, double & sum) {
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (auto const & c : cands) sum += f(c);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / cands.size();
+  }
+
+  void checkCut(std::string const & cut, std::vector<reco::LeafCandidate> const & cands) {
+    std::cerr << "testing cut " << cut << std::endl;
+    StringCutObjectSelector<reco::LeafCandidate> interpreted(cut);
+    StringCutObjectSelector<reco::LeafCandidate> compiled(cut, false, pkg);
+    CPPUNIT_ASSERT(compiled.isCompiled());
+    for (auto const & c : cands) CPPUNIT_ASSERT(interpreted(c) == compiled(c));
+
+    double s1 = 0, s2 = 0;
+    double tInt = nsPerObject(interpreted, cands, s1);
+    double tComp = nsPerObject(compiled, cands, s2);
+    CPPUNIT_ASSERT(s1 == s2);
+    std::cerr << "  interpreted " << tInt << " ns/object, compiled " << tComp << " ns/object" << std::endl;
+  }
+
+  void checkFunction(std::string const & expr, std::vector<reco::LeafCandidate> const & cands) {
+    std::cerr << "testing function " << expr << std::endl;
+    StringObjectFunction<reco::LeafCandidate> interpreted(expr);
+    StringObjectFunction<reco::LeafCandidate> compiled(expr, false, pkg);
+    CPPUNIT_ASSERT(compiled.isCompiled());
+    for (auto const & c : cands) CPPUNIT_ASSERT(std::abs(interpreted(c) - compiled(c)) <= 1.e-12 * (1. + std::abs(interpreted(c))));
+
+    double s1 = 0, s2 = 0;
+    double tInt = nsPerObject(interpreted, cands, s1);
+    double tComp = nsPerObject(compiled, cands, s2);
+    std::cerr << "  interpreted " << tInt << " ns/object, compiled " << tComp << " ns/object" << std::endl;
+  }
+}
+
+void testCompiledCut::checkAll() {
+  auto cands = generate(10000);
+
+  checkCut("pt > 15 & abs(eta) < 2", cands);
+  checkCut("charge = 1 | (5 < energy < 20)", cands);
+  checkCut("!(py < 0) && hypot(px, py) > 12", cands);
+  checkCut("deltaR(eta, phi, 0.5, 3.1) < 2 || test_bit(pdgId, 0)", cands);
+  checkFunction("pt * cos(phi) + (? charge > 0 ? mass : -2 * pz)", cands);
+  checkFunction("max(pt, energy) - min(log(pt), 3) ^ 2 + deltaPhi(phi, -3.)", cands);
+
+  // lazy cuts and functions without a C++ counterpart stay interpreted
+  StringCutObjectSelector<reco::LeafCandidate> lazy("pt > 15", true, pkg);
+  CPPUNIT_ASSERT(!lazy.isCompiled());
+  StringCutObjectSelector<reco::LeafCandidate> chi2("chi2prob(pt, 3) < 0.5", false, pkg);
+  CPPUNIT_ASSERT(!chi2.isCompiled());
+  StringCutObjectSelector<reco::LeafCandidate> chi2ref("chi2prob(pt, 3) < 0.5");
+  for (auto const & c : cands) {
+    CPPUNIT_ASSERT(chi2(c) == chi2ref(c));
+  }
+}
@@ -1,5 +1,6 @@
 #include "CommonTools/Utils/interface/cutParser.h"
 #include "CommonTools/Utils/interface/StringCutObjectSelector.h"
+#include "CommonTools/Utils/interface/StringObjectFunction.h"
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "FWCore/Utilities/interface/Exception.h"
 
@@ -83,6 +84,37 @@ int main() {
   for(auto& thread: threads) {
     thread.join();
   }
+
+  // the same selectors shared by all threads: the return slots
+  // (here of the momentum vector returned by value) are per thread
+  {
+    StringObjectFunction<reco::Track> const lazyFun("momentum.x + pt", true);
+    StringObjectFunction<reco::Track> const fun("momentum.x + pt", false);
+    threads.clear();
+    for(int i=0; i<kNThreads; ++i) {
+      threads.emplace_back([i,&lazyFun,&fun,&failed]() {
+          try {
+            static thread_local TThread guard;
+            for(int j=0; j<1000; ++j) {
+              reco::Track::Vector mom(1.+i, 0.5*j, 1.);
+              reco::Track trk(20., 20., reco::Track::Point(), mom, +1, reco::Track::CovarianceMatrix{});
+              double expected = trk.px() + trk.pt();
+              if( lazyFun(trk) != expected or fun(trk) != expected ) {
+                std::cout <<"shared evaluation failed"<<std::endl;
+                failed = true;
+                return;
+              }
+            }
+          } catch(cms::Exception const& exception) {
+            std::cout <<exception.what()<<std::endl;
+            failed = true;
+          }
+        });
+    }
+    for(auto& thread: threads) {
+      thread.join();
+    }
+  }
   
   if(failed) {
     std::cout <<"FAILED"<<std::endl;
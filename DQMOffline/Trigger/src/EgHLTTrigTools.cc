@@ -47,11 +47,11 @@ int trigTools::getMinNrObjsRequiredByFilter(const std::string& filterName)
   const edm::pset::Registry* psetRegistry = edm::pset::Registry::instance();
   if(psetRegistry==NULL) return -1;
   for(edm::pset::Registry::const_iterator psetIt=psetRegistry->begin();psetIt!=psetRegistry->end();++psetIt){ //loop over every pset for every module ever run
-    const std::map<std::string,edm::Entry>& mapOfPara  = psetIt->second.tbl(); //contains the parameter name and value for all the parameters of the pset
-    const std::map<std::string,edm::Entry>::const_iterator itToModLabel = mapOfPara.find("@module_label"); 
+    const edm::ParameterSet::table& mapOfPara  = psetIt->second.tbl(); //contains the parameter name and value for all the parameters of the pset
+    const edm::ParameterSet::table::const_iterator itToModLabel = mapOfPara.find("@module_label"); 
     if(itToModLabel!=mapOfPara.end()){
       if(itToModLabel->second.getString()==filterName){ //moduleName is the filter name, we have found filter, we will now return something
-	std::map<std::string,edm::Entry>::const_iterator itToCandCut = mapOfPara.find("ncandcut");
+	edm::ParameterSet::table::const_iterator itToCandCut = mapOfPara.find("ncandcut");
 	if(itToCandCut!=mapOfPara.end() && itToCandCut->second.typeCode()=='I') return itToCandCut->second.getInt32();
 	else{ //checks if nZcandcut exists and is int32, if not return -1
 	  itToCandCut = mapOfPara.find("nZcandcut");
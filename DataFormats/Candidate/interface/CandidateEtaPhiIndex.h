@@ -0,0 +1,85 @@
+#ifndef Candidate_CandidateEtaPhiIndex_h
+#define Candidate_CandidateEtaPhiIndex_h
+/** \class reco::CandidateEtaPhiIndex
+ *
+ * Per-event index of a candidate collection on a regular eta-phi grid,
+ * used for cone queries. It is built once per event, so that the
+ * producers isolating electrons, muons and photons against the same
+ * (packed) PF candidates visit only the cells around each object instead
+ * of looping over the whole collection for every object.
+ *
+ * The candidates are referred to by their index in the indexed collection.
+ * Candidates beyond the eta range are kept in the outermost cells.
+ *
+ */
+#include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Math/interface/deltaR.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+
+#include <vector>
+
+namespace reco {
+
+  class CandidateEtaPhiIndex {
+  public:
+    CandidateEtaPhiIndex() : etaMax_(0), cellSize_(1), phiCellSize_(1), nEta_(0), nPhi_(0) { }
+    /// index the candidates of the view, identified by the product id of the
+    /// collection; cellSize should be of the order of the cone sizes
+    CandidateEtaPhiIndex(const edm::View<Candidate> & cands, const edm::ProductID & id,
+                         float cellSize = 0.2, float etaMax = 5.0);
+
+    /// product id of the indexed collection
+    const edm::ProductID & id() const { return productId_; }
+    /// number of indexed candidates
+    size_t size() const { return key_.size(); }
+
+    /// call f(key) for the candidates within dR of (eta, phi), key being the
+    /// index of the candidate in the indexed collection; candidates closer
+    /// than a small rounding margin outside the cone may be included too, so
+    /// f is expected to apply its own cone requirement
+#if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__REFLEX__)
+    template<typename F>
+    void forEachInCone(double eta, double phi, double dR, F f) const {
+      if (key_.empty()) return;
+      const double dR2 = (dR + kMargin) * (dR + kMargin);
+      const int ie0 = etaBin(eta - dR), ie1 = etaBin(eta + dR);
+      const int ipc = phiBin(phi);
+      int nDPhi = int(dR / phiCellSize_) + 1;
+      if (2 * nDPhi + 1 > int(nPhi_)) nDPhi = -1;
+      const int ip0 = nDPhi < 0 ? 0 : ipc - nDPhi;
+      const int ip1 = nDPhi < 0 ? int(nPhi_) - 1 : ipc + nDPhi;
+      for (int ie = ie0; ie <= ie1; ++ie) {
+        for (int ip = ip0; ip <= ip1; ++ip) {
+          const unsigned int cell = ie * nPhi_ + (ip + nPhi_) % nPhi_;
+          for (unsigned int j = cellBegin_[cell], end = cellBegin_[cell + 1]; j < end; ++j) {
+            if (reco::deltaR2(eta, phi, eta_[j], phi_[j]) < dR2) f(key_[j]);
+          }
+        }
+      }
+    }
+#endif
+
+  private:
+    static constexpr double kMargin = 1.e-4;
+
+    int etaBin(double eta) const;
+    int phiBin(double phi) const;
+
+    edm::ProductID productId_;
+    float etaMax_;
+    float cellSize_;
+    float phiCellSize_;
+    unsigned int nEta_;
+    unsigned int nPhi_;
+    /// the candidates of cell c are at [cellBegin_[c], cellBegin_[c+1])
+    std::vector<unsigned int> cellBegin_;
+    /// in cell order: index in the collection, eta and phi
+    std::vector<unsigned int> key_;
+    std::vector<float> eta_;
+    std::vector<float> phi_;
+  };
+
+}
+
+#endif
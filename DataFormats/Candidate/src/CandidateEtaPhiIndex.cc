@@ -0,0 +1,53 @@
+#include "DataFormats/Candidate/interface/CandidateEtaPhiIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace reco;
+
+constexpr double CandidateEtaPhiIndex::kMargin;
+
+CandidateEtaPhiIndex::CandidateEtaPhiIndex(const edm::View<Candidate> & cands, const edm::ProductID & id,
+                                           float cellSize, float etaMax) :
+  productId_(id), etaMax_(etaMax), cellSize_(cellSize) {
+  nEta_ = std::max(1, int(std::ceil(2 * etaMax / cellSize)));
+  nPhi_ = std::max(1, int(2 * M_PI / cellSize));
+  phiCellSize_ = 2 * M_PI / nPhi_;
+
+  // counting sort of the candidates by cell
+  const size_t n = cands.size();
+  std::vector<unsigned int> cell(n);
+  std::vector<float> eta(n), phi(n);
+  cellBegin_.assign(nEta_ * nPhi_ + 1, 0);
+  for (size_t i = 0; i < n; ++i) {
+    const Candidate & c = cands[i];
+    eta[i] = c.eta();
+    phi[i] = c.phi();
+    cell[i] = etaBin(eta[i]) * nPhi_ + phiBin(phi[i]);
+    ++cellBegin_[cell[i] + 1];
+  }
+  for (size_t c = 1; c < cellBegin_.size(); ++c) cellBegin_[c] += cellBegin_[c - 1];
+
+  std::vector<unsigned int> next(cellBegin_.begin(), cellBegin_.end() - 1);
+  key_.resize(n);
+  eta_.resize(n);
+  phi_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    const unsigned int j = next[cell[i]]++;
+    key_[j] = i;
+    eta_[j] = eta[i];
+    phi_[j] = phi[i];
+  }
+}
+
+int CandidateEtaPhiIndex::etaBin(double eta) const {
+  int bin = int(std::floor((eta + etaMax_) / cellSize_));
+  if (bin < 0) return 0;
+  if (bin >= int(nEta_)) return nEta_ - 1;
+  return bin;
+}
+
+int CandidateEtaPhiIndex::phiBin(double phi) const {
+  int bin = int(std::floor((phi + M_PI) / phiCellSize_)) % int(nPhi_);
+  return bin < 0 ? bin + nPhi_ : bin;
+}
@@ -21,6 +21,7 @@
 #include "DataFormats/Common/interface/AssociationMap.h"
 #include "DataFormats/Common/interface/AssociationVector.h"
 #include "DataFormats/Candidate/interface/CandMatchMap.h"
+#include "DataFormats/Candidate/interface/CandidateEtaPhiIndex.h"
 #include "DataFormats/Candidate/interface/CandMatchMapMany.h"
 #include "DataFormats/Candidate/interface/CandAssociation.h"
 #include "DataFormats/Common/interface/Association.h"
@@ -134,5 +135,7 @@ namespace DataFormats_Candidate {
     edm::Wrapper<edm::ValueMap<reco::CandidatePtr> > w_vm_cptr;
     std::pair<std::string,edm::Ptr<reco::Candidate> > p_s_cptr;
     std::vector<std::pair<std::string,edm::Ptr<reco::Candidate> > > v_p_s_cptr;
+
+    edm::Wrapper<reco::CandidateEtaPhiIndex> w_etaphi;
   };
 }
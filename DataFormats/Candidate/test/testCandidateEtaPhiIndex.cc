@@ -0,0 +1,84 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include "DataFormats/Candidate/interface/CandidateEtaPhiIndex.h"
+#include "DataFormats/Candidate/interface/LeafCandidate.h"
+#include "DataFormats/Math/interface/deltaR.h"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+class testCandidateEtaPhiIndex : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testCandidateEtaPhiIndex);
+  CPPUNIT_TEST(checkCones);
+  CPPUNIT_TEST(checkEmpty);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+  void checkCones();
+  void checkEmpty();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testCandidateEtaPhiIndex);
+
+namespace {
+  double uniform(double min, double max) {
+    return min + (max - min) * (std::rand() / (RAND_MAX + 1.));
+  }
+}
+
+void testCandidateEtaPhiIndex::checkCones() {
+  std::srand(12345);
+  std::vector<reco::LeafCandidate> cands;
+  for (unsigned int i = 0; i < 2000; ++i) {
+    // a few candidates beyond the eta range of the grid, and some exactly at phi = +-pi
+    double eta = uniform(-5.5, 5.5);
+    double phi = i % 100 == 0 ? M_PI : uniform(-M_PI, M_PI);
+    cands.emplace_back(0, reco::LeafCandidate::PolarLorentzVector(uniform(0.5, 50.), eta, phi, 0.));
+  }
+  std::vector<void const*> pointers;
+  edm::FillViewHelperVector helpers;
+  edm::ProductID id(1, 1);
+  for (unsigned int i = 0; i < cands.size(); ++i) {
+    pointers.push_back(&cands[i]);
+    helpers.push_back(std::make_pair(id, i));
+  }
+  edm::View<reco::Candidate> view(pointers, helpers, nullptr);
+  reco::CandidateEtaPhiIndex index(view, id, 0.2, 5.0);
+  CPPUNIT_ASSERT(index.id() == id);
+  CPPUNIT_ASSERT(index.size() == cands.size());
+
+  const double cones[] = { 0.05, 0.3, 0.4, 1.0, 4.0 };
+  for (unsigned int q = 0; q < 200; ++q) {
+    double eta = uniform(-5.5, 5.5);
+    double phi = q % 20 == 0 ? -M_PI : uniform(-M_PI, M_PI);
+    for (double dR : cones) {
+      std::vector<unsigned int> found;
+      index.forEachInCone(eta, phi, dR, [&found](unsigned int key) { found.push_back(key); });
+      std::sort(found.begin(), found.end());
+      CPPUNIT_ASSERT(std::adjacent_find(found.begin(), found.end()) == found.end());
+      // every candidate in the cone is found
+      for (unsigned int i = 0; i < cands.size(); ++i) {
+        if (reco::deltaR2(eta, phi, cands[i].eta(), cands[i].phi()) < dR * dR) {
+          CPPUNIT_ASSERT(std::binary_search(found.begin(), found.end(), i));
+        }
+      }
+      // and nothing far outside of it
+      for (auto key : found) {
+        CPPUNIT_ASSERT(reco::deltaR2(eta, phi, cands[key].eta(), cands[key].phi()) < (dR + 1.e-3) * (dR + 1.e-3));
+      }
+    }
+  }
+}
+
+void testCandidateEtaPhiIndex::checkEmpty() {
+  reco::CandidateEtaPhiIndex empty;
+  unsigned int n = 0;
+  empty.forEachInCone(0., 0., 0.4, [&n](unsigned int) { ++n; });
+  CPPUNIT_ASSERT(n == 0);
+
+  edm::View<reco::Candidate> view;
+  reco::CandidateEtaPhiIndex index(view, edm::ProductID(1, 2));
+  index.forEachInCone(0., 0., 0.4, [&n](unsigned int) { ++n; });
+  CPPUNIT_ASSERT(n == 0);
+  CPPUNIT_ASSERT(index.size() == 0);
+}
@@ -0,0 +1,605 @@
+#ifndef DataFormats_Common_ArenaOwnVector_h
+#define DataFormats_Common_ArenaOwnVector_h
+/** \class edm::ArenaOwnVector
+ *
+ * Owning vector of polymorphic objects, like OwnVector, which allocates
+ * its elements in contiguous blocks, one set of blocks per dynamic type.
+ *
+ * An OwnVector allocates and frees every element separately.  Here an
+ * element added with emplace_back<D>(...) is constructed in a block
+ * holding only objects of type D, so filling a collection of n hits of a
+ * few types costs a few allocations, the elements of a given type are
+ * next to each other in memory, and clear() keeps the blocks for the next
+ * event.  Elements added as pointers (push_back(D*), push_back(unique_ptr))
+ * keep the memory they were allocated in and are deleted as in an
+ * OwnVector.  push_back(T const&) and the copy constructor copy an element
+ * into the blocks of its dynamic type if the vector already has blocks for
+ * it (see emplace_back and reserve<D>), and clone it otherwise.
+ *
+ * An ArenaOwnVector is a transient container: it has no dictionary and
+ * can not be written to a file.  An existing OwnVector can be moved into
+ * an ArenaOwnVector without copying its elements.
+ *
+ * Since the blocks are not reused element by element, there is no
+ * insert, set or erase; a collection is filled, possibly sorted, and then
+ * read.  The types stored in the blocks must not be more aligned than
+ * std::max_align_t.
+ */
+
+#include "DataFormats/Common/interface/ClonePolicy.h"
+#include "DataFormats/Common/interface/OwnVector.h"
+#include "DataFormats/Common/interface/fillPtrVector.h"
+#include "DataFormats/Common/interface/setPtr.h"
+#include "DataFormats/Common/interface/traits.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace edm {
+  class ProductID;
+
+  namespace detail {
+    /// memory for the elements of one dynamic type D of an ArenaOwnVector<T>
+    template<typename T>
+    class ArenaOwnVectorPool {
+    public:
+      typedef T* (*Copier)(void*, T const&);
+
+      ArenaOwnVectorPool(std::type_info const& type, std::size_t elementSize, Copier copier) :
+        type_(&type), elementSize_(elementSize), copier_(copier), blocks_(), current_(0) { }
+
+      std::type_info const& type() const { return *type_; }
+
+      /// a pool for the same type, without any memory
+      std::unique_ptr<ArenaOwnVectorPool> emptyCopy() const {
+        return std::unique_ptr<ArenaOwnVectorPool>(new ArenaOwnVectorPool(*type_, elementSize_, copier_));
+      }
+
+      void* allocate() {
+        for(; current_ < blocks_.size(); ++current_) {
+          Block& b = blocks_[current_];
+          if(b.used < b.capacity) {
+            return b.memory.get() + elementSize_ * b.used++;
+          }
+        }
+        reserve(blocks_.empty() ? firstBlockSize() : 2 * blocks_.back().capacity);
+        return allocate();
+      }
+
+      /// add a block for at least n more elements
+      void reserve(std::size_t n) {
+        std::size_t available = 0;
+        for(std::size_t i = current_; i < blocks_.size(); ++i) {
+          available += blocks_[i].capacity - blocks_[i].used;
+        }
+        if(available >= n) return;
+        blocks_.emplace_back(elementSize_, n - available);
+      }
+
+      /// gives back the memory of the element allocated last; p points into it
+      void deallocate(void const* p) {
+        Block& b = blocks_[current_];
+        if(b.used == 0) return;
+        char const* last = b.memory.get() + elementSize_ * (b.used - 1);
+        char const* c = static_cast<char const*>(p);
+        if(c >= last && c < last + elementSize_) --b.used;
+      }
+
+      T* copy(T const& from) {
+        void* where = allocate();
+        try {
+          return copier_(where, from);
+        } catch(...) {
+          deallocate(where);
+          throw;
+        }
+      }
+
+      bool owns(T const* p) const {
+        char const* c = reinterpret_cast<char const*>(p);
+        for(auto const& b : blocks_) {
+          if(c >= b.memory.get() && c < b.memory.get() + elementSize_ * b.capacity) return true;
+        }
+        return false;
+      }
+
+      /// makes all the memory available again, the elements must have been destroyed
+      void reset() {
+        for(auto& b : blocks_) b.used = 0;
+        current_ = 0;
+      }
+
+      std::size_t numberOfBlocks() const { return blocks_.size(); }
+
+      /// number of elements allocated since the last reset
+      std::size_t used() const {
+        std::size_t n = 0;
+        for(auto const& b : blocks_) n += b.used;
+        return n;
+      }
+
+    private:
+      static std::size_t firstBlockSize() { return 16; }
+
+      struct Block {
+        Block(std::size_t elementSize, std::size_t n) :
+          memory(new char[elementSize * n]), capacity(n), used(0) { }
+        std::unique_ptr<char[]> memory;
+        std::size_t capacity;
+        std::size_t used;
+      };
+
+      std::type_info const* type_;
+      std::size_t elementSize_;
+      Copier copier_;
+      std::vector<Block> blocks_;
+      std::size_t current_;
+    };
+  }
+
+  template <typename T, typename P = ClonePolicy<T> >
+  class ArenaOwnVector {
+  public:
+    typedef std::vector<T*> base;
+    typedef typename base::size_type size_type;
+    typedef T value_type;
+    typedef T* pointer;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef P policy_type;
+
+    class iterator;
+    class const_iterator {
+    public:
+      typedef T value_type;
+      typedef T* pointer;
+      typedef T const& reference;
+      typedef ptrdiff_t difference_type;
+      typedef typename base::const_iterator::iterator_category iterator_category;
+      const_iterator(iterator const& it) : i(it.i) { }
+      const_iterator() {}
+      const_iterator& operator++() { ++i; return *this; }
+      const_iterator operator++(int) { const_iterator ci = *this; ++i; return ci; }
+      const_iterator& operator--() { --i; return *this; }
+      const_iterator operator--(int) { const_iterator ci = *this; --i; return ci; }
+      difference_type operator-(const_iterator const& o) const { return i - o.i; }
+      const_iterator operator+(difference_type n) const { return const_iterator(i + n); }
+      const_iterator operator-(difference_type n) const { return const_iterator(i - n); }
+      bool operator<(const_iterator const& o) const { return i < o.i; }
+      bool operator==(const_iterator const& ci) const { return i == ci.i; }
+      bool operator!=(const_iterator const& ci) const { return i != ci.i; }
+      T const& operator *() const { return **i; }
+      T const* operator->() const { return & (operator*()); }
+      const_iterator & operator +=(difference_type d) { i += d; return *this; }
+      const_iterator & operator -=(difference_type d) { i -= d; return *this; }
+      reference operator[](difference_type d) const { return *const_iterator(i+d); } // for boost::iterator_range []
+    private:
+      const_iterator(typename base::const_iterator const& it) : i(it) { }
+      typename base::const_iterator i;
+      friend class ArenaOwnVector<T,P>;
+    };
+    class iterator {
+    public:
+      typedef T value_type;
+      typedef T * pointer;
+      typedef T & reference;
+      typedef ptrdiff_t difference_type;
+      typedef typename base::iterator::iterator_category iterator_category;
+      iterator() {}
+      iterator& operator++() { ++i; return *this; }
+      iterator operator++(int) { iterator ci = *this; ++i; return ci; }
+      iterator& operator--() { --i; return *this; }
+      iterator operator--(int) { iterator ci = *this; --i; return ci; }
+      difference_type operator-(iterator const& o) const { return i - o.i; }
+      iterator operator+(difference_type n) const { return iterator(i + n); }
+      iterator operator-(difference_type n) const { return iterator(i - n); }
+      bool operator<(iterator const& o) const { return i < o.i; }
+      bool operator==(iterator const& ci) const { return i == ci.i; }
+      bool operator!=(iterator const& ci) const { return i != ci.i; }
+      T & operator *() const { return **i; }
+      T * operator->() const { return & (operator*()); }
+      iterator & operator +=(difference_type d) { i += d; return *this; }
+      iterator & operator -=(difference_type d) { i -= d; return *this; }
+      reference operator[](difference_type d) const { return *iterator(i+d); } // for boost::iterator_range []
+    private:
+      iterator(typename base::iterator const& it) : i(it) { }
+      typename base::iterator i;
+      friend class const_iterator;
+      friend class ArenaOwnVector<T, P>;
+    };
+
+    ArenaOwnVector();
+    ArenaOwnVector(ArenaOwnVector const&);
+    ArenaOwnVector(ArenaOwnVector&&) noexcept;
+    /// takes over the elements of the OwnVector, which is left empty
+    explicit ArenaOwnVector(OwnVector<T, P>&&);
+
+    ~ArenaOwnVector() noexcept;
+
+    ArenaOwnVector<T, P>& operator=(ArenaOwnVector<T, P> const&);
+    ArenaOwnVector<T, P>& operator=(ArenaOwnVector<T, P>&&) noexcept;
+
+    iterator begin() { return iterator(data_.begin()); }
+    iterator end() { return iterator(data_.end()); }
+    const_iterator begin() const { return const_iterator(data_.begin()); }
+    const_iterator end() const { return const_iterator(data_.end()); }
+    size_type size() const { return data_.size(); }
+    bool empty() const { return data_.empty(); }
+    reference operator[](size_type n) { return *data_[n]; }
+    const_reference operator[](size_type n) const { return *data_[n]; }
+    reference front() { return *data_.front(); }
+    const_reference front() const { return *data_.front(); }
+    reference back() { return *data_.back(); }
+    const_reference back() const { return *data_.back(); }
+    base const& data() const { return data_; }
+
+    void reserve(size_t n) { data_.reserve(n); }
+    /// makes room for n elements of type D in the blocks
+    template <typename D> void reserve(size_t n);
+
+    /// constructs a D in the blocks of the elements of type D
+    template <typename D, typename... Args> D& emplace_back(Args&&... args);
+    template <typename D> void push_back(D*& d);
+    template <typename D> void push_back(D* const& d);
+    template <typename D> void push_back(std::unique_ptr<D> d);
+    void push_back(T const& valueToCopy);
+
+    void pop_back();
+    /// destroys the elements; the blocks are kept for the next elements
+    void clear();
+    void reverse() { std::reverse(data_.begin(), data_.end()); }
+    template<typename S>
+    void sort(S s);
+    void sort();
+
+    void swap(ArenaOwnVector<T, P>& other) noexcept;
+
+    /// number of blocks allocated for the elements of all types
+    size_type numberOfBlocks() const;
+
+    void fillView(ProductID const& id,
+                  std::vector<void const*>& pointers,
+                  FillViewHelperVector& helpers) const;
+
+    void setPtr(std::type_info const& toType,
+                unsigned long index,
+                void const*& ptr) const;
+
+    void fillPtrVector(std::type_info const& toType,
+                       std::vector<unsigned long> const& indices,
+                       std::vector<void const*>& ptrs) const;
+
+  private:
+    typedef detail::ArenaOwnVectorPool<T> Pool;
+
+    template<typename D>
+    static T* copyElement(void* where, T const& from) {
+      return new(where) D(dynamic_cast<D const&>(from));
+    }
+    template<typename D>
+    Pool& poolFor();
+    Pool* findPool(std::type_info const& type) const;
+    bool inBlocks(T const* p) const;
+    void pushBackFromBlocks(Pool& pool, T* p);
+    void destroy(T* p) noexcept;
+    void destroyAll() noexcept;
+
+    template<typename O>
+    struct Ordering {
+      Ordering(O const& c) : comp(c) { }
+      bool operator()(T const* t1, T const* t2) const {
+        return comp(*t1, *t2);
+      }
+    private:
+      O comp;
+    };
+
+    base data_;
+    std::vector<std::unique_ptr<Pool> > pools_;
+    size_type nInBlocks_;
+  };
+
+  template<typename T, typename P>
+  inline ArenaOwnVector<T, P>::ArenaOwnVector() : data_(), pools_(), nInBlocks_(0) {
+  }
+
+  template<typename T, typename P>
+  inline ArenaOwnVector<T, P>::ArenaOwnVector(ArenaOwnVector<T, P> const& o) : data_(), pools_(), nInBlocks_(0) {
+    //the elements in blocks are copied in one block per type
+    for(auto const& pool : o.pools_) {
+      pools_.push_back(pool->emptyCopy());
+      pools_.back()->reserve(pool->used());
+    }
+    data_.reserve(o.size());
+    for(T const* p : o.data_) {
+      if(p == nullptr) {
+        data_.push_back(nullptr);
+      } else if(o.inBlocks(p)) {
+        data_.push_back(findPool(typeid(*p))->copy(*p));
+        ++nInBlocks_;
+      } else {
+        data_.push_back(policy_type::clone(*p));
+      }
+    }
+  }
+
+  template<typename T, typename P>
+  inline ArenaOwnVector<T, P>::ArenaOwnVector(ArenaOwnVector<T, P>&& o) noexcept : data_(), pools_(), nInBlocks_(0) {
+    swap(o);
+  }
+
+  template<typename T, typename P>
+  inline ArenaOwnVector<T, P>::ArenaOwnVector(OwnVector<T, P>&& o) : data_(), pools_(), nInBlocks_(0) {
+    data_.reserve(o.size());
+    for(auto& p : o.data_) {
+      data_.push_back(p);
+      p = nullptr;
+    }
+    o.data_.clear();
+  }
+
+  template<typename T, typename P>
+  inline ArenaOwnVector<T, P>::~ArenaOwnVector() noexcept {
+    destroyAll();
+  }
+
+  template<typename T, typename P>
+  inline ArenaOwnVector<T, P>& ArenaOwnVector<T, P>::operator=(ArenaOwnVector<T, P> const& o) {
+    ArenaOwnVector<T, P> temp(o);
+    swap(temp);
+    return *this;
+  }
+
+  template<typename T, typename P>
+  inline ArenaOwnVector<T, P>& ArenaOwnVector<T, P>::operator=(ArenaOwnVector<T, P>&& o) noexcept {
+    swap(o);
+    return *this;
+  }
+
+  template<typename T, typename P>
+  template<typename D>
+  inline typename ArenaOwnVector<T, P>::Pool& ArenaOwnVector<T, P>::poolFor() {
+    static_assert(alignof(D) <= alignof(std::max_align_t),
+                  "ArenaOwnVector can not store over-aligned types in its blocks");
+    Pool* pool = findPool(typeid(D));
+    if(pool == nullptr) {
+      pools_.emplace_back(new Pool(typeid(D), sizeof(D), &copyElement<D>));
+      pool = pools_.back().get();
+    }
+    return *pool;
+  }
+
+  template<typename T, typename P>
+  inline typename ArenaOwnVector<T, P>::Pool* ArenaOwnVector<T, P>::findPool(std::type_info const& type) const {
+    //there are only a few types in a collection
+    for(auto const& pool : pools_) {
+      if(pool->type() == type) return pool.get();
+    }
+    return nullptr;
+  }
+
+  template<typename T, typename P>
+  template<typename D>
+  inline void ArenaOwnVector<T, P>::reserve(size_t n) {
+    poolFor<D>().reserve(n);
+  }
+
+  template<typename T, typename P>
+  template<typename D, typename... Args>
+  inline D& ArenaOwnVector<T, P>::emplace_back(Args&&... args) {
+    Pool& pool = poolFor<D>();
+    void* where = pool.allocate();
+    D* d;
+    try {
+      d = new(where) D(std::forward<Args>(args)...);
+    } catch(...) {
+      pool.deallocate(where);
+      throw;
+    }
+    pushBackFromBlocks(pool, d);
+    return *d;
+  }
+
+  template<typename T, typename P>
+  template<typename D>
+  inline void ArenaOwnVector<T, P>::push_back(D*& d) {
+    data_.push_back(d);
+    d = 0;
+  }
+
+  template<typename T, typename P>
+  template<typename D>
+  inline void ArenaOwnVector<T, P>::push_back(D* const& d) {
+    data_.push_back(d);
+  }
+
+  template<typename T, typename P>
+  template<typename D>
+  inline void ArenaOwnVector<T, P>::push_back(std::unique_ptr<D> d) {
+    data_.push_back(d.release());
+  }
+
+  template<typename T, typename P>
+  inline void ArenaOwnVector<T, P>::push_back(T const& d) {
+    Pool* pool = findPool(typeid(d));
+    if(pool == nullptr) {
+      std::unique_ptr<T> p(policy_type::clone(d));
+      data_.push_back(p.get());
+      p.release();
+    } else {
+      pushBackFromBlocks(*pool, pool->copy(d));
+    }
+  }
+
+  template<typename T, typename P>
+  inline void ArenaOwnVector<T, P>::pushBackFromBlocks(Pool& pool, T* p) {
+    //if the vector of pointers can not grow, the element goes back to the blocks
+    try {
+      data_.push_back(p);
+    } catch(...) {
+      p->~T();
+      pool.deallocate(p);
+      throw;
+    }
+    ++nInBlocks_;
+  }
+
+  template<typename T, typename P>
+  inline void ArenaOwnVector<T, P>::pop_back() {
+    destroy(data_.back());
+    data_.pop_back();
+  }
+
+  template<typename T, typename P>
+  inline void ArenaOwnVector<T, P>::clear() {
+    destroyAll();
+    data_.clear();
+    nInBlocks_ = 0;
+    for(auto& pool : pools_) pool->reset();
+  }
+
+  template<typename T, typename P>
+  inline bool ArenaOwnVector<T, P>::inBlocks(T const* p) const {
+    if(nInBlocks_ == 0) return false;
+    if(nInBlocks_ == data_.size()) return true;
+    Pool* pool = findPool(typeid(*p));
+    return pool != nullptr && pool->owns(p);
+  }
+
+  template<typename T, typename P>
+  inline void ArenaOwnVector<T, P>::destroy(T* p) noexcept {
+    if(p == nullptr) return;
+    if(inBlocks(p)) {
+      p->~T();
+      --nInBlocks_;
+    } else {
+      delete p;
+    }
+  }
+
+  template<typename T, typename P>
+  inline void ArenaOwnVector<T, P>::destroyAll() noexcept {
+    //the usual cases, all the elements either in the blocks or not
+    if(nInBlocks_ == data_.size()) {
+      for(T* p : data_) p->~T();
+    } else if(nInBlocks_ == 0) {
+      for(T* p : data_) delete p;
+    } else {
+      for(T* p : data_) destroy(p);
+    }
+  }
+
+  template<typename T, typename P> template<typename S>
+  void ArenaOwnVector<T, P>::sort(S comp) {
+    std::sort(data_.begin(), data_.end(), Ordering<S>(comp));
+  }
+
+  template<typename T, typename P>
+  void ArenaOwnVector<T, P>::sort() {
+    std::sort(data_.begin(), data_.end(), Ordering<std::less<value_type> >(std::less<value_type>()));
+  }
+
+  template<typename T, typename P>
+  inline void ArenaOwnVector<T, P>::swap(ArenaOwnVector<T, P>& other) noexcept {
+    data_.swap(other.data_);
+    pools_.swap(other.pools_);
+    std::swap(nInBlocks_, other.nInBlocks_);
+  }
+
+  template<typename T, typename P>
+  inline typename ArenaOwnVector<T, P>::size_type ArenaOwnVector<T, P>::numberOfBlocks() const {
+    size_type n = 0;
+    for(auto const& pool : pools_) n += pool->numberOfBlocks();
+    return n;
+  }
+
+  template<typename T, typename P>
+  void ArenaOwnVector<T, P>::fillView(ProductID const& id,
+                                      std::vector<void const*>& pointers,
+                                      FillViewHelperVector& helpers) const {
+    pointers.reserve(size());
+    helpers.reserve(size());
+    size_type key = 0;
+    for(typename base::const_iterator i = data_.begin(), e = data_.end(); i != e; ++i, ++key) {
+      if(*i == 0) {
+        Exception::throwThis(errors::NullPointerError,
+          "In ArenaOwnVector::fillView() we have intercepted an attempt to put a null pointer\n"
+          "into a View and that is not allowed.\n");
+      }
+      pointers.push_back(*i);
+      helpers.emplace_back(id, key);
+    }
+  }
+
+  template<typename T, typename P>
+  inline void swap(ArenaOwnVector<T, P>& a, ArenaOwnVector<T, P>& b) noexcept {
+    a.swap(b);
+  }
+
+  template <typename T, typename P>
+  inline
+  void
+  fillView(ArenaOwnVector<T,P> const& obj,
+           ProductID const& id,
+           std::vector<void const*>& pointers,
+           FillViewHelperVector& helpers) {
+    obj.fillView(id, pointers, helpers);
+  }
+
+  template <typename T, typename P>
+  struct has_fillView<edm::ArenaOwnVector<T, P> > {
+    static bool const value = true;
+  };
+
+  template <typename T, typename P>
+  inline
+  void
+  ArenaOwnVector<T,P>::setPtr(std::type_info const& toType,
+                              unsigned long index,
+                              void const*& ptr) const {
+    detail::reallySetPtr<ArenaOwnVector<T,P> >(*this, toType, index, ptr);
+  }
+
+  template <typename T, typename P>
+  inline
+  void
+  setPtr(ArenaOwnVector<T,P> const& obj,
+         std::type_info const& toType,
+         unsigned long index,
+         void const*& ptr) {
+    obj.setPtr(toType, index, ptr);
+  }
+
+  template <typename T, typename P>
+  inline
+  void
+  ArenaOwnVector<T,P>::fillPtrVector(std::type_info const& toType,
+                                     std::vector<unsigned long> const& indices,
+                                     std::vector<void const*>& ptrs) const {
+    detail::reallyfillPtrVector(*this, toType, indices, ptrs);
+  }
+
+  template <typename T, typename P>
+  inline
+  void
+  fillPtrVector(ArenaOwnVector<T,P> const& obj,
+                std::type_info const& toType,
+                std::vector<unsigned long> const& indices,
+                std::vector<void const*>& ptrs) {
+    obj.fillPtrVector(toType, indices, ptrs);
+  }
+
+  template <typename T, typename P>
+  struct has_setPtr<edm::ArenaOwnVector<T,P> > {
+    static bool const value = true;
+  };
+}
+
+#endif
@@ -43,6 +43,7 @@
 namespace edm {
 
   class EDProductGetter;
+  template<typename Tag> class FlatAssociationMap;
 
   template<typename Tag>
   class AssociationMap {
@@ -268,6 +269,7 @@ namespace edm {
     template<typename, typename, typename> friend class OneToOne;
     template<typename, typename, typename> friend class OneToMany;
     template<typename, typename, typename, typename> friend class OneToManyWithQuality;
+    template<typename> friend class FlatAssociationMap;
   };
 
   namespace refhelper {
@@ -0,0 +1,165 @@
+#ifndef DataFormats_Common_FlatAssociationMap_h
+#define DataFormats_Common_FlatAssociationMap_h
+/** \class edm::FlatAssociationMap
+ *
+ * Read-only copy of an AssociationMap laid out for fast lookups.
+ *
+ * All the keys of an AssociationMap point into the same collection, so
+ * the associations are stored in a table indexed directly by the key
+ * index: the associations of the key k are values[offsets[k]] to
+ * values[offsets[k+1]].  A lookup is two array accesses, instead of a
+ * search in the persistent std::map followed by a search (and the first
+ * time an insertion) in the transient map of the AssociationMap.
+ *
+ * Lookups return their result by value: a Ref for OneToOne, a RefVector
+ * for OneToMany, a vector of (Ref, quality) for OneToManyWithQuality and
+ * the value for OneToValue.  The stored associations can also be read
+ * directly with associationsBegin and associationsEnd, e.g. the indices in
+ * the value collection for OneToOne and OneToMany.
+ *
+ * The table has one entry per element of the key collection up to the
+ * largest key associated, so this is meant for associations covering a
+ * good part of their key collection, which is the usual case.
+ *
+ * This is a transient class, built once per event from the AssociationMap
+ * read from the event by a module doing many lookups.
+ */
+
+#include "DataFormats/Common/interface/AssociationMap.h"
+
+#include <vector>
+
+namespace edm {
+
+  namespace helpers {
+    /// how the associations of one key are stored: a single element, or a
+    /// range of elements for the one-to-many associations
+    template<typename Assoc>
+    struct FlatAssociations {
+      typedef Assoc element_type;
+      static void append(std::vector<element_type>& oElements, Assoc const& iAssoc) {
+        oElements.push_back(iAssoc);
+      }
+      static Assoc assoc(element_type const* iBegin, element_type const*) {
+        return *iBegin;
+      }
+    };
+
+    template<typename E>
+    struct FlatAssociations<std::vector<E> > {
+      typedef E element_type;
+      static void append(std::vector<element_type>& oElements, std::vector<E> const& iAssoc) {
+        oElements.insert(oElements.end(), iAssoc.begin(), iAssoc.end());
+      }
+      static std::vector<E> assoc(element_type const* iBegin, element_type const* iEnd) {
+        return std::vector<E>(iBegin, iEnd);
+      }
+    };
+
+    //a OneToValue holds one value, even when the value is a vector
+    template<typename Tag>
+    struct FlatAssociationsFor : public FlatAssociations<typename Tag::map_type::mapped_type> {
+    };
+
+    template<typename CKey, typename Val, typename index>
+    struct FlatAssociationsFor<OneToValue<CKey, Val, index> > {
+      typedef Val element_type;
+      static void append(std::vector<element_type>& oElements, Val const& iAssoc) {
+        oElements.push_back(iAssoc);
+      }
+      static Val assoc(element_type const* iBegin, element_type const*) {
+        return *iBegin;
+      }
+    };
+  }
+
+  template<typename Tag>
+  class FlatAssociationMap {
+    typedef helpers::FlatAssociationsFor<Tag> associations;
+  public:
+    typedef typename Tag::index_type index_type;
+    typedef typename Tag::key_type key_type;
+    typedef typename Tag::val_type result_type;
+    typedef typename Tag::ref_type ref_type;
+    typedef typename associations::element_type element_type;
+    typedef typename std::vector<element_type>::size_type size_type;
+
+    FlatAssociationMap() : ref_(), offsets_(), elements_(), size_(0) { }
+
+    explicit FlatAssociationMap(AssociationMap<Tag> const& iMap) :
+      ref_(iMap.ref_), offsets_(), elements_(), size_(iMap.map_.size()) {
+      if(iMap.map_.empty()) return;
+      //the std::map iterates in the order of the key indices
+      offsets_.reserve(size_type(iMap.map_.rbegin()->first) + 2);
+      offsets_.push_back(0);
+      for(auto const& keyAssoc : iMap.map_) {
+        //keys without association get an empty range
+        while(offsets_.size() <= size_type(keyAssoc.first)) {
+          offsets_.push_back(elements_.size());
+        }
+        associations::append(elements_, keyAssoc.second);
+        offsets_.push_back(elements_.size());
+      }
+    }
+
+    /// number of keys with an association
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /// return ref-prod structure
+    ref_type const& refProd() const { return ref_; }
+
+    /// number of stored associations of a key, 0 if it has none or it is not from the key collection
+    template<typename K>
+    size_type numberOfAssociations(K const& k) const {
+      if(ref_.key.id() != k.id()) return 0;
+      size_type i = k.key();
+      if(i + 1 >= offsets_.size()) return 0;
+      return offsets_[i+1] - offsets_[i];
+    }
+
+    template<typename K>
+    bool contains(K const& k) const { return numberOfAssociations(k) != 0; }
+
+    /// the associations of a key, throws if the key has none
+    template<typename K>
+    result_type operator[](K const& k) const {
+      helpers::checkRef(ref_.key, k);
+      size_type i = k.key();
+      if(i + 1 >= offsets_.size() || offsets_[i] == offsets_[i+1]) {
+        Exception::throwThis(edm::errors::InvalidReference, "can't find reference in FlatAssociationMap at position ", i);
+      }
+      return Tag::val(ref_, associations::assoc(elements_.data() + offsets_[i], elements_.data() + offsets_[i+1]));
+    }
+
+    /// the stored associations of a key, an empty range if it has none
+    template<typename K>
+    element_type const* associationsBegin(K const& k) const {
+      return begin(k, 0);
+    }
+    template<typename K>
+    element_type const* associationsEnd(K const& k) const {
+      return begin(k, 1);
+    }
+
+  private:
+    template<typename K>
+    element_type const* begin(K const& k, size_type iNext) const {
+      if(ref_.key.id() != k.id()) return nullptr;
+      size_type i = k.key();
+      if(i + 1 >= offsets_.size()) return nullptr;
+      return elements_.data() + offsets_[i + iNext];
+    }
+
+    ref_type ref_;
+    std::vector<unsigned int> offsets_;
+    std::vector<element_type> elements_;
+    size_type size_;
+  };
+
+  template<typename Tag>
+  FlatAssociationMap<Tag> makeFlatAssociationMap(AssociationMap<Tag> const& iMap) {
+    return FlatAssociationMap<Tag>(iMap);
+  }
+}
+#endif
@@ -20,6 +20,7 @@
 
 namespace edm {
   class ProductID;
+  template <typename T, typename P> class ArenaOwnVector;
   template <typename T, typename P = ClonePolicy<T> >
   class OwnVector {
   public:
@@ -195,6 +196,7 @@ namespace edm {
       return Ordering<O>(comp);
     }
     base data_;
+    friend class ArenaOwnVector<T, P>;
   };
 
   template<typename T, typename P>
@@ -14,6 +14,8 @@
 #include <map>
 #include <iterator>
 #include <algorithm>
+#include <atomic>
+#include <utility>
 
 namespace edm {
   namespace helper {
@@ -110,7 +112,15 @@ namespace edm {
     typedef typename container::reference       reference_type;
     typedef typename container::const_reference const_reference_type;
 
-    ValueMap() { }
+    ValueMap() : lastIdIndex_(0) { }
+
+    ValueMap(ValueMap const& other) :
+      values_(other.values_), ids_(other.ids_), lastIdIndex_(0) { }
+
+    ValueMap(ValueMap&& other) :
+      values_(std::move(other.values_)), ids_(std::move(other.ids_)), lastIdIndex_(0) {
+      other.lastIdIndex_.store(0, std::memory_order_relaxed);
+    }
 
     void swap(ValueMap& other) {
       values_.swap(other.values_);
@@ -123,6 +133,14 @@ namespace edm {
       return *this;
     }
 
+    ValueMap& operator=(ValueMap&& rhs) {
+      values_ = std::move(rhs.values_);
+      ids_ = std::move(rhs.ids_);
+      lastIdIndex_.store(0, std::memory_order_relaxed);
+      rhs.lastIdIndex_.store(0, std::memory_order_relaxed);
+      return *this;
+    }
+
     template<typename RefKey>
     const_reference_type operator[](const RefKey & r) const {
       return get(r.id(), r.key());
@@ -218,11 +236,17 @@ namespace edm {
   protected:
     container values_;
     id_offset_vector ids_;
+    /// position in ids_ of the product found by the last lookup, which is
+    /// usually the one asked for next. Only a hint, checked before use.
+    mutable std::atomic<unsigned int> lastIdIndex_; //! transient
 
     typename id_offset_vector::const_iterator getIdOffset(ProductID id) const {
+      unsigned int last = lastIdIndex_.load(std::memory_order_relaxed);
+      if(last < ids_.size() && ids_[last].first == id) return ids_.begin() + last;
       typename id_offset_vector::const_iterator i = std::lower_bound(ids_.begin(), ids_.end(), id, IDComparator());
-      if(i==ids_.end()) return i;
-      return i->first == id ? i : ids_.end();
+      if(i==ids_.end() || i->first != id) return ids_.end();
+      lastIdIndex_.store(i - ids_.begin(), std::memory_order_relaxed);
+      return i;
     }
 
     void throwIndexBound() const {
@@ -0,0 +1,180 @@
+#include <cassert>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "DataFormats/Common/interface/ArenaOwnVector.h"
+
+namespace {
+  int alive = 0;
+
+  struct Base {
+    Base() { ++alive; }
+    Base(Base const&) { ++alive; }
+    virtual ~Base() { --alive; }
+    virtual Base* clone() const = 0;
+    virtual int value() const = 0;
+    bool operator<(Base const& o) const { return value() < o.value(); }
+  };
+
+  struct Small : Base {
+    explicit Small(int n) : n_(n) { }
+    Small* clone() const override { return new Small(*this); }
+    int value() const override { return n_; }
+    int n_;
+  };
+
+  struct Large : Base {
+    explicit Large(int n) : n_(n), payload_(n, n) { }
+    Large* clone() const override { return new Large(*this); }
+    int value() const override { return n_; }
+    int n_;
+    std::vector<int> payload_;
+    double more_[8];
+  };
+
+  struct Throwing : Base {
+    explicit Throwing(int n) : n_(n) { if(n < 0) throw std::runtime_error("Throwing"); }
+    Throwing(Throwing const& o) : Base(o), n_(o.n_) { if(n_ == 13) throw std::runtime_error("Throwing"); }
+    Throwing* clone() const override { return new Throwing(*this); }
+    int value() const override { return n_; }
+    int n_;
+  };
+
+  struct Other : Base {
+    explicit Other(int n) : n_(n) { }
+    Other* clone() const override { return new Other(*this); }
+    int value() const override { return n_; }
+    int n_;
+  };
+}
+
+void fill_and_read()
+{
+  edm::ArenaOwnVector<Base> v;
+  for(int i = 0; i < 100; ++i) {
+    if(i % 2 == 0) v.emplace_back<Small>(i);
+    else v.emplace_back<Large>(i);
+  }
+  assert(v.size() == 100);
+  assert(alive == 100);
+  int i = 0;
+  for(auto const& e : v) {
+    assert(e.value() == i++);
+  }
+  assert(v[3].value() == 3);
+  assert(v.back().value() == 99);
+  // blocks of 16, 32 and 64 for each of the two types
+  assert(v.numberOfBlocks() == 6);
+  // the elements of one type are next to each other
+  assert(&v[2] == static_cast<Base*>(&static_cast<Small&>(v[0]) + 1));
+  v.pop_back();
+  assert(alive == 99);
+}
+
+void reuse_after_clear()
+{
+  edm::ArenaOwnVector<Base> v;
+  v.reserve<Small>(50);
+  for(int i = 0; i < 50; ++i) v.emplace_back<Small>(i);
+  assert(v.numberOfBlocks() == 1);
+  v.clear();
+  assert(v.empty());
+  assert(alive == 0);
+  for(int i = 0; i < 50; ++i) v.emplace_back<Small>(i);
+  assert(v.numberOfBlocks() == 1);
+  v.clear();
+}
+
+void mixed_ownership()
+{
+  edm::ArenaOwnVector<Base> v;
+  v.emplace_back<Small>(1);
+  Base* p = new Large(2);
+  v.push_back(p);
+  assert(p == nullptr);
+  v.push_back(std::unique_ptr<Base>(new Other(3)));
+  // copied into the blocks of Small, cloned for Large
+  v.push_back(Small(4));
+  v.push_back(Large(5));
+  assert(v.size() == 5);
+  assert(alive == 5);
+  assert(v[3].value() == 4);
+  v.sort([](Base const& a, Base const& b) { return a.value() > b.value(); });
+  assert(v.front().value() == 5);
+  v.sort();
+  assert(v.front().value() == 1);
+}
+
+void copy_and_move()
+{
+  edm::ArenaOwnVector<Base> v1;
+  v1.emplace_back<Small>(1);
+  v1.emplace_back<Large>(2);
+  v1.push_back(new Other(3));
+
+  edm::ArenaOwnVector<Base> v2(v1);
+  assert(v2.size() == 3);
+  assert(&v2[0] != &v1[0]);
+  assert(v2[1].value() == 2);
+  assert(v2.numberOfBlocks() == 2);
+  assert(alive == 6);
+
+  v2 = v2;
+  assert(v2.size() == 3);
+
+  edm::ArenaOwnVector<Base> v3(std::move(v1));
+  assert(v1.empty());
+  assert(v3[2].value() == 3);
+  assert(alive == 6);
+
+  edm::OwnVector<Base> ov;
+  ov.push_back(new Small(7));
+  Base const* element = &ov[0];
+  edm::ArenaOwnVector<Base> v4(std::move(ov));
+  assert(ov.empty());
+  assert(&v4[0] == element);
+}
+
+void exception_safety()
+{
+  edm::ArenaOwnVector<Base> v;
+  v.emplace_back<Throwing>(1);
+  bool thrown = false;
+  try {
+    v.emplace_back<Throwing>(-1);
+  } catch(std::runtime_error const&) {
+    thrown = true;
+  }
+  assert(thrown);
+  assert(v.size() == 1);
+  assert(alive == 1);
+  // a copy into the blocks which throws
+  thrown = false;
+  try {
+    v.push_back(Throwing(13));
+  } catch(std::runtime_error const&) {
+    thrown = true;
+  }
+  assert(thrown);
+  assert(v.size() == 1);
+  assert(alive == 1);
+  // the memory of the failed elements is used for the next one
+  v.emplace_back<Throwing>(2);
+  assert(&v[1] == static_cast<Base*>(&static_cast<Throwing&>(v[0]) + 1));
+  assert(v.numberOfBlocks() == 1);
+}
+
+int main()
+{
+  fill_and_read();
+  assert(alive == 0);
+  reuse_after_clear();
+  assert(alive == 0);
+  mixed_ownership();
+  assert(alive == 0);
+  copy_and_move();
+  assert(alive == 0);
+  exception_safety();
+  assert(alive == 0);
+}
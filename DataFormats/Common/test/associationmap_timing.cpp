@@ -0,0 +1,129 @@
+// Times lookups in an AssociationMap, in the FlatAssociationMap made
+// from it, and in a ValueMap, the way an analysis matching every element
+// of one collection to another does them.
+//
+//   associationmap_timing [number of keys] [passes]
+
+#include "DataFormats/Common/interface/FlatAssociationMap.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/Common/test/SimpleEDProductGetter.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+  typedef std::chrono::steady_clock Clock;
+  typedef std::vector<int> CKey;
+  typedef std::vector<double> CVal;
+  typedef edm::AssociationMap<edm::OneToOne<CKey, CVal> > OneToOneMap;
+  typedef edm::AssociationMap<edm::OneToMany<CKey, CVal> > OneToManyMap;
+
+  double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+}
+
+int main(int argc, char* argv[]) {
+  unsigned int const nKeys = argc > 1 ? std::atoi(argv[1]) : 200000;
+  unsigned int const nPasses = argc > 2 ? std::atoi(argv[2]) : 5;
+
+  SimpleEDProductGetter getter;
+  edm::ProductID const keyID(1, 1), valID(1, 2), otherID(1, 3);
+  getter.addProduct(keyID, std::make_unique<CKey>(nKeys, 1));
+  getter.addProduct(valID, std::make_unique<CVal>(nKeys, 2.));
+  getter.addProduct(otherID, std::make_unique<CKey>(nKeys, 3));
+
+  std::vector<edm::Ref<CKey> > keys;
+  keys.reserve(nKeys);
+  for(unsigned int i = 0; i < nKeys; ++i) {
+    keys.emplace_back(keyID, i, &getter);
+  }
+
+  //every third key is not associated
+  OneToOneMap oneToOne(edm::RefProd<CKey>(keyID, &getter), edm::RefProd<CVal>(valID, &getter));
+  OneToManyMap oneToMany(edm::RefProd<CKey>(keyID, &getter), edm::RefProd<CVal>(valID, &getter));
+  for(unsigned int i = 0; i < nKeys; ++i) {
+    if(i % 3 == 2) continue;
+    oneToOne.insert(keys[i], edm::Ref<CVal>(valID, (i * 7) % nKeys, &getter));
+    oneToMany.insert(keys[i], edm::Ref<CVal>(valID, (i * 7) % nKeys, &getter));
+    oneToMany.insert(keys[i], edm::Ref<CVal>(valID, (i * 11) % nKeys, &getter));
+  }
+
+  double tMap = 0., tMapFirst = 0., tFlat = 0., tFlatBuild = 0., tManyMap = 0., tManyFlat = 0.;
+  double tValueMap = 0.;
+  unsigned long sum = 0, flatSum = 0;
+
+  edm::ValueMap<float> valueMap;
+  {
+    edm::ValueMap<float>::Filler filler(valueMap);
+    std::vector<float> values(nKeys, 1.f);
+    filler.insert(edm::RefProd<CKey>(keyID, &getter), values.begin(), values.end());
+    filler.insert(edm::RefProd<CKey>(otherID, &getter), values.begin(), values.end());
+    filler.fill();
+  }
+
+  for(unsigned int pass = 0; pass < nPasses; ++pass) {
+    Clock::time_point start = Clock::now();
+    for(auto const& key : keys) {
+      if(oneToOne.numberOfAssociations(key) != 0) {
+        sum += oneToOne[key].key();
+      }
+    }
+    (pass == 0 ? tMapFirst : tMap) += msSince(start);
+
+    start = Clock::now();
+    auto const flat = edm::makeFlatAssociationMap(oneToOne);
+    tFlatBuild += msSince(start);
+    start = Clock::now();
+    for(auto const& key : keys) {
+      if(flat.numberOfAssociations(key) != 0) {
+        flatSum += flat[key].key();
+      }
+    }
+    tFlat += msSince(start);
+
+    start = Clock::now();
+    for(auto const& key : keys) {
+      if(oneToMany.numberOfAssociations(key) != 0) {
+        sum += oneToMany[key].size();
+      }
+    }
+    tManyMap += msSince(start);
+    start = Clock::now();
+    auto const flatMany = edm::makeFlatAssociationMap(oneToMany);
+    for(auto const& key : keys) {
+      flatSum += flatMany.numberOfAssociations(key);
+    }
+    tManyFlat += msSince(start);
+
+    start = Clock::now();
+    float total = 0.f;
+    for(auto const& key : keys) {
+      total += valueMap[key];
+    }
+    tValueMap += msSince(start);
+    sum += total;
+    flatSum += total;
+  }
+
+  double const n = nPasses > 1 ? nPasses - 1 : 1;
+  double const passes = nPasses > 0 ? nPasses : 1;
+  std::cout << std::fixed << std::setprecision(2)
+            << "keys:                              " << nKeys << "\n"
+            << "OneToOne AssociationMap, 1st pass: " << tMapFirst << " ms\n"
+            << "OneToOne AssociationMap, next:     " << tMap / n << " ms\n"
+            << "FlatAssociationMap build:          " << tFlatBuild / passes << " ms\n"
+            << "OneToOne FlatAssociationMap:       " << tFlat / passes << " ms\n"
+            << "OneToMany AssociationMap:          " << tManyMap / passes << " ms\n"
+            << "OneToMany flat, build and count:   " << tManyFlat / passes << " ms\n"
+            << "ValueMap:                          " << tValueMap / passes << " ms\n";
+  if(sum != flatSum) {
+    std::cerr << "FlatAssociationMap and AssociationMap lookups differ\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,156 @@
+// Compares an OwnVector and an ArenaOwnVector holding hits of a few
+// types, the way a reconstruction module fills and reads them event after
+// event: time to fill, to iterate, to copy, and the number of allocations.
+// Each container is filled once reserved up front and reused from event to
+// event, and once as a new collection per event without any reserve.
+//
+//   ownvector_timing [number of elements] [events]
+
+#include "DataFormats/Common/interface/ArenaOwnVector.h"
+#include "DataFormats/Common/interface/OwnVector.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+
+namespace {
+  unsigned long nAllocations = 0;
+}
+
+void* operator new(std::size_t n) {
+  ++nAllocations;
+  if(void* p = std::malloc(n)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t n) {
+  return operator new(n);
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+  typedef std::chrono::steady_clock Clock;
+
+  double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+
+  struct Hit {
+    virtual ~Hit() { }
+    virtual Hit* clone() const = 0;
+    virtual float weight() const = 0;
+    unsigned int id_;
+    float position_[3];
+  };
+
+  struct PixelHit : Hit {
+    explicit PixelHit(unsigned int i) { id_ = i; position_[0] = i; error_[0] = 1.f; }
+    PixelHit* clone() const override { return new PixelHit(*this); }
+    float weight() const override { return position_[0] * error_[0]; }
+    float error_[6];
+  };
+
+  struct StripHit : Hit {
+    explicit StripHit(unsigned int i) { id_ = i; position_[0] = i; charge_ = 2.f; }
+    StripHit* clone() const override { return new StripHit(*this); }
+    float weight() const override { return position_[0] * charge_; }
+    float charge_;
+  };
+
+  struct MatchedHit : Hit {
+    explicit MatchedHit(unsigned int i) { id_ = i; position_[0] = i; error_[0] = 3.f; }
+    MatchedHit* clone() const override { return new MatchedHit(*this); }
+    float weight() const override { return position_[0] * error_[0]; }
+    float error_[12];
+  };
+
+  struct Result {
+    double fill = 0., iterate = 0., copy = 0.;
+    unsigned long allocations = 0;
+    double sum = 0.;
+  };
+
+  template<typename V, typename Add>
+  Result run(unsigned int nElements, unsigned int nEvents, bool reserve, Add add) {
+    Result r;
+    std::unique_ptr<V> reused(new V);
+    for(unsigned int event = 0; event < nEvents; ++event) {
+      unsigned long const allocationsBefore = nAllocations;
+      Clock::time_point start = Clock::now();
+      std::unique_ptr<V> fresh;
+      if(reserve) {
+        reused->clear();
+        reused->reserve(nElements);
+      } else {
+        fresh.reset(new V);
+      }
+      V& v = reserve ? *reused : *fresh;
+      for(unsigned int i = 0; i < nElements; ++i) {
+        add(v, i);
+      }
+      r.fill += msSince(start);
+      r.allocations += nAllocations - allocationsBefore;
+
+      start = Clock::now();
+      for(auto const& hit : v) {
+        r.sum += hit.weight();
+      }
+      r.iterate += msSince(start);
+
+      start = Clock::now();
+      V copy(v);
+      r.sum += copy.size();
+      r.copy += msSince(start);
+    }
+    return r;
+  }
+
+  void print(char const* name, Result const& r, unsigned int nEvents) {
+    std::cout << name
+              << "  fill " << r.fill / nEvents << " ms"
+              << "  iterate " << r.iterate / nEvents << " ms"
+              << "  copy " << r.copy / nEvents << " ms"
+              << "  allocations per fill " << r.allocations / nEvents << "\n";
+  }
+}
+
+int main(int argc, char* argv[]) {
+  unsigned int const nElements = argc > 1 ? std::atoi(argv[1]) : 500000;
+  unsigned int const nEvents = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10;
+
+  auto addOwn = [](edm::OwnVector<Hit>& v, unsigned int i) {
+    switch(i % 3) {
+    case 0: v.push_back(std::unique_ptr<Hit>(new PixelHit(i))); break;
+    case 1: v.push_back(std::unique_ptr<Hit>(new StripHit(i))); break;
+    default: v.push_back(std::unique_ptr<Hit>(new MatchedHit(i)));
+    }
+  };
+  auto addArena = [](edm::ArenaOwnVector<Hit>& v, unsigned int i) {
+    switch(i % 3) {
+    case 0: v.emplace_back<PixelHit>(i); break;
+    case 1: v.emplace_back<StripHit>(i); break;
+    default: v.emplace_back<MatchedHit>(i);
+    }
+  };
+
+  std::cout << std::fixed << std::setprecision(2)
+            << "elements: " << nElements << ", events: " << nEvents << "\n";
+  int rc = 0;
+  for(bool reserve : {true, false}) {
+    Result own = run<edm::OwnVector<Hit> >(nElements, nEvents, reserve, addOwn);
+    Result arena = run<edm::ArenaOwnVector<Hit> >(nElements, nEvents, reserve, addArena);
+    std::cout << (reserve ? "reserved and reused:\n" : "new collection per event, no reserve:\n");
+    print("  OwnVector     ", own, nEvents);
+    print("  ArenaOwnVector", arena, nEvents);
+    if(own.sum != arena.sum) {
+      std::cerr << "the two containers do not hold the same elements\n";
+      rc = 1;
+    }
+  }
+  return rc;
+}
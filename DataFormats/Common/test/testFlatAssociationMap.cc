@@ -0,0 +1,113 @@
+#include "cppunit/extensions/HelperMacros.h"
+#include "DataFormats/Common/interface/FlatAssociationMap.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/Common/test/SimpleEDProductGetter.h"
+#include <memory>
+#include <vector>
+
+class testFlatAssociationMap : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testFlatAssociationMap);
+  CPPUNIT_TEST(checkOneToOne);
+  CPPUNIT_TEST(checkOneToMany);
+  CPPUNIT_TEST(checkOneToValue);
+  CPPUNIT_TEST(checkValueMapLookups);
+  CPPUNIT_TEST_SUITE_END();
+public:
+  typedef std::vector<int> CKey;
+  typedef std::vector<double> CVal;
+
+  void setUp() {
+    getter_ = std::make_unique<SimpleEDProductGetter>();
+    getter_->addProduct(keyID_, std::make_unique<CKey>(10, 1));
+    getter_->addProduct(valID_, std::make_unique<CVal>(10, 2.));
+  }
+  void tearDown() { getter_.reset(); }
+  void checkOneToOne();
+  void checkOneToMany();
+  void checkOneToValue();
+  void checkValueMapLookups();
+
+private:
+  edm::Ref<CKey> key(unsigned int i) const { return edm::Ref<CKey>(keyID_, i, getter_.get()); }
+  edm::Ref<CVal> val(unsigned int i) const { return edm::Ref<CVal>(valID_, i, getter_.get()); }
+  edm::RefProd<CKey> keys() const { return edm::RefProd<CKey>(keyID_, getter_.get()); }
+  edm::RefProd<CVal> vals() const { return edm::RefProd<CVal>(valID_, getter_.get()); }
+
+  edm::ProductID const keyID_{1, 1};
+  edm::ProductID const valID_{1, 2};
+  std::unique_ptr<SimpleEDProductGetter> getter_;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testFlatAssociationMap);
+
+void testFlatAssociationMap::checkOneToOne() {
+  typedef edm::AssociationMap<edm::OneToOne<CKey, CVal> > Assoc;
+  edm::FlatAssociationMap<edm::OneToOne<CKey, CVal> > empty;
+  CPPUNIT_ASSERT(empty.empty());
+  CPPUNIT_ASSERT(empty.numberOfAssociations(key(0)) == 0);
+
+  Assoc v(keys(), vals());
+  v.insert(key(3), val(5));
+  v.insert(key(7), val(1));
+  auto f = edm::makeFlatAssociationMap(v);
+  CPPUNIT_ASSERT(f.size() == 2);
+  CPPUNIT_ASSERT(f[key(3)] == v[key(3)]);
+  CPPUNIT_ASSERT(f[key(7)].key() == 1);
+  CPPUNIT_ASSERT(f.contains(key(3)));
+  CPPUNIT_ASSERT(!f.contains(key(4)));
+  CPPUNIT_ASSERT(f.numberOfAssociations(key(9)) == 0);
+  CPPUNIT_ASSERT(f.associationsEnd(key(3)) - f.associationsBegin(key(3)) == 1);
+  CPPUNIT_ASSERT(*f.associationsBegin(key(3)) == 5);
+  CPPUNIT_ASSERT_THROW(f[key(4)], edm::Exception);
+  CPPUNIT_ASSERT_THROW(f[key(9)], edm::Exception);
+}
+
+void testFlatAssociationMap::checkOneToMany() {
+  typedef edm::AssociationMap<edm::OneToMany<CKey, CVal> > Assoc;
+  Assoc v(keys(), vals());
+  v.insert(key(0), val(5));
+  v.insert(key(0), val(6));
+  v.insert(key(2), val(1));
+  auto f = edm::makeFlatAssociationMap(v);
+  CPPUNIT_ASSERT(f.size() == 2);
+  CPPUNIT_ASSERT(f.numberOfAssociations(key(0)) == 2);
+  CPPUNIT_ASSERT(f.numberOfAssociations(key(1)) == 0);
+  CPPUNIT_ASSERT(f.numberOfAssociations(key(2)) == 1);
+  edm::RefVector<CVal> r = f[key(0)];
+  CPPUNIT_ASSERT(r.size() == 2);
+  CPPUNIT_ASSERT(r[0].key() == 5);
+  CPPUNIT_ASSERT(r[1].key() == 6);
+  CPPUNIT_ASSERT(f[key(2)][0].key() == 1);
+  CPPUNIT_ASSERT_THROW(f[key(1)], edm::Exception);
+}
+
+void testFlatAssociationMap::checkOneToValue() {
+  typedef edm::AssociationMap<edm::OneToValue<CKey, float> > Assoc;
+  Assoc v(keys());
+  v.insert(key(4), 3.5f);
+  v.insert(key(6), -1.f);
+  auto f = edm::makeFlatAssociationMap(v);
+  CPPUNIT_ASSERT(f.size() == 2);
+  CPPUNIT_ASSERT(f[key(4)] == 3.5f);
+  CPPUNIT_ASSERT(f[key(6)] == -1.f);
+  CPPUNIT_ASSERT(f.numberOfAssociations(key(5)) == 0);
+}
+
+void testFlatAssociationMap::checkValueMapLookups() {
+  edm::ValueMap<int> v;
+  edm::ValueMap<int>::Filler filler(v);
+  std::vector<int> a(10, 1), b(10, 2);
+  filler.insert(keys(), a.begin(), a.end());
+  filler.insert(vals(), b.begin(), b.end());
+  filler.fill();
+  //alternate between the products, then repeat the same one
+  CPPUNIT_ASSERT(v.get(valID_, 1) == 2);
+  CPPUNIT_ASSERT(v.get(keyID_, 2) == 1);
+  CPPUNIT_ASSERT(v.get(keyID_, 3) == 1);
+  CPPUNIT_ASSERT(v[val(0)] == 2);
+  CPPUNIT_ASSERT(!v.contains(edm::ProductID(1, 3)));
+  CPPUNIT_ASSERT(v.contains(keyID_));
+  edm::ValueMap<int> copy(v);
+  CPPUNIT_ASSERT(copy.get(valID_, 9) == 2);
+  CPPUNIT_ASSERT(copy.get(keyID_, 9) == 1);
+}
@@ -80,6 +80,30 @@ void testValueMapNew::checkAll() {
     filler2.fill();
     edm::ValueMap<int> values = values1 + values2;
     test(values);
+  } {
+    // moves, after lookups have set the hint of the last product found
+    edm::ValueMap<int> values;
+    edm::ValueMap<int>::Filler filler(values);
+    filler.insert(handleK1, w1.begin(), w1.end());
+    filler.insert(handleK2, w2.begin(), w2.end());
+    filler.fill();
+    test(values);
+    edm::ValueMap<int> moved(std::move(values));
+    test(moved);
+    CPPUNIT_ASSERT(values.idSize()==0);
+    CPPUNIT_ASSERT(!values.contains(ProductID(1, 3)));
+    edm::ValueMap<int> values1;
+    edm::ValueMap<int>::Filler filler1(values1);
+    filler1.insert(handleK1, w1.begin(), w1.end());
+    filler1.fill();
+    moved = std::move(values1);
+    CPPUNIT_ASSERT(moved.idSize()==1);
+    CPPUNIT_ASSERT(moved.contains(ProductID(1, 2)));
+    CPPUNIT_ASSERT(!moved.contains(ProductID(1, 3)));
+    CPPUNIT_ASSERT(moved.get(ProductID(1, 2), 3)==w1[3]);
+    values = std::move(moved);
+    CPPUNIT_ASSERT(values.idSize()==1);
+    CPPUNIT_ASSERT(values.get(ProductID(1, 2), 3)==w1[3]);
   }
 }
 
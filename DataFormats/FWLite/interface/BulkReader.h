@@ -0,0 +1,165 @@
+#ifndef DataFormats_FWLite_BulkReader_h
+#define DataFormats_FWLite_BulkReader_h
+// -*- C++ -*-
+//
+// Package:     DataFormats/FWLite
+// Class  :     BulkReader
+//
+/**\class BulkReader BulkReader.h DataFormats/FWLite/interface/BulkReader.h
+
+   Description: Fast loop over the events of a fwlite::Event reading a fixed set of products
+
+   Usage:
+   The products to be read are bound once, before the loop, which finds their
+ branches.  In the loop, getting the product of the current event is then a
+ check of the entry already read, instead of the string based lookup done by
+ every getByLabel.  Each product is read into the same buffer for every event.
+
+   The events are read in batches: at the start of each batch the TTreeCache
+ of the file is set to hold only the branches bound (and the event auxiliary)
+ for the entries of the batch, so the baskets of all the bound products for
+ the whole batch are fetched from the file in one vectored read.
+ \code
+ TFile f("foo.root");
+ fwlite::Event ev(&f);
+ fwlite::BulkReader reader(ev, 1000);
+ auto muons = reader.bind<std::vector<pat::Muon> >("slimmedMuons");
+ auto jets = reader.bind<std::vector<pat::Jet> >(edm::InputTag("slimmedJets"));
+ for(fwlite::Event const& event : reader) {
+    for(auto const& muon : *muons) {
+       ...
+    }
+ }
+ \endcode
+   A product which is not in the file gives a BoundProduct which is not bound,
+ and one which is missing in some events is not valid for those events; using
+ it then throws, as fwlite::Handle does.
+
+   The reader, and the BoundProducts, must not outlive the fwlite::Event, and
+ the event should only be moved by the reader while the loop runs.  This only
+ works on a single file, not on a ChainEvent.
+*/
+//
+// system include files
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "Rtypes.h"
+
+// user include files
+#include "DataFormats/Common/interface/Wrapper.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+// forward declarations
+namespace fwlite {
+   class Event;
+   namespace internal {
+      struct Data;
+   }
+
+   class BulkReader {
+
+      public:
+         // NOTE: Does NOT take ownership so iEvent must remain around
+         // at least as long as BulkReader
+         BulkReader(Event& iEvent, Long64_t iBatchSize = 100);
+
+         template<class T>
+         class BoundProduct {
+            public:
+               BoundProduct() : event_(nullptr), data_(nullptr) {}
+
+               ///true if the product has a branch in the file
+               bool isBound() const { return data_ != nullptr; }
+
+               ///true if the product is in the current event
+               bool isValid() const {
+                  return data_ != nullptr && wrapper()->product() != nullptr;
+               }
+
+               T const* product() const {
+                  T const* p = data_ != nullptr ? wrapper()->product() : nullptr;
+                  if(nullptr == p) {
+                     BulkReader::throwProductNotFound(typeid(edm::Wrapper<T>), data_ != nullptr, tag_);
+                  }
+                  return p;
+               }
+               T const* operator->() const { return product(); }
+               T const& operator*() const { return *product(); }
+
+               edm::InputTag const& inputTag() const { return tag_; }
+
+            private:
+               friend class BulkReader;
+               BoundProduct(Event const* iEvent, internal::Data* iData, edm::InputTag const& iTag) :
+                  event_(iEvent), data_(iData), tag_(iTag) {}
+
+               edm::Wrapper<T> const* wrapper() const {
+                  return static_cast<edm::Wrapper<T> const*>(BulkReader::read(*event_, *data_));
+               }
+
+               Event const* event_;
+               internal::Data* data_;
+               edm::InputTag tag_;
+         };
+
+         class const_iterator {
+            public:
+               Event const& operator*() const { return *reader_->event_; }
+               Event const* operator->() const { return reader_->event_; }
+               const_iterator& operator++() { reader_->next(entry_); return *this; }
+               bool operator==(const_iterator const& iOther) const { return entry_ == iOther.entry_; }
+               bool operator!=(const_iterator const& iOther) const { return entry_ != iOther.entry_; }
+               Long64_t entry() const { return entry_; }
+
+            private:
+               friend class BulkReader;
+               const_iterator(BulkReader* iReader, Long64_t iEntry) : reader_(iReader), entry_(iEntry) {}
+
+               BulkReader* reader_;
+               Long64_t entry_;
+         };
+
+         // ---------- const member functions ---------------------
+         Long64_t batchSize() const { return batchSize_; }
+
+         // ---------- member functions ---------------------------
+         ///Finds the branch of the product, the process name may be left empty
+         template<class T>
+         BoundProduct<T> bind(char const* iModuleLabel,
+                              char const* iProductInstanceLabel = nullptr,
+                              char const* iProcessLabel = nullptr) {
+            edm::InputTag tag(iModuleLabel,
+                              nullptr != iProductInstanceLabel ? iProductInstanceLabel : "",
+                              nullptr != iProcessLabel ? iProcessLabel : "");
+            return BoundProduct<T>(event_, bindData(typeid(edm::Wrapper<T>), tag), tag);
+         }
+         template<class T>
+         BoundProduct<T> bind(edm::InputTag const& iTag) {
+            return BoundProduct<T>(event_, bindData(typeid(edm::Wrapper<T>), iTag), iTag);
+         }
+
+         ///Goes to the first event and starts the first batch
+         const_iterator begin();
+         const_iterator end();
+
+      private:
+         BulkReader(BulkReader const&); // stop default
+         BulkReader const& operator=(BulkReader const&); // stop default
+
+         internal::Data* bindData(std::type_info const&, edm::InputTag const&);
+         void next(Long64_t& ioEntry);
+         void startBatch(Long64_t iEntry);
+
+         static void const* read(Event const&, internal::Data&);
+         [[noreturn]] static void throwProductNotFound(std::type_info const&, bool iBound, edm::InputTag const&);
+
+         // ---------- member data --------------------------------
+         Event* event_;
+         Long64_t batchSize_;
+         Long64_t batchEnd_;
+         std::vector<internal::Data*> bound_;
+   };
+}
+#endif
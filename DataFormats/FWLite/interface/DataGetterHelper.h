@@ -36,6 +36,7 @@
 #include <vector>
 
 // forward declarations
+class TBranch;
 class TTreeCache;
 class TTree;
 
@@ -76,6 +77,13 @@ namespace fwlite {
                                     std::vector<unsigned int>& keys,
                                     Long_t eventEntry) const;
 
+            // Finds once the data of a product, nullptr if it has no branch, see fwlite::BulkReader
+            internal::Data* bindData(std::type_info const&, char const*, char const*, char const*) const;
+            // The address of the product of a bound data for this entry
+            void const* getBoundData(internal::Data&, Long_t eventEntry) const;
+            // Sets the TTreeCache to hold only these branches for the entries [iFirst, iLast)
+            void cacheBranches(std::vector<TBranch*> const&, Long64_t iFirst, Long64_t iLast) const;
+
             // ---------- static member functions --------------------
 
             // ---------- member functions ---------------------------
@@ -165,6 +165,7 @@ namespace fwlite {
          friend class internal::ProductGetter;
          friend class ChainEvent;
          friend class EventHistoryGetter;
+         friend class BulkReader;
 
          Event(Event const&); // stop default
 
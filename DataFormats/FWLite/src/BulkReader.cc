@@ -0,0 +1,107 @@
+// -*- C++ -*-
+//
+// Package:     DataFormats/FWLite
+// Class  :     BulkReader
+//
+
+// system include files
+#include <algorithm>
+
+// user include files
+#include "DataFormats/FWLite/interface/BulkReader.h"
+#include "DataFormats/FWLite/interface/Event.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "FWCore/Utilities/interface/TypeID.h"
+#include "FWCore/Utilities/interface/get_underlying_safe.h"
+
+namespace fwlite {
+   //
+   // constructors and destructor
+   //
+   BulkReader::BulkReader(Event& iEvent, Long64_t iBatchSize) :
+      event_(&iEvent),
+      batchSize_(iBatchSize > 0 ? iBatchSize : 1),
+      batchEnd_(0),
+      bound_() {
+   }
+
+   //
+   // member functions
+   //
+   internal::Data*
+   BulkReader::bindData(std::type_info const& iInfo, edm::InputTag const& iTag) {
+      internal::Data* data = event_->dataHelper_.bindData(iInfo,
+                                                          iTag.label().c_str(),
+                                                          iTag.instance().c_str(),
+                                                          iTag.process().c_str());
+      if(nullptr != data && bound_.end() == std::find(bound_.begin(), bound_.end(), data)) {
+         bound_.push_back(data);
+         //the next batch caches the new branch
+         batchEnd_ = 0;
+      }
+      return data;
+   }
+
+   BulkReader::const_iterator
+   BulkReader::begin() {
+      event_->toBegin();
+      if(event_->atEnd()) {
+         return end();
+      }
+      startBatch(0);
+      return const_iterator(this, 0);
+   }
+
+   BulkReader::const_iterator
+   BulkReader::end() {
+      return const_iterator(this, event_->size());
+   }
+
+   void
+   BulkReader::next(Long64_t& ioEntry) {
+      ++ioEntry;
+      if(ioEntry >= event_->size()) {
+         ioEntry = event_->size();
+         ++(*event_);
+         return;
+      }
+      if(ioEntry >= batchEnd_) {
+         startBatch(ioEntry);
+      }
+      event_->to(ioEntry);
+   }
+
+   void
+   BulkReader::startBatch(Long64_t iEntry) {
+      batchEnd_ = std::min(iEntry + batchSize_, event_->size());
+      std::vector<TBranch*> branches;
+      branches.reserve(bound_.size() + 1);
+      branches.push_back(event_->auxBranch_);
+      for(auto data : bound_) {
+         branches.push_back(edm::get_underlying_safe(data->branch_));
+      }
+      event_->dataHelper_.cacheBranches(branches, iEntry, batchEnd_);
+   }
+
+   //
+   // static member functions
+   //
+   void const*
+   BulkReader::read(Event const& iEvent, internal::Data& iData) {
+      if(iEvent.atEnd()) {
+         throw cms::Exception("OffEnd") << "You have requested data past the last event";
+      }
+      return iEvent.dataHelper_.getBoundData(iData, iEvent.branchMap_.getEventEntry());
+   }
+
+   void
+   BulkReader::throwProductNotFound(std::type_info const& iType, bool iBound, edm::InputTag const& iTag) {
+      if(iBound) {
+         Event::throwProductNotFoundException(iType, iTag.label().c_str(), iTag.instance().c_str(), iTag.process().c_str());
+      }
+      edm::TypeID type(iType);
+      throw edm::Exception(edm::errors::ProductNotFound) << "No branch was found for \n  type ='" << type.className()
+         << "'\n  module='" << iTag.label() << "'\n  productInstance='" << iTag.instance()
+         << "'\n  process='" << iTag.process() << "'\n";
+   }
+}
@@ -309,6 +309,49 @@ namespace fwlite {
         else return true;
     }
 
+    internal::Data*
+    DataGetterHelper::bindData(std::type_info const& iInfo,
+                    char const* iModuleLabel,
+                    char const* iProductInstanceLabel,
+                    char const* iProcessLabel) const
+    {
+        internal::Data& theData =
+            DataGetterHelper::getBranchDataFor(iInfo, iModuleLabel, iProductInstanceLabel, iProcessLabel);
+
+        if (nullptr == theData.branch_) {
+            return nullptr;
+        }
+        return &theData;
+    }
+
+    void const*
+    DataGetterHelper::getBoundData(internal::Data& iData, Long_t eventEntry) const
+    {
+        if(eventEntry != iData.lastProduct_) {
+            //haven't gotten the data for this event
+            getBranchData(getter_.get(), eventEntry, iData);
+        }
+        return iData.obj_.address();
+    }
+
+    void
+    DataGetterHelper::cacheBranches(std::vector<TBranch*> const& iBranches, Long64_t iFirst, Long64_t iLast) const
+    {
+        TTreeCache* tcache = dynamic_cast<TTreeCache*> (branchMap_->getFile()->GetCacheRead());
+        if (nullptr == tcache) {
+            //without a cache each branch reads its own baskets
+            return;
+        }
+        //no learning phase: the branches to be read are known
+        tree_->DropBranchFromCache("*", kTRUE);
+        for(auto branch : iBranches) {
+            tree_->AddBranchToCache(branch, kTRUE);
+        }
+        tree_->StopCacheLearningPhase();
+        tree_->SetCacheEntryRange(iFirst, iLast);
+        tcTrained_ = true;
+    }
+
     bool
     DataGetterHelper::getByBranchDescription(edm::BranchDescription const& bDesc,
                                              Long_t eventEntry,
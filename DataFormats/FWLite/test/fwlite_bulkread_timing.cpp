@@ -0,0 +1,131 @@
+// Times an FWLite loop reading the main collections of a MiniAOD file,
+// once with a fwlite::Handle getByLabel per product and per event, and
+// once with fwlite::BulkReader, which binds the products before the loop
+// and reads the events in batches.
+//
+//   fwlite_bulkread_timing <MiniAOD file> [batch size]
+//
+// Each loop opens the file anew; a later loop may profit from the file
+// already being in the page cache, so each loop is run twice, in the
+// order getByLabel, BulkReader, BulkReader, getByLabel.
+
+#include "DataFormats/FWLite/interface/BulkReader.h"
+#include "DataFormats/FWLite/interface/Event.h"
+#include "DataFormats/FWLite/interface/Handle.h"
+#include "DataFormats/PatCandidates/interface/Electron.h"
+#include "DataFormats/PatCandidates/interface/Jet.h"
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "FWCore/FWLite/interface/FWLiteEnabler.h"
+
+#include "TFile.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+  typedef std::chrono::steady_clock Clock;
+
+  double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+
+  struct Sums {
+    Sums() : nEvents(0), nObjects(0), pt(0.) {}
+    long nEvents;
+    long nObjects;
+    double pt;
+
+    template<typename C>
+    void add(C const& iCollection) {
+      nObjects += iCollection.size();
+      for(auto const& object : iCollection) {
+        pt += object.pt();
+      }
+    }
+  };
+
+  Sums loopWithHandles(char const* iFileName) {
+    Sums sums;
+    std::unique_ptr<TFile> file(TFile::Open(iFileName));
+    fwlite::Event event(file.get());
+    for(event.toBegin(); not event.atEnd(); ++event) {
+      fwlite::Handle<std::vector<pat::Muon> > muons;
+      muons.getByLabel(event, "slimmedMuons");
+      fwlite::Handle<std::vector<pat::Electron> > electrons;
+      electrons.getByLabel(event, "slimmedElectrons");
+      fwlite::Handle<std::vector<pat::Jet> > jets;
+      jets.getByLabel(event, "slimmedJets");
+      fwlite::Handle<std::vector<pat::PackedCandidate> > candidates;
+      candidates.getByLabel(event, "packedPFCandidates");
+      sums.add(*muons);
+      sums.add(*electrons);
+      sums.add(*jets);
+      sums.add(*candidates);
+      ++sums.nEvents;
+    }
+    return sums;
+  }
+
+  Sums loopWithBulkReader(char const* iFileName, Long64_t iBatchSize) {
+    Sums sums;
+    std::unique_ptr<TFile> file(TFile::Open(iFileName));
+    fwlite::Event event(file.get());
+    fwlite::BulkReader reader(event, iBatchSize);
+    auto muons = reader.bind<std::vector<pat::Muon> >("slimmedMuons");
+    auto electrons = reader.bind<std::vector<pat::Electron> >("slimmedElectrons");
+    auto jets = reader.bind<std::vector<pat::Jet> >("slimmedJets");
+    auto candidates = reader.bind<std::vector<pat::PackedCandidate> >("packedPFCandidates");
+    for(auto it = reader.begin(), itEnd = reader.end(); it != itEnd; ++it) {
+      sums.add(*muons);
+      sums.add(*electrons);
+      sums.add(*jets);
+      sums.add(*candidates);
+      ++sums.nEvents;
+    }
+    return sums;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  if(argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <MiniAOD file> [batch size]\n";
+    return 1;
+  }
+  char const* fileName = argv[1];
+  Long64_t const batchSize = argc > 2 ? std::atol(argv[2]) : 100;
+  FWLiteEnabler::enable();
+
+  Clock::time_point start = Clock::now();
+  Sums const handles1 = loopWithHandles(fileName);
+  double const tHandles1 = msSince(start);
+  start = Clock::now();
+  Sums const bulk1 = loopWithBulkReader(fileName, batchSize);
+  double const tBulk1 = msSince(start);
+  start = Clock::now();
+  Sums const bulk2 = loopWithBulkReader(fileName, batchSize);
+  double const tBulk2 = msSince(start);
+  start = Clock::now();
+  Sums const handles2 = loopWithHandles(fileName);
+  double const tHandles2 = msSince(start);
+
+  double const n = handles1.nEvents > 0 ? handles1.nEvents : 1;
+  std::cout << std::fixed << std::setprecision(3)
+            << "events:                 " << handles1.nEvents << "\n"
+            << "objects:                " << handles1.nObjects << "\n"
+            << "getByLabel:             " << tHandles1 / n << " ms/event\n"
+            << "BulkReader:             " << tBulk1 / n << " ms/event\n"
+            << "BulkReader again:       " << tBulk2 / n << " ms/event\n"
+            << "getByLabel again:       " << tHandles2 / n << " ms/event\n";
+  for(auto const* sums : {&bulk1, &bulk2, &handles2}) {
+    if(sums->nEvents != handles1.nEvents or sums->nObjects != handles1.nObjects or sums->pt != handles1.pt) {
+      std::cerr << "the loops read different products\n";
+      return 1;
+    }
+  }
+  return 0;
+}
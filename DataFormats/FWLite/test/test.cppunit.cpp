@@ -16,6 +16,7 @@ Test program for edm::Ref use in ROOT.
 #include "DataFormats/TestObjects/interface/TrackOfThings.h"
 #include "FWCore/Utilities/interface/TestHelper.h"
 
+#include "DataFormats/FWLite/interface/BulkReader.h"
 #include "DataFormats/FWLite/interface/ChainEvent.h"
 #include "DataFormats/FWLite/interface/EventBase.h"
 #include "DataFormats/FWLite/interface/MultiChainEvent.h"
@@ -45,6 +46,7 @@ class testRefInROOT: public CppUnit::TestFixture
    CPPUNIT_TEST(testEventBase);
    CPPUNIT_TEST(testSometimesMissingData);
    CPPUNIT_TEST(testTo);
+   CPPUNIT_TEST(testBulkReader);
    CPPUNIT_TEST(testThinning);
 
   // CPPUNIT_TEST_EXCEPTION(failChainWithMissingFile,std::exception);
@@ -77,6 +79,7 @@ public:
   void testEventBase();
   void testSometimesMissingData();
   void testTo();
+  void testBulkReader();
   // void failChainWithMissingFile();
   //void failDidNotCallGetEntryForEvents();
   void testThinning();
@@ -236,6 +239,38 @@ void testRefInROOT::testTo()
    
 }
 
+void testRefInROOT::testBulkReader()
+{
+   TFile file((tmpdir + "goodDataFormatsFWLite.root").c_str());
+   fwlite::Event events(&file);
+
+   // a batch smaller than the file, so the loop crosses batches
+   fwlite::BulkReader reader(events, 2);
+   auto things = reader.bind<edmtest::ThingCollection>("Thing");
+   auto others = reader.bind<edmtest::OtherThingCollection>(edm::InputTag("OtherThing","testUserTag"));
+   auto notHere = reader.bind<edmtest::OtherThingCollection>("NotHereOtherThing");
+   CPPUNIT_ASSERT(things.isBound());
+   CPPUNIT_ASSERT(others.isBound());
+   CPPUNIT_ASSERT(not notHere.isBound());
+
+   Long64_t nEvents = 0;
+   for(fwlite::Event const& event : reader) {
+      CPPUNIT_ASSERT(event.isValid());
+      CPPUNIT_ASSERT(things.isValid());
+      CPPUNIT_ASSERT(not notHere.isValid());
+      CPPUNIT_ASSERT_THROW(notHere.product(), cms::Exception);
+
+      fwlite::Handle<edmtest::ThingCollection> pThings;
+      pThings.getByLabel(event,"Thing");
+      CPPUNIT_ASSERT(pThings.ptr() == things.product());
+      CPPUNIT_ASSERT(things->size() == pThings->size());
+      checkMatch(others.product(), things.product());
+      ++nEvents;
+   }
+   CPPUNIT_ASSERT(nEvents == events.size());
+   CPPUNIT_ASSERT(events.atEnd());
+   CPPUNIT_ASSERT_THROW(things.product(), cms::Exception);
+}
 
 void testRefInROOT::testRefFirst()
 {
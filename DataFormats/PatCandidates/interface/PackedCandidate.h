@@ -2,6 +2,7 @@
 #define __DataFormats_PatCandidates_PackedCandidate_h__
 
 #include <atomic>
+#include <limits>
 #include "DataFormats/Candidate/interface/Candidate.h"
 #include "DataFormats/Candidate/interface/CandidateFwd.h"
 #include "DataFormats/Common/interface/RefVector.h"
@@ -584,6 +585,18 @@ namespace pat {
 
   protected:
     friend class ::testPackedCandidate;
+    friend class PackedCandidateColumns;
+
+    /// decoding of the packed quantities, shared by the lazy unpacking of
+    /// each candidate and the collection-wide PackedCandidateColumns
+    static float unpackEta(uint16_t packedEta) { return int16_t(packedEta)*6.0f/std::numeric_limits<int16_t>::max(); }
+    static double unpackPhi(uint16_t packedPhi, float pt) {
+      double shift = (pt<1. ? 0.1*pt : 0.1/pt); // shift particle phi to break degeneracies in angular separations
+      double sign = ( ( int(pt*10) % 2 == 0 ) ? 1 : -1 ); // introduce a pseudo-random sign of the shift
+      return int16_t(packedPhi)*3.2f/std::numeric_limits<int16_t>::max() + sign*shift*3.2/std::numeric_limits<int16_t>::max();
+    }
+    static float unpackDPhi(uint16_t packedDPhi) { return int16_t(packedDPhi)*3.2f/std::numeric_limits<int16_t>::max(); }
+    static float unpackDzNoPV(uint16_t packedDz) { return int16_t(packedDz)*40.f/std::numeric_limits<int16_t>::max(); }
 
     uint16_t packedPt_, packedEta_, packedPhi_, packedM_;
     uint16_t packedDxy_, packedDz_, packedDPhi_;
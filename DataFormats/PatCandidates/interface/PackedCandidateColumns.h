@@ -0,0 +1,63 @@
+#ifndef __DataFormats_PatCandidates_PackedCandidateColumns_h__
+#define __DataFormats_PatCandidates_PackedCandidateColumns_h__
+
+#include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+
+#include <vector>
+
+namespace pat {
+
+  /// Read-only structure-of-arrays view of a whole PackedCandidateCollection.
+  ///
+  /// The packed words of all candidates are gathered first and then decoded
+  /// one quantity at a time in plain loops over contiguous arrays, instead of
+  /// unpacking (and heap-allocating the four-vector and vertex of) each
+  /// candidate on first access.  Kinematics use the same decoding as
+  /// PackedCandidate, so pt, eta, mass are identical and phi, dxy, dz and
+  /// the vertex agree to float precision; the per-candidate interface is
+  /// unchanged and does not share state with this view.
+  class PackedCandidateColumns {
+  public:
+    /// decodes all candidates; the vertex columns are filled only if withVertex,
+    /// as they need the primary vertex collection to be readable
+    explicit PackedCandidateColumns(const PackedCandidateCollection & cands, bool withVertex = true);
+
+    size_t size() const { return pt_.size(); }
+    bool hasVertex() const { return hasVertex_; }
+
+    const std::vector<float> & pt() const { return pt_; }
+    const std::vector<float> & eta() const { return eta_; }
+    const std::vector<float> & phi() const { return phi_; }
+    const std::vector<float> & mass() const { return mass_; }
+    const std::vector<float> & px() const { return px_; }
+    const std::vector<float> & py() const { return py_; }
+    const std::vector<float> & pz() const { return pz_; }
+    const std::vector<float> & energy() const { return energy_; }
+    const std::vector<int> & pdgId() const { return pdgId_; }
+    const std::vector<int> & charge() const { return charge_; }
+    const std::vector<float> & puppiWeight() const { return puppiWeight_; }
+    /// only filled if constructed withVertex; dz is dzAssociatedPV()
+    const std::vector<float> & dxy() const { return dxy_; }
+    const std::vector<float> & dz() const { return dz_; }
+    const std::vector<float> & vx() const { return vx_; }
+    const std::vector<float> & vy() const { return vy_; }
+    const std::vector<float> & vz() const { return vz_; }
+
+  private:
+    void unpackVertex(const PackedCandidateCollection & cands,
+                      const std::vector<uint16_t> & packedDxy,
+                      const std::vector<uint16_t> & packedDz,
+                      const std::vector<uint16_t> & packedDPhi,
+                      const std::vector<double> & phi);
+
+    std::vector<float> pt_, eta_, phi_, mass_;
+    std::vector<float> px_, py_, pz_, energy_;
+    std::vector<int> pdgId_, charge_;
+    std::vector<float> puppiWeight_;
+    std::vector<float> dxy_, dz_, vx_, vy_, vz_;
+    bool hasVertex_;
+  };
+
+}
+
+#endif
@@ -0,0 +1,126 @@
+#include "DataFormats/PatCandidates/interface/PackedCandidateColumns.h"
+#include "DataFormats/PatCandidates/interface/libminifloat.h"
+#include "DataFormats/PatCandidates/interface/liblogintpack.h"
+
+#include <cmath>
+
+using namespace logintpack;
+
+pat::PackedCandidateColumns::PackedCandidateColumns(const PackedCandidateCollection & cands, bool withVertex) :
+    hasVertex_(withVertex) {
+    const size_t n = cands.size();
+
+    // gather the packed words, so that every loop below runs over contiguous arrays
+    std::vector<uint16_t> packedPt(n), packedEta(n), packedPhi(n), packedM(n);
+    std::vector<uint16_t> packedDxy, packedDz, packedDPhi;
+    std::vector<uint8_t> packedPuppi(n);
+    pdgId_.resize(n);
+    charge_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const PackedCandidate & c = cands[i];
+        packedPt[i] = c.packedPt_;
+        packedEta[i] = c.packedEta_;
+        packedPhi[i] = c.packedPhi_;
+        packedM[i] = c.packedM_;
+        packedPuppi[i] = uint8_t(c.packedPuppiweight_);
+        pdgId_[i] = c.pdgId_;
+        charge_[i] = c.PackedCandidate::charge();
+    }
+
+    pt_.resize(n);
+    mass_.resize(n);
+    MiniFloatConverter::float16to32(packedPt.data(), pt_.data(), n);
+    MiniFloatConverter::float16to32(packedM.data(), mass_.data(), n);
+
+    eta_.resize(n);
+    for (size_t i = 0; i < n; ++i) eta_[i] = PackedCandidate::unpackEta(packedEta[i]);
+
+    // phi is kept in double for the vertex, and brought into (-pi,pi] as
+    // PolarLorentzVector does
+    std::vector<double> phi(n);
+    for (size_t i = 0; i < n; ++i) {
+        double p = PackedCandidate::unpackPhi(packedPhi[i], pt_[i]);
+        if (p <= -M_PI || p > M_PI) p -= std::floor(p/(2*M_PI) + .5)*2*M_PI;
+        phi[i] = p;
+    }
+    phi_.assign(phi.begin(), phi.end());
+
+    px_.resize(n);
+    py_.resize(n);
+    pz_.resize(n);
+    energy_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const float pt = pt_[i], m = mass_[i];
+        px_[i] = pt*std::cos(phi_[i]);
+        py_[i] = pt*std::sin(phi_[i]);
+        pz_[i] = pt*std::sinh(eta_[i]);
+        energy_[i] = std::sqrt(pt*pt + pz_[i]*pz_[i] + m*m);
+    }
+
+    // 256 possible packed weights: decode them once and look them up
+    float puppiTable[256];
+    for (int code = 0; code < 256; ++code) {
+        puppiTable[code] = unpack8logClosed(int8_t(code),-2,0,64)/2. + 0.5;
+    }
+    puppiWeight_.resize(n);
+    for (size_t i = 0; i < n; ++i) puppiWeight_[i] = puppiTable[packedPuppi[i]];
+
+    if (withVertex) {
+        packedDxy.resize(n);
+        packedDz.resize(n);
+        packedDPhi.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            packedDxy[i] = cands[i].packedDxy_;
+            packedDz[i] = cands[i].packedDz_;
+            packedDPhi[i] = cands[i].packedDPhi_;
+        }
+        unpackVertex(cands, packedDxy, packedDz, packedDPhi, phi);
+    }
+}
+
+void pat::PackedCandidateColumns::unpackVertex(const PackedCandidateCollection & cands,
+                                               const std::vector<uint16_t> & packedDxy,
+                                               const std::vector<uint16_t> & packedDz,
+                                               const std::vector<uint16_t> & packedDPhi,
+                                               const std::vector<double> & phi) {
+    const size_t n = cands.size();
+
+    dxy_.resize(n);
+    MiniFloatConverter::float16to32(packedDxy.data(), dxy_.data(), n);
+    for (size_t i = 0; i < n; ++i) dxy_[i] = dxy_[i]/100.;
+
+    // the primary vertex positions: the candidates of a collection normally
+    // all point into the same vertex collection, resolved only once
+    std::vector<PackedCandidate::Point> pv(n);
+    std::vector<bool> hasPV(n);
+    const reco::VertexCollection * vertices = nullptr;
+    edm::ProductID verticesId;
+    for (size_t i = 0; i < n; ++i) {
+        const PackedCandidate & c = cands[i];
+        hasPV[i] = c.pvRefKey_ != reco::VertexRef::invalidKey();
+        if (!hasPV[i]) continue;
+        if (vertices == nullptr || c.pvRefProd_.id() != verticesId) {
+            vertices = c.pvRefProd_.product();
+            verticesId = c.pvRefProd_.id();
+        }
+        pv[i] = (*vertices)[c.pvRefKey_].position();
+    }
+
+    std::vector<float> dzPV(n);
+    dz_.resize(n);
+    MiniFloatConverter::float16to32(packedDz.data(), dzPV.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        dz_[i] = hasPV[i] ? dzPV[i]/100. : PackedCandidate::unpackDzNoPV(packedDz[i]);
+    }
+
+    vx_.resize(n);
+    vy_.resize(n);
+    vz_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const float phiAtVtx = phi[i] + PackedCandidate::unpackDPhi(packedDPhi[i]);
+        const float s = std::sin(phiAtVtx), c = std::cos(phiAtVtx);
+        vx_[i] = pv[i].X() - dxy_[i] * s;
+        vy_[i] = pv[i].Y() + dxy_[i] * c;
+        vz_[i] = pv[i].Z() + dz_[i];
+    }
+}
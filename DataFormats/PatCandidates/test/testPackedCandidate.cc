@@ -5,6 +5,7 @@
 #include <iomanip>
 
 #include "DataFormats/PatCandidates/interface/PackedCandidate.h"
+#include "DataFormats/PatCandidates/interface/PackedCandidateColumns.h"
 
 class testPackedCandidate : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(testPackedCandidate);
@@ -13,6 +14,7 @@ class testPackedCandidate : public CppUnit::TestFixture {
   CPPUNIT_TEST(testCopyConstructor);
   CPPUNIT_TEST(testPackUnpack);
   CPPUNIT_TEST(testSimulateReadFromRoot);
+  CPPUNIT_TEST(testColumns);
 
   CPPUNIT_TEST_SUITE_END();
 public:
@@ -23,6 +25,7 @@ public:
   void testCopyConstructor();
   void testPackUnpack();
   void testSimulateReadFromRoot();
+  void testColumns();
 
 
 private:
@@ -134,3 +137,44 @@ void testPackedCandidate::testSimulateReadFromRoot() {
   
 }
 
+void testPackedCandidate::testColumns() {
+
+  pat::PackedCandidateCollection cands;
+  for (int i = 0; i < 200; ++i) {
+    double pt = 0.05 + 0.37*i, eta = -4.5 + 0.045*i, phi = -3.14159 + 0.0314*i;
+    pat::PackedCandidate::PolarLorentzVector plv(pt, eta, phi, (i%3)*0.13957);
+    pat::PackedCandidate::Point v(0.001*(i%7), -0.002*(i%5), 0.5*(i%11) - 2.);
+    int pdgId = (i%4 == 0) ? 22 : ((i%2) ? 211 : -11);
+    cands.emplace_back(plv, v, phi + 0.01, pdgId, reco::VertexRefProd(), reco::VertexRef().key());
+    cands.back().setPuppiWeight(0.005*i, 0.004*i);
+  }
+  // as read back from a file
+  for (auto & pc : cands) {
+    delete pc.p4_.exchange(nullptr);
+    delete pc.p4c_.exchange(nullptr);
+    delete pc.vertex_.exchange(nullptr);
+  }
+
+  pat::PackedCandidateColumns columns(cands);
+  CPPUNIT_ASSERT(columns.size() == cands.size());
+  CPPUNIT_ASSERT(columns.hasVertex());
+  for (size_t i = 0; i < cands.size(); ++i) {
+    const pat::PackedCandidate & pc = cands[i];
+    CPPUNIT_ASSERT(columns.pt()[i] == float(pc.pt()));
+    CPPUNIT_ASSERT(columns.eta()[i] == float(pc.eta()));
+    CPPUNIT_ASSERT(columns.phi()[i] == float(pc.phi()));
+    CPPUNIT_ASSERT(columns.mass()[i] == float(pc.mass()));
+    CPPUNIT_ASSERT(columns.pdgId()[i] == pc.pdgId());
+    CPPUNIT_ASSERT(columns.charge()[i] == pc.charge());
+    CPPUNIT_ASSERT(columns.puppiWeight()[i] == pc.puppiWeight());
+    CPPUNIT_ASSERT(columns.dxy()[i] == pc.dxy());
+    CPPUNIT_ASSERT(columns.dz()[i] == pc.dzAssociatedPV());
+    CPPUNIT_ASSERT(columns.vx()[i] == float(pc.vertex().X()));
+    CPPUNIT_ASSERT(columns.vy()[i] == float(pc.vertex().Y()));
+    CPPUNIT_ASSERT(columns.vz()[i] == float(pc.vertex().Z()));
+    CPPUNIT_ASSERT(tolerance(columns.px()[i], pc.px(), 1.e-5) || std::abs(pc.px()) < 1.e-5);
+    CPPUNIT_ASSERT(tolerance(columns.py()[i], pc.py(), 1.e-5) || std::abs(pc.py()) < 1.e-5);
+    CPPUNIT_ASSERT(tolerance(columns.pz()[i], pc.pz(), 1.e-5) || std::abs(pc.pz()) < 1.e-5);
+    CPPUNIT_ASSERT(tolerance(columns.energy()[i], pc.energy(), 1.e-5));
+  }
+}
@@ -18,6 +18,7 @@
 
 class DDCompactViewImpl;
 class DDDivision;
+class DDSpecParIndex;
 class DDName;
 class DDPartSelector;
 class DDPhysicalPart;
@@ -159,10 +160,14 @@ public:
   void swap( DDCompactView& );
 
   void lockdown();
+
+  //! index of the attached SpecPars, built by lockdown(); 0 before
+  const DDSpecParIndex * specParIndex() const { return specParIndex_.get(); }
   
  private:
   std::unique_ptr<DDCompactViewImpl> rep_;
   std::unique_ptr<DDPosData> worldpos_ ;
+  std::unique_ptr<DDSpecParIndex> specParIndex_;
   
     // 2010-01-27 memory patch
     // for copying and protecting DD Store's after parsing is complete.
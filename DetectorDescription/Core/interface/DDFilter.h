@@ -1,6 +1,7 @@
 #ifndef DDCore_DDFilter_h
 #define DDCore_DDFilter_h
 
+#include <stddef.h>
 #include <iosfwd>
 #include <vector>
 
@@ -8,6 +9,7 @@
 
 class DDExpandedView;
 class DDQuery;
+class DDSpecParIndex;
 
 //! comparison operators to be used with this filter
 enum class DDCompOp { equals, matches, not_equals, not_matches, smaller, bigger, smaller_equals, bigger_equals };
@@ -27,6 +29,12 @@ public:
   
   //! true, if the DDExpandedNode fulfills the filter criteria
   virtual bool accept(const DDExpandedView &) const = 0;  
+
+  //! compact-view nodes outside of which accept() is always false
+  /** Appends to nodes the DDCompactView::graph() indices of all logical parts
+      which may be accepted and returns true; returns false if no such
+      restriction is known, which is the default. */
+  virtual bool candidates(const DDSpecParIndex &, std::vector<size_t> & nodes) const;
 };
 
 //! The DDGenericFilter is a runtime-parametrized Filter looking on DDSpecifcs
@@ -40,6 +48,8 @@ public:
   ~DDSpecificsFilter();
   
   bool accept(const DDExpandedView &) const; 
+
+  bool candidates(const DDSpecParIndex &, std::vector<size_t> & nodes) const;
 	      
   void setCriteria(const DDValue & nameVal, // name & value of a variable 
                    DDCompOp, 
@@ -14,6 +14,7 @@
 class DDCompactView;
 class DDLogicalPart;
 class DDScope;
+class DDSpecParIndex;
 
 class DDFilteredView
 {
@@ -87,10 +88,25 @@ public:
 private:
   bool filter();
 
+  //! rebuilds subtreeMask_ if filters were added since it was built
+  void updateSubtreeMask();
+
+  //! false if neither the current node nor its subtree can pass the filters
+  bool mayContainMatch();
+
+  //! DDExpandedView::next() skipping subtrees which cannot contain a match
+  bool nextNode();
+
+  const DDCompactView * cpv_;
   DDExpandedView epv_;
   std::vector<DDFilter const *> criteria_;
   std::vector<DDLogOp> logOps_; // logical operation for merging the result of 2 filters
   std::vector<DDGeoHistory> parents_; // filtered-parents
+  // subtreeMask_[i]: the subtree of compact-view node i may contain a match;
+  // only valid if maskedFilters_ == criteria_.size() and usable if useMask_
+  std::vector<bool> subtreeMask_;
+  size_t maskedFilters_;
+  bool useMask_;
 };
 
 #endif
@@ -0,0 +1,49 @@
+#ifndef DDCore_DDSpecParIndex_h
+#define DDCore_DDSpecParIndex_h
+
+#include <stddef.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class DDCompactView;
+class DDValue;
+
+//! Index of the SpecPars attached to the logical parts of a DDCompactView
+/**
+  Maps SpecPar names (and name/string-value pairs) to the nodes of
+  DDCompactView::graph() whose logical part carries them, and keeps the
+  inverted graph so that the set of nodes whose expanded subtree can contain
+  such a part is obtained without walking the expanded view.
+
+  DDCompactView::lockdown() builds it once; DDFilteredView uses it to skip
+  subtrees in which none of its filters can accept a node.
+*/
+class DDSpecParIndex
+{
+public:
+  typedef size_t index_type; //!< node index in DDCompactView::graph()
+  typedef std::vector<index_type> Nodes;
+
+  explicit DDSpecParIndex(const DDCompactView &);
+
+  //! nodes whose logical part has a SpecPar with the name of the given DDValue
+  const Nodes & partsWithName(const DDValue &) const;
+
+  //! nodes whose logical part has a SpecPar with this name and this string value
+  const Nodes & partsWithValue(const DDValue &, const std::string & value) const;
+
+  //! sets mask[i] for every node i from which one of nodes is reachable (including nodes)
+  void markAncestors(const Nodes & nodes, std::vector<bool> & mask) const;
+
+  size_t size() const { return parents_.size(); }
+
+private:
+  std::vector<Nodes> byName_; // indexed by DDValue::id()
+  std::map<std::pair<unsigned int, std::string>, Nodes> byValue_;
+  std::vector<Nodes> parents_; // parents_[i] ... nodes having i as a child
+  Nodes empty_;
+};
+
+#endif
@@ -2,6 +2,9 @@
 #define DD_DDStreamer_h
 
 #include <iostream>
+#include <vector>
+
+#include "DetectorDescription/Core/interface/DDName.h"
 
 class DDCompactView;
 
@@ -21,6 +24,12 @@ class DDCompactView;
   of the DDD objects.
   
   <br>
+  The positions (the graph) are taken from / put into the DDCompactView given with
+  setCompactView(). Writing has to happen before DDCompactView::lockdown() since the
+  other objects are taken from the global stores; reading fills the global stores and
+  the graph, so lockdown() has to be called afterwards as after parsing.
+  Names are stored as strings and re-registered on reading, so a file can be read
+  into a job which already created other DDNames.
   
   <br>
   \code
@@ -28,13 +37,15 @@ class DDCompactView;
   #include<fstream>
   std::ofstream file("pers.txt");
   DDStreamer streamer(file);
+  streamer.setCompactView(cpv);
   streamer.write();
   
   
   // reading:
   #include<fstream>
   std::ifstream file("pers.txt");
-  DDStreamer streamer(filer);
+  DDStreamer streamer(file);
+  streamer.setCompactView(cpv);
   streamer.read();
   \endcode
   
@@ -72,6 +83,20 @@ public:
   //! set the std::ostream for DDStreamer::write()
   void setOutput(std::ostream & o) { o_ = &o; }
   
+  //! set the DDCompactView whose graph is written or filled
+  void setCompactView(DDCompactView & cpv) { cpv_ = &cpv; }
+
+  //! true if none of the global stores written by write() holds a defined object yet
+  /** write() dumps the whole content of the stores, not only what was added to a
+      given DDCompactView; a dump made while this is true holds only what was added
+      afterwards. */
+  static bool storesEmpty();
+
+  //! version of the layout written by write(); increase it whenever that layout changes
+  /** Files written with another version can not be read back; caches of
+      DDStreamer output should be keyed on it. */
+  static constexpr unsigned int formatVersion = 1;
+  
 protected:  
   //! write all instances of DDName
   void names_write();
@@ -124,5 +149,7 @@ protected:
 private:  
   std::ostream * o_; /**< std::ostream target for writing DDD objects */
   std::istream * i_; /**< istream target for reading DDD objects */
+  DDCompactView * cpv_; /**< compact view holding the positions */
+  std::vector<DDName> names_; /**< DDNames of the ids found in the input */
 };
 #endif
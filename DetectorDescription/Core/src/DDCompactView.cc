@@ -9,6 +9,7 @@
 #include "DetectorDescription/Core/interface/DDMaterial.h"
 #include "DetectorDescription/Core/interface/DDPosData.h"
 #include "DetectorDescription/Core/interface/DDSolid.h"
+#include "DetectorDescription/Core/interface/DDSpecParIndex.h"
 #include "DetectorDescription/Core/interface/DDSpecifics.h"
 #include "DetectorDescription/Core/src/LogicalPart.h"
 #include "DetectorDescription/Core/src/Material.h"
@@ -137,6 +138,9 @@ void DDCompactView::setRoot(const DDLogicalPart & root)
 
 void DDCompactView::swap( DDCompactView& repToSwap ) {
   rep_->swap ( *(repToSwap.rep_) );
+  // the indices describe the graphs which have just been exchanged
+  specParIndex_.reset();
+  repToSwap.specParIndex_.reset();
 }
 
 DDCompactView::DDCompactView()
@@ -163,5 +167,7 @@ void DDCompactView::lockdown() {
   DDSpecifics::StoreT::instance().setReadOnly(false);
   DDRotation::StoreT::instance().setReadOnly(false);
 
+  // the graph and the attached SpecPars are final from here on
+  specParIndex_.reset( new DDSpecParIndex( *this ));
 }
 
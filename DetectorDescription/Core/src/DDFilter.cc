@@ -7,6 +7,7 @@
 
 #include "DetectorDescription/Core/interface/DDExpandedView.h"
 #include "DetectorDescription/Core/interface/DDLogicalPart.h"
+#include "DetectorDescription/Core/interface/DDSpecParIndex.h"
 #include "DetectorDescription/Core/interface/DDsvalues.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
@@ -16,6 +17,11 @@ DDFilter::DDFilter()
 DDFilter::~DDFilter()
 { }
 
+bool DDFilter::candidates(const DDSpecParIndex &, std::vector<size_t> &) const
+{
+  return false;
+}
+
 // =======================================================================
 // =======================================================================
 
@@ -266,6 +272,35 @@ bool DDSpecificsFilter::accept(const DDExpandedView & node) const
   return accept_impl(node);
 } 
 
+/**
+ accept_impl() gives false for every criterion whose variable is not attached
+ to the logical part of the node.  If the logical combination of all-false
+ criteria is false as well, only parts carrying at least one of the variables
+ can be accepted.  For string equality with a single value only parts with
+ that value are candidates: the merged value is one of the attached values,
+ and the non-merged comparison needs one attached value to be equal.
+*/
+bool DDSpecificsFilter::candidates(const DDSpecParIndex & index, std::vector<size_t> & nodes) const
+{
+  // result starts as true: it only turns false through an AND
+  bool acceptsAnyPart = true;
+  for( auto op : logOps_ ) {
+    if ( op == DDLogOp::AND ) acceptsAnyPart = false;
+  }
+  if ( acceptsAnyPart ) return false;
+
+  for( const auto& crit : criteria_ ) {
+    const bool byValue = ( crit.asString_ &&
+			   ( crit.comp_ == DDCompOp::equals || crit.comp_ == DDCompOp::matches ) &&
+			   crit.nameVal_.strings().size() == 1 );
+    const DDSpecParIndex::Nodes & found = byValue
+      ? index.partsWithValue(crit.nameVal_, crit.nameVal_.strings()[0])
+      : index.partsWithName(crit.nameVal_);
+    nodes.insert(nodes.end(), found.begin(), found.end());
+  }
+  return true;
+}
+
 bool DDSpecificsFilter::accept_impl(const DDExpandedView & node) const
 {
   bool result = true;
@@ -4,13 +4,15 @@
 #include <memory>
 #include <ostream>
 
+#include "DetectorDescription/Core/interface/DDCompactView.h"
+#include "DetectorDescription/Core/interface/DDSpecParIndex.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
 class DDCompactView;
 class DDLogicalPart;
 
 DDFilteredView::DDFilteredView(const DDCompactView & cpv)
- : epv_(cpv)
+ : cpv_(&cpv), epv_(cpv), maskedFilters_(0), useMask_(false)
 {
    parents_.push_back(epv_.geoHistory());
 }
@@ -94,12 +96,71 @@ void DDFilteredView::clearScope()
    parents_.push_back(epv_.geoHistory());
 }
 
+/**
+ The nodes which can pass the filters are taken from the SpecPar index of the
+ compact view (if the filters tell which ones they are). A compact-view node
+ whose own logical part cannot pass and from which no such part is reachable
+ can be skipped together with its whole expanded subtree.
+*/
+void DDFilteredView::updateSubtreeMask()
+{
+  if (maskedFilters_ == criteria_.size()) return;
+  maskedFilters_ = criteria_.size();
+  useMask_ = false;
+  subtreeMask_.clear();
+
+  const DDSpecParIndex * index = cpv_->specParIndex();
+  if (!index) return;
+
+  // filter() starts from true and only turns false through an AND
+  bool acceptsAnyPart = true;
+  for (auto op : logOps_) {
+    if (op == DDLogOp::AND) acceptsAnyPart = false;
+  }
+  if (acceptsAnyPart) return;
+
+  std::vector<size_t> nodes;
+  for (auto crit : criteria_) {
+    if (!crit->candidates(*index, nodes)) return;
+  }
+  index->markAncestors(nodes, subtreeMask_);
+  useMask_ = true;
+}
+
+bool DDFilteredView::mayContainMatch()
+{
+  if (!useMask_) return true;
+  DDCompactView::graph_type::index_result idx = cpv_->graph().nodeIndex(epv_.logicalPart());
+  return !idx.second || subtreeMask_[idx.first];
+}
+
+bool DDFilteredView::nextNode()
+{
+  updateSubtreeMask();
+  if (!useMask_) return epv_.next();
+
+  // same order as DDExpandedView::next(), but never entering a subtree
+  // which cannot contain a match
+  bool res = epv_.firstChild() || epv_.nextSibling();
+  while (true) {
+    if (!res) {
+      while (epv_.parent()) {
+        if (epv_.nextSibling()) {
+          res = true;
+          break;
+        }
+      }
+    }
+    if (!res || mayContainMatch()) break;
+    res = epv_.nextSibling();
+  }
+  return res;
+}
+
 bool DDFilteredView::next()
 {
    bool result = false;
-   int i=0;
-   while(epv_.next()) {
-     ++i;
+   while(nextNode()) {
      if ( filter() ) {
        result = true;
        break;
@@ -164,9 +225,13 @@ bool DDFilteredView::nextSibling()
   
   bool flag = true;
   //bool shuffleParent = false;
+  updateSubtreeMask();
   while (flag) {
     if (epv_.nextSibling()) {
-      if ( filter() ) {
+      if ( !mayContainMatch() ) {
+        // neither this node nor its subtree can match
+      }
+      else if ( filter() ) {
         result = true;
         break;
       }
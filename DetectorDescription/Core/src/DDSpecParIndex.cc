@@ -0,0 +1,68 @@
+#include "DetectorDescription/Core/interface/DDSpecParIndex.h"
+
+#include <algorithm>
+
+#include "DetectorDescription/Core/interface/DDCompactView.h"
+#include "DetectorDescription/Core/interface/DDLogicalPart.h"
+#include "DetectorDescription/Core/interface/DDValue.h"
+#include "DetectorDescription/Core/interface/DDsvalues.h"
+
+DDSpecParIndex::DDSpecParIndex(const DDCompactView & cpv)
+{
+  const DDCompactView::graph_type & g = cpv.graph();
+  parents_.resize(g.size());
+
+  for (index_type i = 0; i < g.size(); ++i) {
+    DDCompactView::graph_type::const_edge_range children = g.edges(i);
+    for (auto it = children.first; it != children.second; ++it) {
+      parents_[it->first].push_back(i);
+    }
+
+    const DDLogicalPart & lp = g.nodeData(i);
+    if (!lp.isDefined().second) continue;
+    for (const auto& spec : lp.attachedSpecifics()) {
+      for (const auto& val : *spec.second) {
+        const unsigned int id = val.first;
+        if (id >= byName_.size()) byName_.resize(id+1);
+        if (byName_[id].empty() || byName_[id].back() != i) byName_[id].push_back(i);
+        for (const auto& str : val.second.strings()) {
+          Nodes & nodes = byValue_[std::make_pair(id, str)];
+          if (nodes.empty() || nodes.back() != i) nodes.push_back(i);
+        }
+      }
+    }
+  }
+}
+
+const DDSpecParIndex::Nodes & DDSpecParIndex::partsWithName(const DDValue & v) const
+{
+  return v.id() < byName_.size() ? byName_[v.id()] : empty_;
+}
+
+const DDSpecParIndex::Nodes & DDSpecParIndex::partsWithValue(const DDValue & v, const std::string & value) const
+{
+  auto it = byValue_.find(std::make_pair(v.id(), value));
+  return it != byValue_.end() ? it->second : empty_;
+}
+
+void DDSpecParIndex::markAncestors(const Nodes & nodes, std::vector<bool> & mask) const
+{
+  mask.resize(parents_.size(), false);
+  Nodes stack;
+  for (auto n : nodes) {
+    if (!mask[n]) {
+      mask[n] = true;
+      stack.push_back(n);
+    }
+  }
+  while (!stack.empty()) {
+    const index_type n = stack.back();
+    stack.pop_back();
+    for (auto p : parents_[n]) {
+      if (!mask[p]) {
+        mask[p] = true;
+        stack.push_back(p);
+      }
+    }
+  }
+}
@@ -36,12 +36,12 @@
 #include<iomanip>
 
 DDStreamer::DDStreamer()
- : o_(0), i_(0)
+ : o_(0), i_(0), cpv_(0)
  {
  }
 
 DDStreamer::DDStreamer(std::ostream & os)
- :  o_(0), i_(0)
+ :  o_(0), i_(0), cpv_(0)
 {
   if (os) {
     o_ = &os;
@@ -52,7 +52,7 @@ DDStreamer::DDStreamer(std::ostream & os)
 }
 
 DDStreamer::DDStreamer(std::istream & is)
- :  o_(0), i_(0)
+ :  o_(0), i_(0), cpv_(0)
 {
   if (is) {
     i_ = &is;
@@ -106,11 +106,16 @@ DDName dd_get_name_string(std::istream & is)
 */   
 }
 
-DDName dd_get_name(std::istream & is)
+// the ids in the input are those of the writing job, translate them
+// to the DDNames registered by names_read()
+DDName dd_get_name(std::istream & is, const std::vector<DDName> & names)
 {
   size_t id(0);
   is >> id;
-  return DDName(id);
+  if (id >= names.size()) {
+    throw cms::Exception("DDException") << "DDStreamer: name id " << id << " not found in the input";
+  }
+  return names[id];
 }
 
 void nameout_strings(std::ostream & o, const DDName & n)
@@ -207,22 +212,21 @@ void DDStreamer::names_read()
 {
   DCOUT('Y', "DDStreamer::names_read()");
   std::istream & is = *i_;
-  DDName::IdToName & ids = DDI::Singleton<DDName::IdToName>::instance();
-  DDName::Registry & reg = DDI::Singleton<DDName::Registry>::instance();
   
   size_t s;
   is >> s;
-  ids.clear();
-  //ids.resize(s);
-  reg.clear();
+  names_.clear();
+  names_.reserve(s);
   size_t i(0);
-  //std::string nm; getline(is,nm);
   for (; i<s; ++i) {
     std::string nm(dd_get_delimit(is,'"'));
     std::string ns(dd_get_delimit(is,'"'));
     size_t id(0);
     is >> id;
-    DDName::defineId(std::make_pair(nm,ns),id);
+    if (id != i) {
+      throw cms::Exception("DDException") << "DDStreamer::names_read(): name ids are not consecutive";
+    }
+    names_.push_back(DDName(nm,ns));
   }
 }
 
@@ -308,7 +312,7 @@ void DDStreamer::materials_read()
   size_t i=0;
   for (; i < n; ++i) { // Materials
     is.ignore(1000,'@');
-    DDName dn = dd_get_name(is);
+    DDName dn = dd_get_name(is,names_);
     double z(0), a(0), d(0);
     is >> z;
     is >> a;
@@ -320,7 +324,7 @@ void DDStreamer::materials_read()
       DCOUT('y', "read-comp-material=" << m.name());
       int j=0;
       for(; j<comp; ++j) {
-        DDName cname(dd_get_name(is));
+        DDName cname(dd_get_name(is,names_));
 	double fm(0);
 	is >> fm;
 	DDMaterial constituent(cname);
@@ -399,9 +403,10 @@ void DDStreamer::solids_write()
 
 
 
-void dd_get_boolean_params(std::istream & is, DDRotation & r, DDTranslation & t, DDSolid & a, DDSolid & b)
+void dd_get_boolean_params(std::istream & is, const std::vector<DDName> & names,
+                           DDRotation & r, DDTranslation & t, DDSolid & a, DDSolid & b)
 {
-   DDName n = dd_get_name(is);
+   DDName n = dd_get_name(is,names);
    r = DDRotation(n);
    //double x(0), y(0), z(0);
    B x,y,z;
@@ -412,9 +417,9 @@ void dd_get_boolean_params(std::istream & is, DDRotation & r, DDTranslation & t,
    is >> y;
    is >> z;
    t = DDTranslation(x.val_,y.val_,z.val_);
-   n = dd_get_name(is);
+   n = dd_get_name(is,names);
    a = DDSolid(n);
-   n = dd_get_name(is);
+   n = dd_get_name(is,names);
    b = DDSolid(n);
    DCOUT('y', "boolean-par: rot=" << r.name() << " t=" << t << " a=" << a.name() << " b=" << b.name());
 }
@@ -429,7 +434,7 @@ void DDStreamer::solids_read()
   size_t i=0;
   for (; i < n; ++i) { // Solids
     is.ignore(1000,'@');
-    DDName dn = dd_get_name(is);
+    DDName dn = dd_get_name(is,names_);
 
     size_t sp(0);
     is >> sp;
@@ -441,7 +446,7 @@ void DDStreamer::solids_read()
       DDTranslation t;
       DDSolid a;
       DDSolid b;
-      dd_get_boolean_params(is,r,t,a,b);
+      dd_get_boolean_params(is,names_,r,t,a,b);
       switch (shape) {
       case ddunion:
         DDSolidFactory::unionSolid(dn,a,b,t,r);
@@ -459,19 +464,11 @@ void DDStreamer::solids_read()
     
     // reflection solids
     else if (shape==ddreflected) {
-      DDName ref_nm = dd_get_name(is);
+      DDName ref_nm = dd_get_name(is,names_);
       DDSolidFactory::reflection(dn,ref_nm);
     }
-    else if ( (shape==ddbox ) ||
-              (shape==ddtrap) ||
-              (shape==ddcons) ||
-              (shape==ddtubs) ||    
-              (shape==ddpolycone_rz) ||
-              (shape==ddpolycone_rrz) ||
-              (shape==ddpolyhedra_rz) ||	      	          
-              (shape==ddpolyhedra_rrz) ||
-              (shape==ddpseudotrap) ||
-              (shape==ddshapeless) )
+    // all other shapes are fully described by their parameters
+    else if (shape!=dd_not_init)
     {
       // read in the solid's parameters
       size_t npars(0);
@@ -537,12 +534,12 @@ void DDStreamer::parts_read()
   size_t i=0;
   for (; i < n; ++i) { // LogicalParts
     is.ignore(1000,'@');
-    DDName dn = dd_get_name(is);
+    DDName dn = dd_get_name(is,names_);
     size_t cat(0);
     is >> cat;
     DDEnums::Category categ = DDEnums::Category(cat);
-    DDName mat = dd_get_name(is);
-    DDName sol = dd_get_name(is);
+    DDName mat = dd_get_name(is,names_);
+    DDName sol = dd_get_name(is,names_);
     DDLogicalPart lp(dn,mat,sol,categ);
     DCOUT('y', "read-lp=" << lp);
   }
@@ -610,7 +607,7 @@ void DDStreamer::rots_read()
   size_t i=0;
   for (; i < n; ++i) { // Rotations
     is.ignore(1000,'@');
-    DDName dn = dd_get_name(is);
+    DDName dn = dd_get_name(is,names_);
     char c = is.get();
     if (c != ' ') { 
       throw cms::Exception("DDException") << "DDStreamer::rots_read(): inconsitency! no blank separator found!";
@@ -626,13 +623,15 @@ void DDStreamer::rots_read()
 void DDStreamer::pos_write()
 {
   DCOUT('Y', "DDStreamer::pos_write()");
-  DDCompactView cpv;
-  const DDCompactView::graph_type & g = cpv.graph();
+  if (!cpv_) {
+    throw cms::Exception("DDException") << "DDStreamer::pos_write(): no DDCompactView set";
+  }
+  const DDCompactView::graph_type & g = cpv_->graph();
   DDCompactView::graph_type::const_iterator it = g.begin_iter();
   DDCompactView::graph_type::const_iterator ed = g.end_iter();
   std::ostream & os = *o_;
   // first the root
-  DDLogicalPart rt = DDRootDef::instance().root();
+  DDLogicalPart rt = cpv_->root();
   os << "--Root: @ ";
   nameout(os,rt.name());
   os << std::endl;
@@ -694,15 +693,18 @@ void DDStreamer::pos_read()
   DCOUT('Y', "DDStreamer::pos_read()");
   std::istream & is = *i_;
   is.ignore(1000,'@');
-  DDName rtname = dd_get_name(is);
+  DDName rtname = dd_get_name(is,names_);
   DDLogicalPart root(rtname);
   DCOUT('y', "root is: " << root.name());
   DDRootDef::instance().set(root);
+  if (!cpv_) {
+    throw cms::Exception("DDException") << "DDStreamer::pos_read(): no DDCompactView set";
+  }
+  cpv_->setRoot(root);
   size_t n=0;
   is >> n;
   size_t i=0;
-  DDCompactView cpv;
-  DDCompactView::graph_type & g = const_cast<DDCompactView::graph_type&>(cpv.graph());
+  const DDCompactView::graph_type & g = cpv_->graph();
   //  DDPositioner pos_(&cpv);
   //LogDebug << "===== GRAPH SIZE = " << g.size() << " ======" << std::endl << std::endl;
   if (g.size()) {
@@ -713,8 +715,8 @@ void DDStreamer::pos_read()
   }
   for (; i < n; ++i) { // Positions
     is.ignore(1000,'@');
-    DDName from(dd_get_name(is));
-    DDName to(dd_get_name(is));
+    DDName from(dd_get_name(is,names_));
+    DDName to(dd_get_name(is,names_));
     std::string cp;
     is >> cp;
     char cr = is.get();
@@ -740,14 +742,14 @@ void DDStreamer::pos_read()
       case 'u': // unit rotation
         break;
       case 'r': // regular (named) rotation
-        rot = DDRotation(dd_get_name(is));
+        rot = DDRotation(dd_get_name(is,names_));
         break;
       default:
         std::string message = "DDStreamer::pos_read(): could not determine type of rotation\n";
         throw cms::Exception("DDException") << message;
       }	              	               
-    //DDName rot(dd_get_name(is));
-    cpv.position(DDLogicalPart(to),DDLogicalPart(from),cp,t,rot); 
+    //DDName rot(dd_get_name(is,names_));
+    cpv_->position(DDLogicalPart(to),DDLogicalPart(from),cp,t,rot); 
     DCOUT('y', " pos-read: f=" << from << " to=" << to << " t=" << t << " r=" << rot);
   }
 }
@@ -847,7 +849,7 @@ void DDStreamer::specs_read()
   size_t i=0;
   for (; i < n; ++i) { // Specifics
     is.ignore(1000,'@');
-    DDName sn(dd_get_name(is));
+    DDName sn(dd_get_name(is,names_));
     size_t nps(0);
     is >> nps;
     size_t ii=0;
@@ -949,3 +951,28 @@ void DDStreamer::vars_read()
 }
 
 
+
+// unlike dd_count() this does not default-construct a T, which for DDRotation
+// would itself define a (blank) rotation
+template<class T>
+bool dd_none_defined()
+{
+  typename T::template iterator<T> it(T::begin()), ed(T::end());
+  for (; it!=ed; ++it) {
+    if (it->isDefined().second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DDStreamer::storesEmpty()
+{
+  ClhepEvaluator * eval = dynamic_cast<ClhepEvaluator*>(&ExprEvalSingleton::instance());
+  return dd_none_defined<DDMaterial>()
+    && dd_none_defined<DDSolid>()
+    && dd_none_defined<DDLogicalPart>()
+    && dd_none_defined<DDSpecifics>()
+    && dd_none_defined<DDRotation>()
+    && (!eval || eval->variables().empty());
+}
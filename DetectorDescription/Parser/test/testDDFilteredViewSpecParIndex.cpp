@@ -0,0 +1,133 @@
+// Parses the test geometry and walks DDFilteredViews with the filters of
+// the muon, calorimeter and tracker builders, once before lockdown() (no
+// SpecPar index: every expanded node is visited) and once after it (subtrees
+// without candidates are skipped).  Both walks have to find the same nodes;
+// the time of each is printed for comparison.
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DetectorDescription/Core/interface/DDCompactView.h"
+#include "DetectorDescription/Core/interface/DDFilter.h"
+#include "DetectorDescription/Core/interface/DDFilteredView.h"
+#include "DetectorDescription/Core/interface/DDValue.h"
+#include "DetectorDescription/Parser/interface/DDLParser.h"
+#include "DetectorDescription/Parser/interface/FIPConfiguration.h"
+#include "FWCore/PluginManager/interface/PresenceFactory.h"
+#include "FWCore/PluginManager/interface/ProblemTracker.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ServiceToken.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/Presence.h"
+#include "boost/smart_ptr/shared_ptr.hpp"
+
+namespace {
+  struct Query {
+    const char * name;
+    const char * value;
+    DDCompOp comp;
+  };
+
+  // the criteria used by the DT, CSC, ECAL and tracker geometry builders
+  const Query queries[] = {
+    { "MuStructure",    "MuonBarrelDT",  DDCompOp::equals },
+    { "MuStructure",    "MuonEndcapCSC", DDCompOp::equals },
+    { "ReadOutName",    "EcalHitsEB",    DDCompOp::equals },
+    { "TkDDDStructure", "any",           DDCompOp::not_equals }
+  };
+
+  typedef std::chrono::high_resolution_clock Clock;
+
+  // the nodes found by next() and by firstChild()/nextSibling(), one per line
+  std::string walk(const DDCompactView & cpv, const Query & q, double & seconds)
+  {
+    DDValue val(q.name, q.value, 0.0);
+    DDSpecificsFilter filter;
+    filter.setCriteria(val, q.comp, DDLogOp::AND, true, true);
+
+    std::ostringstream os;
+    Clock::time_point t0 = Clock::now();
+    {
+      DDFilteredView fv(cpv);
+      fv.addFilter(filter);
+      while (fv.next()) os << fv.geoHistory() << '\n';
+    }
+    os << "--\n";
+    {
+      DDFilteredView fv(cpv);
+      fv.addFilter(filter);
+      bool more = fv.firstChild();
+      while (more) {
+	os << fv.geoHistory() << '\n';
+	more = fv.nextSibling();
+      }
+    }
+    seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    return os.str();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  std::string const kProgramName = argv[0];
+  int rc = 0;
+
+  try {
+    edm::AssertHandler ah;
+    boost::shared_ptr<edm::Presence> theMessageServicePresence;
+    theMessageServicePresence = boost::shared_ptr<edm::Presence>(edm::PresenceFactory::get()->
+								 makePresence("MessageServicePresence").release());
+    std::string config =
+      "import FWCore.ParameterSet.Config as cms\n"
+      "process = cms.Process('TEST')\n";
+    edm::ServiceToken tempToken(edm::ServiceRegistry::createServicesFromConfig(config));
+    edm::ServiceRegistry::Operate operate(tempToken);
+
+    DDCompactView cpv;
+    DDLParser myP(cpv);
+    FIPConfiguration dp(cpv);
+    dp.readConfig("DetectorDescription/Parser/test/cmsIdealGeometryXML.xml");
+    if (myP.parse(dp) != 0) {
+      std::cout << "parsing failed" << std::endl;
+      return 1;
+    }
+
+    const unsigned int nQuery = sizeof(queries)/sizeof(queries[0]);
+    std::vector<std::string> full(nQuery);
+    std::vector<double> fullTime(nQuery);
+    for (unsigned int i = 0; i != nQuery; ++i) {
+      full[i] = walk(cpv, queries[i], fullTime[i]);
+    }
+
+    cpv.lockdown();
+    if (!cpv.specParIndex()) {
+      std::cout << "lockdown() built no SpecPar index" << std::endl;
+      return 1;
+    }
+
+    for (unsigned int i = 0; i != nQuery; ++i) {
+      double indexedTime;
+      const std::string indexed = walk(cpv, queries[i], indexedTime);
+      std::cout << queries[i].name << ' ' << queries[i].value << ": full walk "
+		<< fullTime[i] << " s, with SpecPar index " << indexedTime << " s" << std::endl;
+      if (indexed != full[i]) {
+	std::cout << "  the filtered views differ" << std::endl;
+	rc = 1;
+      }
+    }
+    if (rc == 0) std::cout << "OK" << std::endl;
+  }
+  catch (cms::Exception& e) {
+    std::cout << "cms::Exception caught in " << kProgramName << "\n" << e.explainSelf();
+    rc = 1;
+  }
+  catch (std::exception& e) {
+    std::cout << "Standard library exception caught in " << kProgramName << "\n" << e.what();
+    rc = 1;
+  }
+  return rc;
+}
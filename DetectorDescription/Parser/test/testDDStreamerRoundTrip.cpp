@@ -0,0 +1,125 @@
+// Parses the test geometry, writes it with DDStreamer, reads it back into
+// a second DDCompactView and compares the expanded views of both.
+
+#include <algorithm>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "DetectorDescription/Core/interface/DDCompactView.h"
+#include "DetectorDescription/Core/interface/DDExpandedNode.h"
+#include "DetectorDescription/Core/interface/DDExpandedView.h"
+#include "DetectorDescription/Core/interface/DDLogicalPart.h"
+#include "DetectorDescription/Core/interface/DDMaterial.h"
+#include "DetectorDescription/Core/interface/DDSolid.h"
+#include "DetectorDescription/Core/interface/DDStreamer.h"
+#include "DetectorDescription/Parser/interface/DDLParser.h"
+#include "DetectorDescription/Parser/interface/FIPConfiguration.h"
+#include "FWCore/PluginManager/interface/PresenceFactory.h"
+#include "FWCore/PluginManager/interface/ProblemTracker.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ServiceToken.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/Presence.h"
+#include "boost/smart_ptr/shared_ptr.hpp"
+
+namespace {
+  // one line per expanded node with everything the streamer has to keep
+  std::string dump(const DDCompactView & cpv)
+  {
+    std::ostringstream os;
+    os << std::setprecision(17);
+    DDExpandedView ev(cpv);
+    do {
+      const DDLogicalPart & lp = ev.logicalPart();
+      os << ev.geoHistory() << " |";
+      const DDTranslation & t = ev.translation();
+      os << ' ' << t.x() << ' ' << t.y() << ' ' << t.z() << " |";
+      double r[9];
+      ev.rotation().GetComponents(r, r+9);
+      for (double x : r) os << ' ' << x;
+      os << " | " << lp.solid().name() << ' ' << lp.solid().shape();
+      for (double p : lp.solid().parameters()) os << ' ' << p;
+      os << " | " << lp.material().name() << ' ' << lp.material().density();
+      os << " | " << lp.attachedSpecifics().size() << '\n';
+    } while (ev.next());
+    return os.str();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  std::string const kProgramName = argv[0];
+  int rc = 0;
+
+  try {
+    edm::AssertHandler ah;
+    boost::shared_ptr<edm::Presence> theMessageServicePresence;
+    theMessageServicePresence = boost::shared_ptr<edm::Presence>(edm::PresenceFactory::get()->
+								 makePresence("MessageServicePresence").release());
+    std::string config =
+      "import FWCore.ParameterSet.Config as cms\n"
+      "process = cms.Process('TEST')\n";
+    edm::ServiceToken tempToken(edm::ServiceRegistry::createServicesFromConfig(config));
+    edm::ServiceRegistry::Operate operate(tempToken);
+
+    if (!DDStreamer::storesEmpty()) {
+      std::cout << "the DD stores are not empty before parsing" << std::endl;
+      return 1;
+    }
+
+    DDCompactView cpv;
+    DDLParser myP(cpv);
+    FIPConfiguration dp(cpv);
+    dp.readConfig("DetectorDescription/Parser/test/cmsIdealGeometryXML.xml");
+    if (myP.parse(dp) != 0) {
+      std::cout << "parsing failed" << std::endl;
+      return 1;
+    }
+    if (DDStreamer::storesEmpty()) {
+      std::cout << "the DD stores are empty after parsing" << std::endl;
+      return 1;
+    }
+    const std::string parsed = dump(cpv);
+
+    std::stringstream stream;
+    {
+      DDStreamer streamer(stream);
+      streamer.setCompactView(cpv);
+      streamer.write();
+    }
+
+    // the stores are global: reading defines the same objects again,
+    // the graph goes into a new compact view
+    DDCompactView reloaded(cpv.root());
+    {
+      DDStreamer streamer(stream);
+      streamer.setCompactView(reloaded);
+      streamer.read();
+    }
+    const std::string read = dump(reloaded);
+
+    if (parsed != read) {
+      std::istringstream p(parsed), r(read);
+      std::string lp, lr;
+      while (std::getline(p, lp) && std::getline(r, lr) && lp == lr) {}
+      std::cout << "the reloaded compact view differs:\n  parsed:   " << lp
+		<< "\n  reloaded: " << lr << std::endl;
+      rc = 1;
+    } else {
+      std::cout << "OK, " << std::count(parsed.begin(), parsed.end(), '\n') << " expanded nodes" << std::endl;
+    }
+  }
+  catch (cms::Exception& e) {
+    std::cout << "cms::Exception caught in " << kProgramName << "\n" << e.explainSelf();
+    rc = 1;
+  }
+  catch (std::exception& e) {
+    std::cout << "Standard library exception caught in " << kProgramName << "\n" << e.what();
+    rc = 1;
+  }
+  return rc;
+}
@@ -22,6 +22,7 @@ is the DataBlock.
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
 #include "FWCore/Framework/interface/Principal.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -168,6 +169,9 @@ namespace edm {
 
     ProductID branchIDToProductID(BranchID const& bid) const;
 
+    // Also forgets the products found by getIt for this event.
+    void deleteProduct(BranchID const& id) const;
+
     void mergeProvenanceRetrievers(EventPrincipal& other) {
       provRetrieverPtr_->mergeProvenanceRetrievers(other.provRetrieverPtr());
     }
@@ -184,6 +188,10 @@ namespace edm {
 
     BranchID pidToBid(ProductID const& pid) const;
 
+    std::atomic<WrapperBase const*>* resolvedProductSlot(ProductID const& pid) const;
+    void resetResolvedProducts();
+    void forgetResolvedProducts() const;
+
     edm::ThinnedAssociation const* getThinnedAssociation(edm::BranchID const& branchID) const;
 
     virtual void readFromSource_(ProductResolverBase const& phb, ModuleCallingContext const* mcc) const override;
@@ -210,6 +218,15 @@ namespace edm {
     BranchListIndexes branchListIndexes_;
 
     std::map<BranchListIndex, ProcessIndex> branchListIndexToProcessIndex_;
+
+    // The products already found by getIt in this event, so that Refs and
+    // Ptrs to a product do not go through the BranchID and ProductResolver
+    // lookups every time.  The slot of a ProductID is at
+    // resolvedProductOffsets_[processIndex - 1] + productIndex - 1, the same
+    // indices used to find its BranchID.  A null slot means not found yet.
+    std::vector<unsigned int> resolvedProductOffsets_;
+    std::unique_ptr<std::atomic<WrapperBase const*>[]> resolvedProducts_;
+    unsigned int resolvedProductsCapacity_;
     
     StreamID streamID_;
 
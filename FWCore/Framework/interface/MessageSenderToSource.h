@@ -0,0 +1,52 @@
+#ifndef FWCore_Framework_MessageSenderToSource_h
+#define FWCore_Framework_MessageSenderToSource_h
+/**\class MessageSenderToSource MessageSenderToSource.h FWCore/Framework/interface/MessageSenderToSource.h
+
+ Description: Controller side of the communication between controller process and worker processes when using multicore
+
+ Usage:
+    The controller runs it in its own thread after forking the workers.  Each worker asks for work through
+ a MessageReceiverForSource and is given the next block of iNEventsToProcess consecutive event indices.
+ The blocks never end: a worker stops asking once the indices are past the end of its input.  The function
+ returns once all the workers have closed their watchdog pipe, i.e. have exited.
+
+*/
+//
+// Original Author:  Chris Jones
+//         Created:  Thu Dec 30 10:09:50 CST 2010
+//
+
+// system include files
+#include <sys/select.h>
+#include <vector>
+
+// user include files
+
+// forward declarations
+
+namespace edm {
+   namespace multicore {
+      class MessageSenderToSource
+      {
+
+      public:
+         ///Takes the fds of the parent side of the sockets and watchdog pipes of the children.
+         /// operator() closes all of them before it returns; the caller must not close them.
+         MessageSenderToSource(std::vector<int> const& childrenSockets, std::vector<int> const& childrenPipes, long iNEventsToProcess);
+
+         // ---------- member functions ---------------------------
+         void operator()();
+
+      private:
+         // ---------- member data --------------------------------
+         const std::vector<int>& m_childrenPipes;
+         long const m_nEventsToProcess;
+         fd_set m_socketSet;
+         unsigned int m_aliveChildren;
+         int m_maxFd;
+      };
+   }
+}
+
+
+#endif
@@ -38,6 +38,7 @@ namespace edm {
 
     /// used by the fwk to register the list of products of this module 
     TypeLabelList & typeLabelList();
+    TypeLabelList const& typeLabelList() const { return typeLabelList_; }
 
     static
     void addToRegistry(TypeLabelList::const_iterator const& iBegin,
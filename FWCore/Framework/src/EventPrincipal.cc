@@ -44,6 +44,9 @@ namespace edm {
           thinnedAssociationsHelper_(thinnedAssociationsHelper),
           branchListIndexes_(),
           branchListIndexToProcessIndex_(),
+          resolvedProductOffsets_(),
+          resolvedProducts_(),
+          resolvedProductsCapacity_(0),
           streamID_(streamIndex) {
     assert(thinnedAssociationsHelper_);
   }
@@ -55,6 +58,7 @@ namespace edm {
     luminosityBlockPrincipal_ = nullptr; // propagate_const<T> has no reset() function
     provRetrieverPtr_->reset();
     branchListIndexToProcessIndex_.clear();
+    resolvedProductOffsets_.clear();
   }
 
   void
@@ -113,6 +117,7 @@ namespace edm {
       branchListIndexToProcessIndex_.insert(std::make_pair(blindex, pix));
       ++pix;
     }
+    resetResolvedProducts();
 
     // Fill in the product ID's in the product holders.
     for(auto& prod : *this) {
@@ -289,9 +294,68 @@ namespace edm {
     return BasicHandle(nullptr,nullptr);
   }
 
+  void
+  EventPrincipal::resetResolvedProducts() {
+    BranchIDLists const& lists = branchIDListHelper_->branchIDLists();
+    resolvedProductOffsets_.clear();
+    resolvedProductOffsets_.reserve(branchListIndexes_.size() + 1);
+    resolvedProductOffsets_.push_back(0);
+    for(auto const& blindex : branchListIndexes_) {
+      unsigned int n = blindex < lists.size() ? lists[blindex].size() : 0;
+      resolvedProductOffsets_.push_back(resolvedProductOffsets_.back() + n);
+    }
+    unsigned int const nSlots = resolvedProductOffsets_.back();
+    if(nSlots > resolvedProductsCapacity_) {
+      resolvedProducts_.reset(new std::atomic<WrapperBase const*>[nSlots]);
+      resolvedProductsCapacity_ = nSlots;
+    }
+    forgetResolvedProducts();
+  }
+
+  void
+  EventPrincipal::forgetResolvedProducts() const {
+    unsigned int const nSlots = resolvedProductOffsets_.empty() ? 0 : resolvedProductOffsets_.back();
+    for(unsigned int i = 0; i != nSlots; ++i) {
+      resolvedProducts_[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<WrapperBase const*>*
+  EventPrincipal::resolvedProductSlot(ProductID const& pid) const {
+    // same checks as in productIDToBranchID
+    if(!pid.isValid() || pid.processIndex() == 0) return nullptr;
+    size_t const procIndex = pid.processIndex() - 1;
+    if(procIndex + 1 >= resolvedProductOffsets_.size()) return nullptr;
+    unsigned int const slot = resolvedProductOffsets_[procIndex] + pid.productIndex() - 1;
+    if(slot >= resolvedProductOffsets_[procIndex + 1]) return nullptr;
+    return &resolvedProducts_[slot];
+  }
+
   WrapperBase const*
   EventPrincipal::getIt(ProductID const& pid) const {
-    return getByProductID(pid).wrapper();
+    std::atomic<WrapperBase const*>* slot = resolvedProductSlot(pid);
+    if(slot != nullptr) {
+      WrapperBase const* product = slot->load(std::memory_order_acquire);
+      if(product != nullptr) return product;
+    }
+    WrapperBase const* product = getByProductID(pid).wrapper();
+    // products not found are not remembered, they may be put later
+    if(slot != nullptr && product != nullptr) {
+      // only fill an empty slot, it is emptied again when a product is deleted
+      WrapperBase const* expected = nullptr;
+      slot->compare_exchange_strong(expected, product, std::memory_order_acq_rel);
+    }
+    return product;
+  }
+
+  void
+  EventPrincipal::deleteProduct(BranchID const& id) const {
+    // A product can be reached through more than one ProductID (aliases),
+    // so the whole table is cleared; deletions are rare compared to gets.
+    // Clear it after the deletion so a concurrent getIt cannot remember the
+    // product again once it is cleared.
+    Principal::deleteProduct(id);
+    forgetResolvedProducts();
   }
 
   WrapperBase const*
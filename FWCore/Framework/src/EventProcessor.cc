@@ -1,6 +1,7 @@
 
 #include "FWCore/Framework/interface/EventProcessor.h"
 
+#include "DataFormats/Provenance/interface/BranchDescription.h"
 #include "DataFormats/Provenance/interface/BranchIDListHelper.h"
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
 #include "DataFormats/Provenance/interface/ParameterSetID.h"
@@ -20,6 +21,7 @@
 #include "FWCore/Framework/interface/LuminosityBlock.h"
 #include "FWCore/Framework/interface/LuminosityBlockPrincipal.h"
 #include "FWCore/Framework/interface/MessageReceiverForSource.h"
+#include "FWCore/Framework/interface/MessageSenderToSource.h"
 #include "FWCore/Framework/interface/ModuleChanger.h"
 #include "FWCore/Framework/interface/OccurrenceTraits.h"
 #include "FWCore/Framework/interface/ProcessingController.h"
@@ -40,6 +42,8 @@
 #include "FWCore/ParameterSet/interface/ParameterSetDescriptionFillerPluginFactory.h"
 #include "FWCore/ParameterSet/interface/ProcessDesc.h"
 #include "FWCore/ParameterSet/interface/Registry.h"
+#include "FWCore/PluginManager/interface/PluginCapabilities.h"
+#include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/PythonParameterSet/interface/PythonProcessDesc.h"
 
 #include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
@@ -56,13 +60,15 @@
 #include "FWCore/Utilities/interface/ExceptionCollector.h"
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/Utilities/interface/RootHandlers.h"
+#include "FWCore/Utilities/interface/TypeWithDict.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
 
-#include "MessageForSource.h"
-#include "MessageForParent.h"
 
 #include "boost/thread/xtime.hpp"
 
+#include "TClass.h"
+
+#include <algorithm>
 #include <exception>
 #include <iomanip>
 #include <iostream>
@@ -185,6 +191,68 @@ namespace edm {
     return input;
   }
 
+  // ---------------------------------------------------------------
+  namespace {
+    void addPlugins(ParameterSet const& params,
+                    std::string const& iListName,
+                    std::string const& iCategory,
+                    std::vector<edmplugin::PluginManager::CategoryAndPlugin>& oPlugins) {
+      if(!params.existsAs<std::vector<std::string> >(iListName)) {
+        return;
+      }
+      for(auto const& label : params.getParameter<std::vector<std::string> >(iListName)) {
+        if(params.existsAs<ParameterSet>(label)) {
+          ParameterSet const& pset = params.getParameterSet(label);
+          if(pset.existsAs<std::string>("@module_type")) {
+            oPlugins.emplace_back(iCategory, pset.getParameter<std::string>("@module_type"));
+          }
+        }
+      }
+    }
+
+    // The plugins a configuration asks for, in the order they will be created
+    std::vector<edmplugin::PluginManager::CategoryAndPlugin>
+    pluginsInConfiguration(ParameterSet const& params, std::vector<ParameterSet> const& services) {
+      std::vector<edmplugin::PluginManager::CategoryAndPlugin> plugins;
+      for(auto const& service : services) {
+        if(service.existsAs<std::string>("@service_type")) {
+          plugins.emplace_back("CMS EDM Framework Service", service.getParameter<std::string>("@service_type"));
+        }
+      }
+      addPlugins(params, "@all_esmodules", "CMS EDM Framework ESModule", plugins);
+      addPlugins(params, "@all_essources", "CMS EDM Framework ESSource", plugins);
+      addPlugins(params, "@all_loopers", "CMS EDM Framework EDLooper", plugins);
+      if(params.existsAs<ParameterSet>("@main_input")) {
+        ParameterSet const& main_input = params.getParameterSet("@main_input");
+        if(main_input.existsAs<std::string>("@module_type")) {
+          plugins.emplace_back("CMS EDM Framework InputSource", main_input.getParameter<std::string>("@module_type"));
+        }
+      }
+      addPlugins(params, "@all_modules", "CMS EDM Framework Module", plugins);
+      return plugins;
+    }
+
+    void printPluginLoadTimes() {
+      std::vector<edmplugin::PluginManager::LoadRecord> records = edmplugin::PluginManager::get()->loadRecords();
+      std::stable_sort(records.begin(), records.end(),
+                       [](edmplugin::PluginManager::LoadRecord const& a, edmplugin::PluginManager::LoadRecord const& b) {
+                         return a.seconds_ > b.seconds_;
+                       });
+      double total = 0.;
+      for(auto const& record : records) {
+        total += record.seconds_;
+      }
+      LogAbsolute out("PluginLoading");
+      out << "Loaded " << records.size() << " plugin libraries in " << std::fixed << std::setprecision(3) << total << " s\n";
+      auto const& preloaded = edmplugin::PluginCapabilities::get()->preloadRecord();
+      out << "Preloaded the dictionaries of " << preloaded.classes_ << " classes from " << preloaded.libraries_
+          << " libraries in " << preloaded.seconds_ << " s\n";
+      for(auto const& record : records) {
+        out << std::setw(10) << record.seconds_ << " s  " << record.loadable_.string() << "\n";
+      }
+    }
+  }
+
   // ---------------------------------------------------------------
   std::shared_ptr<EDLooperBase>
   fillLooper(eventsetup::EventSetupsController& esController,
@@ -477,12 +545,20 @@ namespace edm {
                                                                itPS->getUntrackedParameter<std::string>("label", "")));
     }
     IllegalParameters::setThrowAnException(optionsPset.getUntrackedParameter<bool>("throwIfIllegalParameter", true));
+    bool const reportPluginLoadTimes = optionsPset.getUntrackedParameter<bool>("reportPluginLoadTimes", false);
 
     // Now do general initialization
     ScheduleItems items;
 
-    //initialize the services
     std::shared_ptr<std::vector<ParameterSet> > pServiceSets = processDesc->getServicesPSets();
+
+    //load all the plugin libraries up front, rather than one at a time as each
+    // component is created
+    if(optionsPset.getUntrackedParameter<bool>("preloadPlugins", false)) {
+      edmplugin::PluginManager::get()->preload(pluginsInConfiguration(*parameterSet, *pServiceSets));
+    }
+
+    //initialize the services
     ServiceToken token = items.initServices(*pServiceSets, *parameterSet, iToken, iLegacy, true);
     serviceToken_ = items.addCPRandTNS(*parameterSet, token);
 
@@ -570,6 +646,9 @@ namespace edm {
                                     &processContext_);
        }
     }
+    if(reportPluginLoadTimes) {
+      printPluginLoadTimes();
+    }
   }
 
   EventProcessor::~EventProcessor() {
@@ -750,153 +829,6 @@ namespace edm {
       return n;
     }
     
-    /*This class embodied the thread which is used to listen to the forked children and
-     then tell them which events they should process */
-    class MessageSenderToSource {
-    public:
-      MessageSenderToSource(std::vector<int> const& childrenSockets, std::vector<int> const& childrenPipes, long iNEventsToProcess);
-      void operator()();
-
-    private:
-      const std::vector<int>& m_childrenPipes;
-      long const m_nEventsToProcess;
-      fd_set m_socketSet;
-      unsigned int m_aliveChildren;
-      int m_maxFd;
-    };
-    
-    MessageSenderToSource::MessageSenderToSource(std::vector<int> const& childrenSockets,
-                                                 std::vector<int> const& childrenPipes,
-                                                 long iNEventsToProcess):
-    m_childrenPipes(childrenPipes),
-    m_nEventsToProcess(iNEventsToProcess),
-    m_aliveChildren(childrenSockets.size()),
-    m_maxFd(0)
-    {
-      FD_ZERO(&m_socketSet);
-      for (std::vector<int>::const_iterator it = childrenSockets.begin(), itEnd = childrenSockets.end();
-           it != itEnd; it++) {
-        FD_SET(*it, &m_socketSet);
-        if (*it > m_maxFd) {
-          m_maxFd = *it;
-        }
-      }
-      for (std::vector<int>::const_iterator it = childrenPipes.begin(), itEnd = childrenPipes.end();
-           it != itEnd; ++it) {
-        FD_SET(*it, &m_socketSet);
-        if (*it > m_maxFd) {
-          m_maxFd = *it;
-        }
-      }
-      m_maxFd++; // select reads [0,m_maxFd).
-    }
-   
-    /* This function is the heart of the communication between parent and child.
-     * When ready for more data, the child (see MessageReceiverForSource) requests
-     * data through a AF_UNIX socket message.  The parent will then assign the next
-     * chunk of data by sending a message back.
-     *
-     * Additionally, this function also monitors the read-side of the pipe fd from the child.
-     * If the child dies unexpectedly, the pipe will be selected as ready for read and
-     * will return EPIPE when read from.  Further, if the child thinks the parent has died
-     * (defined as waiting more than 1s for a response), it will write a single byte to
-     * the pipe.  If the parent has died, the child will get a EPIPE and throw an exception.
-     * If still alive, the parent will read the byte and ignore it.
-     *
-     * Note this function is complemented by the SIGCHLD handler above as currently only the SIGCHLD
-     * handler can distinguish between success and failure cases.
-     */
- 
-    void
-    MessageSenderToSource::operator()() {
-      multicore::MessageForParent childMsg;
-      LogInfo("ForkingController") << "I am controller";
-      //this is the master and therefore the controller
-      
-      multicore::MessageForSource sndmsg;
-      sndmsg.startIndex = 0;
-      sndmsg.nIndices = m_nEventsToProcess;
-      do {
-        
-        fd_set readSockets, errorSockets;
-        // Wait for a request from a child for events.
-        memcpy(&readSockets, &m_socketSet, sizeof(m_socketSet));
-        memcpy(&errorSockets, &m_socketSet, sizeof(m_socketSet));
-        // Note that we don't timeout; may be reconsidered in the future.
-        ssize_t rc;
-        while (((rc = select(m_maxFd, &readSockets, NULL, &errorSockets, NULL)) < 0) && (errno == EINTR)) {}
-        if (rc < 0) {
-          std::cerr << "select failed; should be impossible due to preconditions.\n";
-          abort();
-          break;
-        }
-
-        // Read the message from the child.
-        for (int idx=0; idx<m_maxFd; idx++) {
-
-          // Handle errors
-          if (FD_ISSET(idx, &errorSockets)) {
-            LogInfo("ForkingController") << "Error on socket " << idx;
-            FD_CLR(idx, &m_socketSet);
-            close(idx);
-            // See if it was the watchdog pipe that died.
-            for (std::vector<int>::const_iterator it = m_childrenPipes.begin(); it != m_childrenPipes.end(); it++) {
-              if (*it == idx) {
-                m_aliveChildren--;
-              }
-            }
-            continue;
-          }
-          
-          if (!FD_ISSET(idx, &readSockets)) {
-            continue;
-          }
-
-          // See if this FD is a child watchdog pipe.  If so, read from it to prevent
-          // writes from blocking.
-          bool is_pipe = false;
-          for (std::vector<int>::const_iterator it = m_childrenPipes.begin(), itEnd = m_childrenPipes.end(); it != itEnd; it++) {
-              if (*it == idx) {
-                is_pipe = true;
-                char buf;
-                while (((rc = read(idx, &buf, 1)) < 0) && (errno == EINTR)) {}
-                if (rc <= 0) {
-                  m_aliveChildren--;
-                  FD_CLR(idx, &m_socketSet);
-                  close(idx);
-                }
-              }
-          }
-
-          // Only execute this block if the FD is a socket for sending the child work.
-          if (!is_pipe) {
-            while (((rc = recv(idx, reinterpret_cast<char*>(&childMsg),childMsg.sizeForBuffer() , 0)) < 0) && (errno == EINTR)) {}
-            if (rc < 0) {
-              FD_CLR(idx, &m_socketSet);
-              close(idx);
-              continue;
-            }
-          
-            // Tell the child what events to process.
-            // If 'send' fails, then the child process has failed (any other possibilities are
-            // eliminated because we are using fixed-size messages with Unix datagram sockets).
-            // Thus, the SIGCHLD handler will fire and set child_fail = true.
-            while (((rc = send(idx, (char *)(&sndmsg), multicore::MessageForSource::sizeForBuffer(), 0)) < 0) && (errno == EINTR)) {}
-            if (rc < 0) {
-              FD_CLR(idx, &m_socketSet);
-              close(idx);
-              continue;
-            }
-            //std::cout << "Sent chunk starting at " << sndmsg.startIndex << " to child, length " << sndmsg.nIndices << std::endl;
-            sndmsg.startIndex += sndmsg.nIndices;
-          }
-        }
-      
-      } while (m_aliveChildren > 0);
-      
-      return;
-    }
-
   }
 
   
@@ -981,16 +913,33 @@ namespace edm {
       }
     }
     LogSystem("ForkingEventSetupPreFetching") <<"  done prefetching";
+    {
+      //ROOT builds the streamer info of a class the first time an object of the class is read or
+      // written. Build them all now so the children share them instead of each building its own.
+      unsigned int nClasses = 0;
+      for(auto const& product : preg_->productList()) {
+        TClass* wrapperClass = product.second.wrappedType().getClass();
+        if(wrapperClass != nullptr) {
+          wrapperClass->GetStreamerInfo();
+          ++nClasses;
+        }
+      }
+      LogSystem("ForkingStreamerInfoPreFetching") << "  built the streamer infos of " << nClasses << " product classes";
+    }
     {
       // make the services available
       ServiceRegistry::Operate operate(serviceToken_);
-      Service<JobReport> jobReport;
-      jobReport->parentBeforeFork(jobReportFile, numberOfForkedChildren_);
 
       //Now actually do the forking
       actReg_->preForkReleaseResourcesSignal_();
       input_->doPreForkReleaseResources();
       schedule_->preForkReleaseResources();
+
+      //after the release of the resources, which may still report to the job report,
+      // so nothing is left to be written by both the parent and the children. The input
+      // file closed by the release is not written, the children report what they read of it
+      Service<JobReport> jobReport;
+      jobReport->parentBeforeFork(jobReportFile, numberOfForkedChildren_);
     }
     installCustomHandler(SIGCHLD, ep_sigchld);
 
@@ -1164,7 +1113,7 @@ namespace edm {
     //create a thread that sends the units of work to workers
     // we create it after all signals were blocked so that this
     // thread is never interupted by a signal
-    MessageSenderToSource sender(childrenSockets, childrenPipes, numberOfSequentialEventsPerChild_);
+    multicore::MessageSenderToSource sender(childrenSockets, childrenPipes, numberOfSequentialEventsPerChild_);
     boost::thread senderThread(sender);
 
     if(not too_many_fds) {
@@ -1201,6 +1150,12 @@ namespace edm {
     }
     // The senderThread will notice the pipes die off, one by one.  Once all children are gone, it will exit.
     senderThread.join();
+    {
+      // make the services available
+      ServiceRegistry::Operate operate(serviceToken_);
+      Service<JobReport> jobReport;
+      jobReport->parentAfterChildrenEnded(jobReportFile, kMaxChildren);
+    }
     if(child_failed && !continueAfterChildFailure_) {
       if (child_fail_signal) {
         throw cms::Exception("ForkedChildFailed") << "child process ended abnormally with signal " << child_fail_signal;
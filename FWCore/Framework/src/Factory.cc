@@ -4,6 +4,7 @@
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
 
+#include <cassert>
 #include <iostream>
 
 EDM_REGISTER_PLUGINFACTORY(edm::MakerPluginFactory,"CMS EDM Framework Module");
@@ -74,6 +75,29 @@ namespace edm {
     return mod;
   }
 
+  bool Factory::canConstructConcurrently(const MakeModuleParams& p) const
+  {
+    return findMaker(p)->canBeConstructedConcurrently();
+  }
+
+  //The maker must already have been found by canConstructConcurrently, as
+  // this is called concurrently and must not modify the map of makers
+  std::shared_ptr<maker::ModuleHolder> Factory::constructModule(const MakeModuleParams& p) const
+  {
+    std::string modtype = p.pset_->getParameter<std::string>("@module_type");
+    MakerMap::const_iterator it = makers_.find(modtype);
+    assert(it != makers_.end());
+    return it->second->constructModule(p);
+  }
+
+  std::shared_ptr<maker::ModuleHolder> Factory::completeModule(const MakeModuleParams& p,
+                                                               std::shared_ptr<maker::ModuleHolder> iModule,
+                                                               signalslot::Signal<void(const ModuleDescription&)>& pre,
+                                                               signalslot::Signal<void(const ModuleDescription&)>& post) const
+  {
+    return findMaker(p)->completeModule(p,iModule,pre,post);
+  }
+
   std::shared_ptr<maker::ModuleHolder> Factory::makeReplacementModule(const edm::ParameterSet& p) const
   {
     std::string modtype = p.getParameter<std::string>("@module_type");
@@ -30,6 +30,14 @@ namespace edm {
 
     std::shared_ptr<maker::ModuleHolder> makeReplacementModule(const edm::ParameterSet&) const;
 
+    //see Maker::constructModule and Maker::completeModule
+    bool canConstructConcurrently(const MakeModuleParams&) const;
+    std::shared_ptr<maker::ModuleHolder> constructModule(const MakeModuleParams&) const;
+    std::shared_ptr<maker::ModuleHolder> completeModule(const MakeModuleParams&,
+                                                        std::shared_ptr<maker::ModuleHolder> iModule,
+                                                        signalslot::Signal<void(const ModuleDescription&)>& pre,
+                                                        signalslot::Signal<void(const ModuleDescription&)>& post) const;
+
 
   private:
     Factory();
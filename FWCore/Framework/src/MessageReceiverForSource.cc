@@ -75,8 +75,8 @@ m_numberToSkip(0)
 // member functions
 //
 /*
- * The child side of the parent-child communication.  See MessageSenderForSource in 
- * EventProcessor.cc for more information.
+ * The child side of the parent-child communication.  See MessageSenderToSource.cc
+ * for more information.
  *
  * If the parent terminates before/during send, the send will immediately fail.
  * If the parent terminates after send and before recv is successful, the recv may hang.
@@ -0,0 +1,174 @@
+// -*- C++ -*-
+//
+// Package:     Framework
+// Class  :     MessageSenderToSource
+//
+// Implementation:
+//     [Notes on implementation]
+//
+// Original Author:  Chris Jones
+//         Created:  Thu Dec 30 10:09:50 CST 2010
+//
+
+// system include files
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// user include files
+#include "FWCore/Framework/interface/MessageSenderToSource.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "MessageForSource.h"
+#include "MessageForParent.h"
+
+namespace edm {
+namespace multicore {
+//
+// constructors and destructor
+//
+MessageSenderToSource::MessageSenderToSource(std::vector<int> const& childrenSockets,
+                                             std::vector<int> const& childrenPipes,
+                                             long iNEventsToProcess):
+m_childrenPipes(childrenPipes),
+m_nEventsToProcess(iNEventsToProcess),
+m_aliveChildren(childrenSockets.size()),
+m_maxFd(0)
+{
+  FD_ZERO(&m_socketSet);
+  for (std::vector<int>::const_iterator it = childrenSockets.begin(), itEnd = childrenSockets.end();
+       it != itEnd; it++) {
+    FD_SET(*it, &m_socketSet);
+    if (*it > m_maxFd) {
+      m_maxFd = *it;
+    }
+  }
+  for (std::vector<int>::const_iterator it = childrenPipes.begin(), itEnd = childrenPipes.end();
+       it != itEnd; ++it) {
+    FD_SET(*it, &m_socketSet);
+    if (*it > m_maxFd) {
+      m_maxFd = *it;
+    }
+  }
+  m_maxFd++; // select reads [0,m_maxFd).
+}
+
+/* This function is the heart of the communication between parent and child.
+ * When ready for more data, the child (see MessageReceiverForSource) requests
+ * data through a AF_UNIX socket message.  The parent will then assign the next
+ * chunk of data by sending a message back.
+ *
+ * Additionally, this function also monitors the read-side of the pipe fd from the child.
+ * If the child dies unexpectedly, the pipe will be selected as ready for read and
+ * will return EPIPE when read from.  Further, if the child thinks the parent has died
+ * (defined as waiting more than 1s for a response), it will write a single byte to
+ * the pipe.  If the parent has died, the child will get a EPIPE and throw an exception.
+ * If still alive, the parent will read the byte and ignore it.
+ *
+ * Note this function is complemented by the SIGCHLD handler of the controller (see EventProcessor.cc)
+ * as currently only the SIGCHLD handler can distinguish between success and failure cases.
+ */
+
+void
+MessageSenderToSource::operator()() {
+  multicore::MessageForParent childMsg;
+  LogInfo("ForkingController") << "I am controller";
+  //this is the master and therefore the controller
+  
+  multicore::MessageForSource sndmsg;
+  sndmsg.startIndex = 0;
+  sndmsg.nIndices = m_nEventsToProcess;
+  do {
+    
+    fd_set readSockets, errorSockets;
+    // Wait for a request from a child for events.
+    memcpy(&readSockets, &m_socketSet, sizeof(m_socketSet));
+    memcpy(&errorSockets, &m_socketSet, sizeof(m_socketSet));
+    // Note that we don't timeout; may be reconsidered in the future.
+    ssize_t rc;
+    while (((rc = select(m_maxFd, &readSockets, NULL, &errorSockets, NULL)) < 0) && (errno == EINTR)) {}
+    if (rc < 0) {
+      std::cerr << "select failed; should be impossible due to preconditions.\n";
+      abort();
+      break;
+    }
+
+    // Read the message from the child.
+    for (int idx=0; idx<m_maxFd; idx++) {
+
+      // Handle errors
+      if (FD_ISSET(idx, &errorSockets)) {
+        LogInfo("ForkingController") << "Error on socket " << idx;
+        FD_CLR(idx, &m_socketSet);
+        close(idx);
+        // See if it was the watchdog pipe that died.
+        for (std::vector<int>::const_iterator it = m_childrenPipes.begin(); it != m_childrenPipes.end(); it++) {
+          if (*it == idx) {
+            m_aliveChildren--;
+          }
+        }
+        continue;
+      }
+      
+      if (!FD_ISSET(idx, &readSockets)) {
+        continue;
+      }
+
+      // See if this FD is a child watchdog pipe.  If so, read from it to prevent
+      // writes from blocking.
+      bool is_pipe = false;
+      for (std::vector<int>::const_iterator it = m_childrenPipes.begin(), itEnd = m_childrenPipes.end(); it != itEnd; it++) {
+          if (*it == idx) {
+            is_pipe = true;
+            char buf;
+            while (((rc = read(idx, &buf, 1)) < 0) && (errno == EINTR)) {}
+            if (rc <= 0) {
+              m_aliveChildren--;
+              FD_CLR(idx, &m_socketSet);
+              close(idx);
+            }
+          }
+      }
+
+      // Only execute this block if the FD is a socket for sending the child work.
+      if (!is_pipe) {
+        while (((rc = recv(idx, reinterpret_cast<char*>(&childMsg),childMsg.sizeForBuffer() , 0)) < 0) && (errno == EINTR)) {}
+        if (rc < 0) {
+          FD_CLR(idx, &m_socketSet);
+          close(idx);
+          continue;
+        }
+      
+        // Tell the child what events to process.
+        // If 'send' fails, then the child process has failed (any other possibilities are
+        // eliminated because we are using fixed-size messages with Unix datagram sockets).
+        // Thus, the SIGCHLD handler will fire and set child_fail = true.
+        while (((rc = send(idx, (char *)(&sndmsg), multicore::MessageForSource::sizeForBuffer(), 0)) < 0) && (errno == EINTR)) {}
+        if (rc < 0) {
+          FD_CLR(idx, &m_socketSet);
+          close(idx);
+          continue;
+        }
+        //std::cout << "Sent chunk starting at " << sndmsg.startIndex << " to child, length " << sndmsg.nIndices << std::endl;
+        sndmsg.startIndex += sndmsg.nIndices;
+      }
+    }
+  
+  } while (m_aliveChildren > 0);
+
+  // Close the fds not closed above, so each one is closed exactly once.
+  for (int idx=0; idx<m_maxFd; idx++) {
+    if (FD_ISSET(idx, &m_socketSet)) {
+      FD_CLR(idx, &m_socketSet);
+      close(idx);
+    }
+  }
+  
+  return;
+}
+
+}
+}
@@ -20,10 +20,13 @@
 
 // system include files
 #include <memory>
+#include <vector>
 
 // user include files
+#include "FWCore/Framework/interface/ProductRegistryHelper.h"
 #include "FWCore/Framework/src/WorkerT.h"
 #include "FWCore/Framework/src/OutputModuleCommunicatorT.h"
+#include "FWCore/Utilities/interface/TypeID.h"
 
 // forward declarations
 namespace edm {
@@ -32,6 +35,9 @@ namespace edm {
   class ProductRegistry;
   class ExceptionToActionTable;
   class PreallocationConfiguration;
+  namespace stream {
+    template<typename T> class ProducingModuleAdaptorBase;
+  }
 
   namespace maker {
     class ModuleHolder {
@@ -46,6 +52,8 @@ namespace edm {
       virtual void preallocate(PreallocationConfiguration const& ) = 0;
       virtual void registerProductsAndCallbacks(ProductRegistry*)=0;
       virtual void replaceModuleFor(Worker*) const = 0;
+      ///adds the types the module produces and consumes, known once it is constructed
+      virtual void addProductTypes(std::vector<TypeID>&) const = 0;
 
       virtual std::unique_ptr<OutputModuleCommunicator> createOutputModuleCommunicator() = 0;
     protected:
@@ -76,12 +84,37 @@ namespace edm {
       void registerProductsAndCallbacks(ProductRegistry* iReg) override {
         m_mod->registerProductsAndCallbacks(module().get(),iReg);
       }
+
+      void addProductTypes(std::vector<TypeID>& oTypes) const override {
+        ProductRegistryHelper const* helper = productRegistryHelper(m_mod.get());
+        if(helper != nullptr) {
+          for(auto const& item : helper->typeLabelList()) {
+            oTypes.push_back(item.typeID_);
+          }
+        }
+        for(auto const& info : m_mod->consumesInfo()) {
+          oTypes.push_back(info.type());
+        }
+      }
       
       std::unique_ptr<OutputModuleCommunicator>
       createOutputModuleCommunicator() override {
         return std::move(OutputModuleCommunicatorT<T>::createIfNeeded(m_mod.get()));
       }
     private:
+      //the stream modules declare the products, all alike
+      template<typename U>
+      static ProductRegistryHelper const* productRegistryHelper(stream::ProducingModuleAdaptorBase<U> const* iMod) {
+        return iMod->m_streamModules[0];
+      }
+      static ProductRegistryHelper const* productRegistryHelper(ProductRegistryHelper const* iMod) {
+        return iMod;
+      }
+      //analyzers and output modules
+      static ProductRegistryHelper const* productRegistryHelper(void const*) {
+        return nullptr;
+      }
+
       std::shared_ptr<T> m_mod;
 
     };
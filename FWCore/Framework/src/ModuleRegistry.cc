@@ -11,10 +11,15 @@
 //
 
 // system include files
+#include <set>
+
+#include "tbb/parallel_for.h"
 
 // user include files
 #include "FWCore/Framework/src/ModuleRegistry.h"
 #include "FWCore/Framework/src/Factory.h"
+#include "FWCore/Framework/src/ModuleHolder.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 
 
 namespace edm {
@@ -25,8 +30,18 @@ namespace edm {
                             signalslot::Signal<void(ModuleDescription const&)>& iPost) {
     auto modItr = labelToModule_.find(moduleLabel);
     if(modItr == labelToModule_.end()) {
-      auto modPtr=
-      Factory::get()->makeModule(p,iPre,iPost);
+      std::shared_ptr<maker::ModuleHolder> modPtr;
+      auto itConstructed = constructedModules_.find(moduleLabel);
+      if(itConstructed != constructedModules_.end()) {
+        ConstructedModule constructed = itConstructed->second;
+        constructedModules_.erase(itConstructed);
+        if(constructed.exception_) {
+          std::rethrow_exception(constructed.exception_);
+        }
+        modPtr = Factory::get()->completeModule(p,constructed.module_,iPre,iPost);
+      } else {
+        modPtr = Factory::get()->makeModule(p,iPre,iPost);
+      }
       
       // Transfer ownership of worker to the registry
       labelToModule_[moduleLabel] = modPtr;
@@ -35,6 +50,54 @@ namespace edm {
     return get_underlying_safe(modItr->second);
   }
   
+  void
+  ModuleRegistry::constructModulesConcurrently(std::vector<std::pair<std::string, MakeModuleParams>> const& iModules) {
+    //Finding the makers loads the plugins, which is done serially
+    std::vector<std::pair<std::string, MakeModuleParams> const*> toConstruct;
+    std::set<std::string> labels;
+    for(auto const& labelAndParams : iModules) {
+      std::string const& label = labelAndParams.first;
+      if(labelToModule_.find(label) != labelToModule_.end() or
+         constructedModules_.find(label) != constructedModules_.end() or
+         not labels.insert(label).second) {
+        continue;
+      }
+      try {
+        if(not Factory::get()->canConstructConcurrently(labelAndParams.second)) {
+          continue;
+        }
+      } catch(...) {
+        //the module will be made serially, which reports the problem
+        continue;
+      }
+      toConstruct.push_back(&labelAndParams);
+    }
+
+    std::vector<ConstructedModule> constructed(toConstruct.size());
+    ServiceToken token = ServiceRegistry::instance().presentToken();
+    tbb::parallel_for(std::size_t(0), toConstruct.size(), [&](std::size_t i) {
+      ServiceRegistry::Operate operate(token);
+      try {
+        constructed[i].module_ = Factory::get()->constructModule(toConstruct[i]->second);
+      } catch(...) {
+        constructed[i].exception_ = std::current_exception();
+      }
+    });
+
+    for(std::size_t i = 0; i < toConstruct.size(); ++i) {
+      constructedModules_.emplace(toConstruct[i]->first, constructed[i]);
+    }
+  }
+
+  void
+  ModuleRegistry::addProductTypesOfConstructedModules(std::vector<TypeID>& oTypes) const {
+    for(auto const& labelAndModule : constructedModules_) {
+      if(labelAndModule.second.module_) {
+        labelAndModule.second.module_->addProductTypes(oTypes);
+      }
+    }
+  }
+
   maker::ModuleHolder*
   ModuleRegistry::replaceModule(std::string const& iModuleLabel,
                                 edm::ParameterSet const& iPSet,
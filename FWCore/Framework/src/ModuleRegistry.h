@@ -19,18 +19,22 @@
 //
 
 // system include files
+#include <exception>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 // user include files
+#include "FWCore/Framework/src/MakeModuleParams.h"
 #include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/Utilities/interface/TypeID.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
 
 // forward declarations
 namespace edm {
   class ParameterSet;
-  struct MakeModuleParams;
   class ModuleDescription;
   class PreallocationConfiguration;
   namespace maker {
@@ -45,6 +49,15 @@ namespace edm {
                                                    signalslot::Signal<void(ModuleDescription const&)>& iPre,
                                                    signalslot::Signal<void(ModuleDescription const&)>& iPost);
     
+    ///Constructs in parallel the modules which allow it. getModule then only
+    /// completes them, so the modules are still registered in the order they are asked for.
+    /// An exception thrown while constructing a module is rethrown by getModule.
+    void constructModulesConcurrently(std::vector<std::pair<std::string, MakeModuleParams>> const& iModules);
+
+    ///adds the types produced and consumed by the modules constructed by
+    /// constructModulesConcurrently and not yet completed
+    void addProductTypesOfConstructedModules(std::vector<TypeID>& oTypes) const;
+
     maker::ModuleHolder* replaceModule(std::string const& iModuleLabel,
                                        edm::ParameterSet const& iPSet,
                                        edm::PreallocationConfiguration const&);
@@ -57,7 +70,13 @@ namespace edm {
       }
     }
   private:
+    struct ConstructedModule {
+      std::shared_ptr<maker::ModuleHolder> module_;
+      std::exception_ptr exception_;
+    };
+
     std::map<std::string, edm::propagate_const<std::shared_ptr<maker::ModuleHolder>>> labelToModule_;
+    std::map<std::string, ConstructedModule> constructedModules_;
   };
 }
 
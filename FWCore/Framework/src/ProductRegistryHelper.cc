@@ -3,7 +3,6 @@
 ----------------------------------------------------------------------*/
 
 #include "FWCore/Framework/interface/ProductRegistryHelper.h"
-#include "FWCore/PluginManager/interface/PluginCapabilities.h"
 #include "DataFormats/Provenance/interface/ProductRegistry.h"
 #include "DataFormats/Provenance/interface/BranchDescription.h"
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
@@ -11,8 +10,46 @@
 #include "FWCore/Utilities/interface/TypeWithDict.h"
 #include "FWCore/Utilities/interface/DictionaryTools.h"
 #include "TClass.h"
+#include "tbb/concurrent_unordered_map.h"
 
 namespace edm {
+  namespace {
+    struct TypeIDHasher {
+      size_t operator()(TypeID const& tid) const {
+        tbb::tbb_hash<std::string> hasher;
+        return hasher(std::string(tid.name()));
+      }
+    };
+
+    // The TClass of each product type found to have a dictionary. The same types
+    // are registered for every SubProcess and by many modules, and each
+    // TClass::GetClass is a search of the ROOT type tables.
+    typedef tbb::concurrent_unordered_map<TypeID, TClass*, TypeIDHasher> ClassMap;
+
+    // false if the type has no dictionary; oClass is null for the fundamental types
+    bool findProductClass(TypeID const& iType, TClass*& oClass) {
+      static ClassMap s_productClasses;
+      auto itFound = s_productClasses.find(iType);
+      if(itFound != s_productClasses.end()) {
+        oClass = itFound->second;
+        return true;
+      }
+      // This should load the dictionary if not already loaded.
+      TClass* cl = TClass::GetClass(iType.typeInfo());
+      if(!hasDictionary(iType.typeInfo())) {
+        // a second attempt to load
+        TypeWithDict::byName(iType.userClassName());
+        cl = TClass::GetClass(iType.typeInfo());
+      }
+      if(!hasDictionary(iType.typeInfo())) {
+        return false;
+      }
+      s_productClasses.insert(ClassMap::value_type(iType, cl));
+      oClass = cl;
+      return true;
+    }
+  }
+
   ProductRegistryHelper::~ProductRegistryHelper() { }
 
   ProductRegistryHelper::TypeLabelList & ProductRegistryHelper::typeLabelList() {
@@ -27,13 +64,8 @@ namespace edm {
                                        bool iIsListener) {
     TypeSet missingTypes;
     for(TypeLabelList::const_iterator p = iBegin; p != iEnd; ++p) {
-      // This should load the dictionary if not already loaded.
-      TClass::GetClass(p->typeID_.typeInfo());
-      if(!hasDictionary(p->typeID_.typeInfo())) {
-        // a second attempt to load
-        TypeWithDict::byName(p->typeID_.userClassName());
-      }
-      if(!hasDictionary(p->typeID_.typeInfo())) {
+      TClass* cl = nullptr;
+      if(!findProductClass(p->typeID_, cl)) {
         throw Exception(errors::DictionaryNotFound)
            << "No data dictionary found for class:\n\n"
            <<  p->typeID_.className()
@@ -48,7 +80,7 @@ namespace edm {
            << "you need to specify them in classes_def.xml.";
       }
 
-      TypeWithDict type(p->typeID_.typeInfo());
+      TypeWithDict type = cl != nullptr ? TypeWithDict(cl) : TypeWithDict(p->typeID_.typeInfo());
       BranchDescription pdesc(p->branchType_,
                               iDesc.moduleLabel(),
                               iDesc.processName(),
@@ -20,11 +20,14 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/PluginManager/interface/PluginCapabilities.h"
+#include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/ConvertException.h"
 #include "FWCore/Utilities/interface/ExceptionCollector.h"
 #include "FWCore/Utilities/interface/RandomNumberGenerator.h"
 #include "FWCore/Utilities/interface/TypeID.h"
+#include "FWCore/Utilities/interface/WrappedClassName.h"
 
 #include "boost/graph/graph_traits.hpp"
 #include "boost/graph/adjacency_list.hpp"
@@ -353,6 +356,79 @@ namespace edm {
       
     }
 
+    // Constructs, in parallel where the module types allow it, the modules which
+    // will be used: those on the paths and end paths and, when unscheduled
+    // execution is allowed, the other producers and filters. The StreamSchedule
+    // then completes them in its usual order.
+    void constructModulesConcurrently(ParameterSet& proc_pset,
+                                      service::TriggerNamesService& tns,
+                                      ProductRegistry& preg,
+                                      PreallocationConfiguration const& prealloc,
+                                      std::shared_ptr<ProcessConfiguration const> processConfiguration,
+                                      ModuleRegistry& moduleRegistry) {
+      vstring labels;
+      for(auto const& pathNames : {tns.getTrigPaths(), tns.getEndPaths()}) {
+        for(auto const& pathName : pathNames) {
+          for(auto const& name : proc_pset.getParameter<vstring>(pathName)) {
+            if(!name.empty() && (name[0] == '!' || name[0] == '-')) {
+              labels.push_back(name.substr(1));
+            } else {
+              labels.push_back(name);
+            }
+          }
+        }
+      }
+      ParameterSet const& opts = proc_pset.getUntrackedParameterSet("options", ParameterSet());
+      if(opts.getUntrackedParameter<bool>("allowUnscheduled", false)) {
+        for(auto const& label : proc_pset.getParameter<vstring>("@all_modules")) {
+          ParameterSet const* modulePSet = proc_pset.getPSetForUpdate(label);
+          if(modulePSet != nullptr) {
+            std::string const& modType = modulePSet->getParameter<std::string>("@module_edm_type");
+            if(modType == "EDProducer" || modType == "EDFilter") {
+              labels.push_back(label);
+            }
+          }
+        }
+      }
+
+      std::vector<std::pair<std::string, MakeModuleParams> > modules;
+      modules.reserve(labels.size());
+      for(auto const& label : labels) {
+        bool isTracked;
+        ParameterSet* modulePSet = proc_pset.getPSetForUpdate(label, isTracked);
+        //unknown labels are reported when the paths are filled
+        if(modulePSet != nullptr) {
+          modules.emplace_back(label, MakeModuleParams(modulePSet, preg, &prealloc, processConfiguration));
+        }
+      }
+      moduleRegistry.constructModulesConcurrently(modules);
+    }
+
+    // Loads in one batch the dictionaries of the products which the modules
+    // constructed in advance produce and consume, and of those already in the
+    // registry, which the output modules select from. The modules constructed
+    // serially load the dictionaries they need when they register.
+    void preloadProductDictionaries(ProductRegistry const& preg,
+                                    ModuleRegistry const& moduleRegistry) {
+      if(!edmplugin::PluginManager::isAvailable()) {
+        return;
+      }
+      std::vector<TypeID> types;
+      moduleRegistry.addProductTypesOfConstructedModules(types);
+      std::vector<std::string> classNames;
+      classNames.reserve(2*types.size() + preg.productList().size());
+      for(auto const& type : types) {
+        classNames.push_back(type.userClassName());
+        classNames.push_back(wrappedClassName(type.className()));
+      }
+      for(auto const& product : preg.productList()) {
+        classNames.push_back(wrappedClassName(product.second.className()));
+      }
+      std::sort(classNames.begin(), classNames.end());
+      classNames.erase(std::unique(classNames.begin(), classNames.end()), classNames.end());
+      edmplugin::PluginCapabilities::get()->preload(classNames);
+    }
+
     bool printDependencies(ParameterSet const& pset) {
       ParameterSet defopts;
       ParameterSet const& opts = pset.getUntrackedParameterSet("options", defopts);
@@ -399,6 +475,14 @@ namespace edm {
     endpathsAreActive_(true)
   {
     assert(0<prealloc.numberOfStreams());
+    //Off by default: the module construction signals are only sent when a module
+    // constructed concurrently is completed, so services which act on them (e.g.
+    // TFileService, RandomNumberGeneratorService, Timing) do not see the constructor
+    ParameterSet const& opts = proc_pset.getUntrackedParameterSet("options", ParameterSet());
+    if(prealloc.numberOfThreads() > 1 && opts.getUntrackedParameter<bool>("concurrentModuleConstruction", false)) {
+      constructModulesConcurrently(proc_pset, tns, preg, prealloc, processConfiguration, *moduleRegistry_);
+      preloadProductDictionaries(preg, *moduleRegistry_);
+    }
     streamSchedules_.reserve(prealloc.numberOfStreams());
     for(unsigned int i=0; i<prealloc.numberOfStreams();++i) {
       streamSchedules_.emplace_back(std::make_shared<StreamSchedule>(
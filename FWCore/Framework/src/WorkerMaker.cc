@@ -2,6 +2,7 @@
 #include "FWCore/Framework/src/WorkerMaker.h"
 #include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
 #include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageDrop.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/ConvertException.h"
 #include "FWCore/Utilities/interface/Exception.h"
@@ -9,6 +10,7 @@
 
 #include <sstream>
 #include <exception>
+#include <limits>
 namespace edm {
   
   Maker::~Maker() {
@@ -60,10 +62,8 @@ namespace edm {
     }
   }
   
-  std::shared_ptr<maker::ModuleHolder>
-  Maker::makeModule(MakeModuleParams const& p,
-                    signalslot::Signal<void(ModuleDescription const&)>& pre,
-                    signalslot::Signal<void(ModuleDescription const&)>& post) const {
+  void
+  Maker::validateConfiguration(MakeModuleParams const& p) const {
     ConfigurationDescriptions descriptions(baseType());
     fillDescriptions(descriptions);
     try {
@@ -75,6 +75,13 @@ namespace edm {
     catch (cms::Exception & iException) {
       throwValidationException(p, iException);
     }
+  }
+
+  std::shared_ptr<maker::ModuleHolder>
+  Maker::makeModule(MakeModuleParams const& p,
+                    signalslot::Signal<void(ModuleDescription const&)>& pre,
+                    signalslot::Signal<void(ModuleDescription const&)>& post) const {
+    validateConfiguration(p);
     p.pset_->registerIt();
     
     ModuleDescription md = createModuleDescription(p);
@@ -106,6 +113,83 @@ namespace edm {
     return module;
   }
   
+  std::shared_ptr<maker::ModuleHolder>
+  Maker::constructModule(MakeModuleParams const& p) const {
+    validateConfiguration(p);
+    p.pset_->registerIt();
+
+    std::string const& moduleType = p.pset_->getParameter<std::string>("@module_type");
+    std::string const& moduleLabel = p.pset_->getParameter<std::string>("@module_label");
+    //The construction signals are only sent when the module is completed, so give
+    // the messages from the constructor the context MessageLogger would have set.
+    // The ModuleDescription, and so the module id, is not made yet: no id is used.
+    MessageDrop* messageDrop = MessageDrop::instance();
+    messageDrop->setModuleWithPhase(moduleType, moduleLabel, std::numeric_limits<unsigned int>::max(), "@ctor");
+    //debugModules and the suppress* options of the module, restored afterwards as MessageLogger does
+    bool const debugEnabled = messageDrop->debugEnabled;
+    bool const infoEnabled = messageDrop->infoEnabled;
+    bool const warningEnabled = messageDrop->warningEnabled;
+    bool const errorEnabled = messageDrop->errorEnabled;
+    if(MessageDrop::enableForModule) {
+      MessageDrop::enableForModule(*messageDrop, moduleLabel);
+    }
+    auto unEstablish = [&]() {
+      messageDrop->setSinglet("AfterModConstruction");
+      messageDrop->debugEnabled = debugEnabled;
+      messageDrop->infoEnabled = infoEnabled;
+      messageDrop->warningEnabled = warningEnabled;
+      messageDrop->errorEnabled = errorEnabled;
+    };
+    std::shared_ptr<maker::ModuleHolder> module;
+    try {
+      convertException::wrap([&]() {
+        module = makeModule(*(p.pset_));
+        module->preallocate(*(p.preallocate_));
+      });
+    }
+    catch(cms::Exception & iException){
+      unEstablish();
+      //the ModuleDescription is only made when the module is completed
+      std::ostringstream ost;
+      ost << "Constructing module: class=" << moduleType << " label='" << moduleLabel << "'";
+      iException.addContext(ost.str());
+      throw;
+    }
+    unEstablish();
+    return module;
+  }
+
+  std::shared_ptr<maker::ModuleHolder>
+  Maker::completeModule(MakeModuleParams const& p,
+                        std::shared_ptr<maker::ModuleHolder> module,
+                        signalslot::Signal<void(ModuleDescription const&)>& pre,
+                        signalslot::Signal<void(ModuleDescription const&)>& post) const {
+    ModuleDescription md = createModuleDescription(p);
+    bool postCalled = false;
+    try {
+      convertException::wrap([&]() {
+        pre(md);
+        module->setModuleDescription(md);
+        module->registerProductsAndCallbacks(p.reg_);
+        // if exception then post will be called in the catch block
+        postCalled = true;
+        post(md);
+      });
+    }
+    catch(cms::Exception & iException){
+      if(!postCalled) {
+        try {
+          post(md);
+        }
+        catch (...) {
+          // If post throws an exception ignore it because we are already handling another exception
+        }
+      }
+      throwConfigurationException(md, iException);
+    }
+    return module;
+  }
+
   std::unique_ptr<Worker> 
   Maker::makeWorker(ExceptionToActionTable const* actions,
                     maker::ModuleHolder const* mod) const {
@@ -19,6 +19,50 @@ namespace edm {
   class ParameterSet;
   class Maker;
   class ExceptionToActionTable;
+  namespace global {
+    class EDProducerBase;
+    class EDFilterBase;
+    class EDAnalyzerBase;
+  }
+  namespace stream {
+    class EDProducerAdaptorBase;
+    class EDFilterAdaptorBase;
+    class EDAnalyzerAdaptorBase;
+  }
+
+  namespace maker {
+    //Legacy and one modules may rely on being constructed one at a time, e.g. by
+    // sharing resources with other modules, so only the global and stream
+    // modules are constructed concurrently
+    template<typename T>
+    struct ConstructsConcurrently {
+      static bool constexpr value = false;
+    };
+    template<>
+    struct ConstructsConcurrently<edm::global::EDProducerBase> {
+      static bool constexpr value = true;
+    };
+    template<>
+    struct ConstructsConcurrently<edm::global::EDFilterBase> {
+      static bool constexpr value = true;
+    };
+    template<>
+    struct ConstructsConcurrently<edm::global::EDAnalyzerBase> {
+      static bool constexpr value = true;
+    };
+    template<>
+    struct ConstructsConcurrently<edm::stream::EDProducerAdaptorBase> {
+      static bool constexpr value = true;
+    };
+    template<>
+    struct ConstructsConcurrently<edm::stream::EDFilterAdaptorBase> {
+      static bool constexpr value = true;
+    };
+    template<>
+    struct ConstructsConcurrently<edm::stream::EDAnalyzerAdaptorBase> {
+      static bool constexpr value = true;
+    };
+  }
   
   class Maker {
   public:
@@ -30,6 +74,18 @@ namespace edm {
                                        maker::ModuleHolder const*) const;
 
     std::shared_ptr<maker::ModuleHolder> makeReplacementModule(edm::ParameterSet const& p) const { return makeModule(p);}
+
+    //makeModule done in two steps: constructModule validates the configuration,
+    // constructs and preallocates the module and may be called concurrently for
+    // different modules; completeModule gives the module its description and
+    // registers its products and must be called in the order the modules are used
+    std::shared_ptr<maker::ModuleHolder> constructModule(MakeModuleParams const&) const;
+    std::shared_ptr<maker::ModuleHolder> completeModule(MakeModuleParams const&,
+                                                        std::shared_ptr<maker::ModuleHolder> iModule,
+                                                        signalslot::Signal<void(ModuleDescription const&)>& iPre,
+                                                        signalslot::Signal<void(ModuleDescription const&)>& iPost) const;
+    //true for the module types which do not need to be constructed serially (global and stream modules)
+    virtual bool canBeConstructedConcurrently() const = 0;
 protected:
       
     ModuleDescription createModuleDescription(MakeModuleParams const& p) const;
@@ -42,6 +98,8 @@ protected:
 
     void validateEDMType(std::string const& edmType, MakeModuleParams const& p) const;
 
+    void validateConfiguration(MakeModuleParams const& p) const;
+
   private:
     virtual void fillDescriptions(ConfigurationDescriptions& iDesc) const = 0;
     virtual std::shared_ptr<maker::ModuleHolder> makeModule(edm::ParameterSet const& p) const  = 0;
@@ -63,6 +121,7 @@ protected:
     virtual std::unique_ptr<Worker> makeWorker(ExceptionToActionTable const* actions, ModuleDescription const& md, maker::ModuleHolder const* mod) const;
     virtual std::shared_ptr<maker::ModuleHolder> makeModule(edm::ParameterSet const& p) const;
     virtual const std::string& baseType() const;
+    virtual bool canBeConstructedConcurrently() const;
   };
 
   template <class T>
@@ -101,6 +160,11 @@ protected:
   const std::string& WorkerMaker<T>::baseType() const {
     return T::baseType();
   }
+
+  template<class T>
+  bool WorkerMaker<T>::canBeConstructedConcurrently() const {
+    return maker::ConstructsConcurrently<typename T::ModuleType>::value;
+  }
   
 }
 
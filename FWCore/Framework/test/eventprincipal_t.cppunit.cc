@@ -25,6 +25,7 @@ Test of the EventPrincipal class.
 #include "FWCore/Framework/interface/LuminosityBlockPrincipal.h"
 #include "FWCore/Framework/interface/RunPrincipal.h"
 #include "FWCore/Framework/interface/HistoryAppender.h"
+#include "FWCore/Framework/interface/ProductDeletedException.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/GetPassID.h"
@@ -49,6 +50,7 @@ class test_ep: public CppUnit::TestFixture {
   CPPUNIT_TEST(failgetManybyTypeTest);
   CPPUNIT_TEST(failgetbyInvalidIdTest);
   CPPUNIT_TEST(failgetProvenanceTest);
+  CPPUNIT_TEST(getItTest);
   CPPUNIT_TEST_SUITE_END();
 public:
   void setUp();
@@ -58,6 +60,7 @@ public:
   void failgetManybyTypeTest();
   void failgetbyInvalidIdTest();
   void failgetProvenanceTest();
+  void getItTest();
 
 private:
 
@@ -257,3 +260,24 @@ void test_ep::failgetProvenanceTest() {
   edm::BranchID id;
   CPPUNIT_ASSERT_THROW(pEvent_->getProvenance(id, nullptr), edm::Exception);
 }
+
+void test_ep::getItTest() {
+  edm::BranchID bid;
+  for(auto const& product : pProductRegistry_->productList()) {
+    if(product.second.processName() == "USER2") bid = product.second.branchID();
+  }
+  edm::ProductID const pid = pEvent_->branchIDToProductID(bid);
+  CPPUNIT_ASSERT(pid.isValid());
+
+  // the second time from the table of the products already found
+  edm::WrapperBase const* product = pEvent_->getIt(pid);
+  CPPUNIT_ASSERT(product != nullptr);
+  CPPUNIT_ASSERT(pEvent_->getIt(pid) == product);
+  CPPUNIT_ASSERT(pEvent_->getByProductID(pid).wrapper() == product);
+
+  edm::ProductID const notpresent(pid.processIndex(), pid.productIndex() + 1000);
+  CPPUNIT_ASSERT(pEvent_->getIt(notpresent) == nullptr);
+
+  pEvent_->deleteProduct(bid);
+  CPPUNIT_ASSERT_THROW(pEvent_->getIt(pid), edm::ProductDeletedException);
+}
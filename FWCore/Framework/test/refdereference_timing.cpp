@@ -0,0 +1,124 @@
+// Times the dereference of Refs made fresh for every access, which is what
+// loops over collections of Refs or Ptrs to a product do: each new RefCore
+// asks the EventPrincipal for the product.  Compares the lookup through
+// EventPrincipal::getIt, which remembers the products already found in the
+// event, with the full lookup by ProductID it replaces.
+//
+//   refdereference_timing [number of dereferences]
+
+#include "DataFormats/Common/interface/RefProd.h"
+#include "DataFormats/Common/interface/Wrapper.h"
+#include "DataFormats/Provenance/interface/BranchDescription.h"
+#include "DataFormats/Provenance/interface/BranchIDListHelper.h"
+#include "DataFormats/Provenance/interface/EventAuxiliary.h"
+#include "DataFormats/Provenance/interface/LuminosityBlockAuxiliary.h"
+#include "DataFormats/Provenance/interface/ProcessConfiguration.h"
+#include "DataFormats/Provenance/interface/ProcessHistoryRegistry.h"
+#include "DataFormats/Provenance/interface/ProductProvenance.h"
+#include "DataFormats/Provenance/interface/ProductRegistry.h"
+#include "DataFormats/Provenance/interface/RunAuxiliary.h"
+#include "DataFormats/Provenance/interface/ThinnedAssociationsHelper.h"
+#include "DataFormats/Provenance/interface/Timestamp.h"
+#include "DataFormats/TestObjects/interface/ToyProducts.h"
+#include "FWCore/Framework/interface/EventPrincipal.h"
+#include "FWCore/Framework/interface/HistoryAppender.h"
+#include "FWCore/Framework/interface/LuminosityBlockPrincipal.h"
+#include "FWCore/Framework/interface/RunPrincipal.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/GetPassID.h"
+#include "FWCore/Utilities/interface/GlobalIdentifier.h"
+#include "FWCore/Utilities/interface/TypeWithDict.h"
+#include "FWCore/Version/interface/GetReleaseVersion.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+  typedef std::chrono::steady_clock Clock;
+
+  double nsPerCall(Clock::time_point start, unsigned long n) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / n;
+  }
+
+  unsigned int const nProducts = 200;
+}
+
+int main(int argc, char* argv[]) {
+  unsigned long const nDereferences = argc > 1 ? std::atol(argv[1]) : 10000000;
+
+  std::string const processName("USER");
+  edm::ParameterSet processParams;
+  processParams.addParameter<std::string>("@process_name", processName);
+  processParams.registerIt();
+  edm::ProcessConfiguration process(processName, processParams.id(), edm::getReleaseVersion(), edm::getPassID());
+
+  // a process with a realistic number of products, all of the same type
+  edm::TypeWithDict productType(typeid(edmtest::IntProduct));
+  edm::ParameterSet modParams;
+  modParams.addParameter<std::string>("@module_type", "IntProducer");
+  modParams.addParameter<std::string>("@module_label", "producer");
+  modParams.registerIt();
+  auto registry = std::make_shared<edm::ProductRegistry>();
+  for(unsigned int i = 0; i < nProducts; ++i) {
+    edm::BranchDescription branch(edm::InEvent, "producer", processName,
+                                  productType.userClassName(), productType.friendlyClassName(),
+                                  "instance" + std::to_string(i), "IntProducer", modParams.id(), productType);
+    registry->addProduct(branch);
+  }
+  registry->setFrozen();
+  auto branchIDListHelper = std::make_shared<edm::BranchIDListHelper>();
+  branchIDListHelper->updateFromRegistry(*registry);
+  auto thinnedAssociationsHelper = std::make_shared<edm::ThinnedAssociationsHelper>();
+
+  edm::HistoryAppender historyAppender;
+  edm::Timestamp now(1234567UL);
+  auto runAux = std::make_shared<edm::RunAuxiliary>(1, now, now);
+  auto rp = std::make_shared<edm::RunPrincipal>(runAux, registry, process, &historyAppender, 0);
+  auto lumiAux = std::make_shared<edm::LuminosityBlockAuxiliary>(rp->run(), 1, now, now);
+  auto lbp = std::make_shared<edm::LuminosityBlockPrincipal>(lumiAux, registry, process, &historyAppender, 0);
+  lbp->setRunPrincipal(rp);
+  edm::EventPrincipal event(registry, branchIDListHelper, thinnedAssociationsHelper, process, &historyAppender, 0);
+  edm::ProcessHistoryRegistry phr;
+  event.fillEventPrincipal(edm::EventAuxiliary(edm::EventID(1, 1, 1), edm::createGlobalIdentifier(), now, true), phr);
+  event.setLuminosityBlockPrincipal(lbp);
+
+  std::vector<edm::ProductID> pids;
+  int value = 0;
+  for(auto const& product : registry->productList()) {
+    edm::BranchDescription const& branch = product.second;
+    event.put(branch,
+              std::make_unique<edm::Wrapper<edmtest::IntProduct> >(std::make_unique<edmtest::IntProduct>(++value)),
+              edm::ProductProvenance(branch.branchID(), std::vector<edm::BranchID>()));
+    pids.push_back(event.branchIDToProductID(branch.branchID()));
+  }
+
+  long sumLookup = 0, sumRef = 0;
+  Clock::time_point start = Clock::now();
+  for(unsigned long i = 0; i < nDereferences; ++i) {
+    edm::WrapperBase const* w = event.getByProductID(pids[i % pids.size()]).wrapper();
+    sumLookup += static_cast<edm::Wrapper<edmtest::IntProduct> const*>(w)->product()->value;
+  }
+  double const tLookup = nsPerCall(start, nDereferences);
+
+  start = Clock::now();
+  for(unsigned long i = 0; i < nDereferences; ++i) {
+    edm::RefProd<edmtest::IntProduct> ref(pids[i % pids.size()], &event);
+    sumRef += ref->value;
+  }
+  double const tRef = nsPerCall(start, nDereferences);
+
+  std::cout << std::fixed << std::setprecision(1)
+            << "products:                          " << pids.size() << "\n"
+            << "lookup by ProductID:               " << tLookup << " ns\n"
+            << "new RefProd dereference (getIt):   " << tRef << " ns\n";
+  if(sumLookup != sumRef) {
+    std::cerr << "the two lookups found different products\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,46 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_concurrent_construction_cfg.py
+F2=${LOCAL_TEST_DIR}/test_concurrent_construction_on_cfg.py
+
+(cmsRun -n 4 $F1 ) > serial_construction.log 2>&1 || die "Failure using $F1" $?
+(cmsRun -n 4 $F2 ) > concurrent_construction.log 2>&1 || die "Failure using $F2" $?
+
+# line number of the first line of log $1 matching $2, 0 if none
+function lineOf { grep -n -m 1 "$2" $1 | cut -d: -f1 ; }
+
+for label in a b c d; do
+  pre="starting: constructing module with label '$label'"
+  post="finished: constructing module with label '$label'"
+  for log in serial_construction.log concurrent_construction.log; do
+    [ $(grep -c "$pre" $log) -eq 1 ] || die "'$pre' not found once in $log" 1
+    [ $(grep -c "$post" $log) -eq 1 ] || die "'$post' not found once in $log" 1
+    [ $(lineOf $log "$pre") -lt $(lineOf $log "$post") ] || die "construction signals of $label out of order in $log" 1
+  done
+done
+
+# suppressWarning applies to the constructor of d
+for log in serial_construction.log concurrent_construction.log; do
+  grep -q "ConstructionLogProducer:d@ctor" $log && die "suppressed warning from the constructor of d in $log" 1
+done
+
+for label in a b c; do
+  pre="starting: constructing module with label '$label'"
+  post="finished: constructing module with label '$label'"
+  ctor="ConstructionLogProducer:$label@ctor"
+  for log in serial_construction.log concurrent_construction.log; do
+    # the message from the constructor carries the module label
+    grep -q "$ctor" $log || die "no message with context $ctor in $log" 1
+  done
+  # constructed one at a time, the constructor runs between the signals
+  [ $(lineOf serial_construction.log "$pre") -lt $(lineOf serial_construction.log "$ctor") ] || die "$label constructed before its preModuleConstruction" 1
+  [ $(lineOf serial_construction.log "$ctor") -lt $(lineOf serial_construction.log "$post") ] || die "$label constructed after its postModuleConstruction" 1
+done
+
+# the modules are completed in the same order, with the same ids, either way
+grep "constructing module with label" serial_construction.log > serial_signals.log
+grep "constructing module with label" concurrent_construction.log > concurrent_signals.log
+diff serial_signals.log concurrent_signals.log || die "construction signals differ when constructing concurrently" $?
@@ -10,3 +10,6 @@ F3=${LOCAL_TEST_DIR}/test_one_modules_cfg.py
 (cmsRun $F2 ) || die "Failure using $F2" $?
 (cmsRun $F3 ) || die "Failure using $F3" $?
 
+#with more than one thread (see run_concurrent_construction.sh for concurrent construction)
+(cmsRun -n 4 $F1 ) || die "Failure using $F1 with 4 threads" $?
+(cmsRun -n 4 $F2 ) || die "Failure using $F2 with 4 threads" $?
@@ -19,6 +19,7 @@ for testing purposes only.
 #include "FWCore/Utilities/interface/GlobalIdentifier.h"
 #include "FWCore/Framework/interface/Event.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 
@@ -568,6 +569,19 @@ struct Dummy {
     }
   };
 
+  //logs from its constructor, to check the context of the message
+  class ConstructionLogProducer : public edm::global::EDProducer<> {
+  public:
+    explicit ConstructionLogProducer(edm::ParameterSet const&) {
+      edm::LogWarning("ConstructionLog") << "in the constructor";
+      produces<int>();
+    }
+
+    void produce(edm::StreamID, edm::Event& e, edm::EventSetup const&) const override {
+      e.put(std::make_unique<int>(1));
+    }
+  };
+
 }
 }
 
@@ -580,4 +594,4 @@ DEFINE_FWK_MODULE(edmtest::global::TestBeginRunProducer);
 DEFINE_FWK_MODULE(edmtest::global::TestEndRunProducer);
 DEFINE_FWK_MODULE(edmtest::global::TestBeginLumiBlockProducer);
 DEFINE_FWK_MODULE(edmtest::global::TestEndLumiBlockProducer);
-
+DEFINE_FWK_MODULE(edmtest::global::ConstructionLogProducer);
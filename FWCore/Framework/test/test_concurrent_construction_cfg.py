@@ -0,0 +1,36 @@
+# Modules which log from their constructor, with the Tracer reporting the
+# construction signals. The warnings of d are suppressed. Constructed one at a time, as by default; see
+# test_concurrent_construction_on_cfg.py for concurrent construction.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTCONSTRUCTION")
+
+process.options = cms.untracked.PSet(
+    numberOfStreams = cms.untracked.uint32(4)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(4)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.MessageLogger = cms.Service("MessageLogger",
+    suppressWarning = cms.untracked.vstring('d'),
+    destinations = cms.untracked.vstring('cout'),
+    cout = cms.untracked.PSet(
+        threshold = cms.untracked.string('INFO'),
+        noTimeStamps = cms.untracked.bool(True)
+    )
+)
+
+process.Tracer = cms.Service("Tracer")
+
+process.a = cms.EDProducer("edmtest::global::ConstructionLogProducer")
+process.b = cms.EDProducer("edmtest::global::ConstructionLogProducer")
+process.c = cms.EDProducer("edmtest::global::ConstructionLogProducer")
+process.d = cms.EDProducer("edmtest::global::ConstructionLogProducer")
+
+process.p = cms.Path(process.a+process.b)
+process.p2 = cms.Path(process.c+process.d)
@@ -0,0 +1,5 @@
+# test_concurrent_construction_cfg.py with the modules constructed concurrently
+
+from FWCore.Framework.test.test_concurrent_construction_cfg import *
+
+process.options.concurrentModuleConstruction = cms.untracked.bool(True)
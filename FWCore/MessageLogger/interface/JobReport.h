@@ -243,7 +243,7 @@ namespace edm {
          */
         void flushFiles(void);
 
-        JobReportImpl(std::ostream* iOst): printedReadBranches_(false), ost_(iOst) {}
+        JobReportImpl(std::ostream* iOst): printedReadBranches_(false), releasingResourcesForFork_(false), ost_(iOst) {}
 
         std::ostream const* ost() const {return get_underlying_safe(ost_);}
         std::ostream*& ost() {return get_underlying_safe(ost_);}
@@ -255,6 +255,8 @@ namespace edm {
         std::map<std::string, long long> readBranchesSecFile_;
         tbb::concurrent_unordered_map<std::string, AtomicLongLong> readBranchesSecSource_;
         bool printedReadBranches_;
+        // the parent is closing its input files before forking; the children read them again and report them
+        bool releasingResourcesForFork_;
         std::vector<InputFile>::size_type lastOpenedPrimaryInputFile_;
         edm::propagate_const<std::ostream*> ost_;
       };
@@ -273,8 +275,14 @@ namespace edm {
 
       void parentBeforeFork(std::string const& jobReportFile, unsigned int numberOfChildren);
 
+      /// The primary input files closed from now on until the fork are not written to the report of the parent
+      void preForkReleaseResources();
+
       void parentAfterFork(std::string const& jobReportFile);
 
+      /// Adds the reports of the children, and the lumi sections they read, to the report of the parent
+      void parentAfterChildrenEnded(std::string const& jobReportFile, unsigned int numberOfChildren);
+
       /// Report that an input file has been opened.
       /// The returned Token should be used for later identification
       /// of this file.
@@ -0,0 +1,77 @@
+#ifndef MessageLogger_MessageCategorySuppression_h
+#define MessageLogger_MessageCategorySuppression_h
+
+#include "FWCore/MessageLogger/interface/ELseverityLevel.h"
+#include "FWCore/MessageLogger/interface/ELstring.h"
+#include "FWCore/MessageLogger/interface/ErrorSummaryEntry.h"
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// ----------------------------------------------------------------------
+//
+// MessageCategorySuppression.h - the (category, severity) pairs that no
+//		    destination would ever output or count, resolved by the
+//		    MessageLogger scribe whenever it is configured.
+//
+//   MessageSender consults this table before creating the ErrorObj, so a
+//   suppressed LogDebug, LogInfo or LogWarning costs one lookup instead of
+//   formatting the message, queueing it and having every destination
+//   reject it.  The number of messages suppressed this way is kept per
+//   category and severity.
+//
+//   The table is immutable once published; a reconfiguration publishes a
+//   new one.  Only severities below ELerror are ever suppressed here.
+//
+// ----------------------------------------------------------------------
+
+namespace edm {
+
+class MessageCategorySuppression
+{
+public:
+  MessageCategorySuppression();
+  ~MessageCategorySuppression();
+
+  // --- building, by the scribe, before the table is published:
+  void suppress( ELstring const & category, ELseverityLevel const & sev );
+  bool empty() const { return entries_.empty(); }
+
+  // --- publish a table: messages are checked against it from now on
+  static void publish( std::unique_ptr<MessageCategorySuppression> table );
+
+  // --- true, and counted, if the message would be discarded anyway
+  static bool suppressed( ELseverityLevel const & sev, ELstring const & category )
+  {
+    MessageCategorySuppression const * table =
+      current_.load(std::memory_order_acquire);
+    if ( table == nullptr ) return false;
+    return table->check( sev, category );
+  }
+
+  // --- number of messages suppressed so far, per category and severity
+  static std::vector<ErrorSummaryEntry> suppressedCounts();
+
+private:
+  struct Entry {
+    Entry();
+    Entry( Entry const & other );
+    bool suppressed[ELseverityLevel::nLevels];
+    mutable std::atomic<unsigned int> count[ELseverityLevel::nLevels];
+  };
+
+  bool check( ELseverityLevel const & sev, ELstring const & category ) const;
+
+  MessageCategorySuppression( MessageCategorySuppression const& );
+  MessageCategorySuppression& operator=( MessageCategorySuppression const& );
+
+  std::unordered_map<ELstring, Entry> entries_;
+
+  static std::atomic<MessageCategorySuppression const *> current_;
+};
+
+}        // end of namespace edm
+
+#endif  // MessageLogger_MessageCategorySuppression_h
@@ -28,6 +28,7 @@
 
 // system include files
 
+#include <functional>
 #include <string>
 
 // Change log
@@ -69,6 +70,10 @@
 //
 // 13  wmtan 11/11/11   Make non-copyable to satisfy Coverity. Would otherwise
 //                      need special copy ctor and copy assignment operator.
+//
+// 14  10/18/26         Add enableForModule, so the framework can apply
+//                      debugModules and the suppress* options to a module
+//                      it constructs outside of the construction signals
 
 
 // user include files
@@ -112,6 +117,9 @@ public:
   CMS_THREAD_SAFE static bool debugAlwaysSuppressed;			// change log 9
   CMS_THREAD_SAFE static bool infoAlwaysSuppressed;			// change log 9
   CMS_THREAD_SAFE static bool warningAlwaysSuppressed;			// change log 9
+  // set by the MessageLogger service: sets the enabled flags for the
+  // module with this label, as at the start of each of its transitions
+  CMS_THREAD_SAFE static std::function<void(MessageDrop&, std::string const&)> enableForModule; // change log 14
 private:
   edm::propagate_const<messagedrop::StringProducerWithPhase*> spWithPhase;
   edm::propagate_const<messagedrop::StringProducerPath*> spPath;
@@ -367,24 +367,82 @@ namespace edm {
         *(impl_->ost_) << "  <ChildProcessFile>" << ofilename.str() << "</ChildProcessFile>\n";
       }
       *(impl_->ost_) << "</ChildProcessFiles>\n";
-      *(impl_->ost_) << "</FrameworkJobReport>\n";
-      std::ofstream* p = dynamic_cast<std::ofstream *>(impl_->ost());
-      if(p) {
-        p->close();
-      }
+      // the report stays open, the reports of the children are added to it once they have ended
+      *(impl_->ost_) << std::flush;
     }
   }
 
+  void
+  JobReport::preForkReleaseResources() {
+    impl_->releasingResourcesForFork_ = true;
+  }
+
   void
   JobReport::parentAfterFork(std::string const& /*jobReportFile*/) {
   }
 
+  void
+  JobReport::parentAfterChildrenEnded(std::string const& jobReportFile, unsigned int numberOfChildren) {
+    if(!impl_->ost_) return;
+    std::ostream& os = *(impl_->ost_);
+    std::map<RunNumber, RunReport> inputRuns;
+    os << "<ChildProcessReports>\n";
+    for(unsigned int i = 0; i < numberOfChildren; ++i) {
+      std::ostringstream ofilename;
+      toFileName(jobReportFile, i, numberOfChildren, ofilename);
+      os << "<ChildProcessReport Index=\"" << i << "\">\n";
+      TiXmlDocument childReport;
+      TiXmlElement const* root = nullptr;
+      if(childReport.LoadFile(ofilename.str())) {
+        root = childReport.FirstChildElement("FrameworkJobReport");
+      }
+      if(root == nullptr) {
+        // the child did not end its report, e.g. it was killed
+        os << "<ReadError>" << TiXmlText(ofilename.str()) << "</ReadError>\n";
+      } else {
+        for(TiXmlElement const* element = root->FirstChildElement(); element != nullptr; element = element->NextSiblingElement()) {
+          os << *element << "\n";
+        }
+        // the lumi sections read by all the children together
+        for(TiXmlElement const* inputFile = root->FirstChildElement("InputFile"); inputFile != nullptr;
+            inputFile = inputFile->NextSiblingElement("InputFile")) {
+          TiXmlElement const* runs = inputFile->FirstChildElement("Runs");
+          if(runs == nullptr) continue;
+          for(TiXmlElement const* run = runs->FirstChildElement("Run"); run != nullptr; run = run->NextSiblingElement("Run")) {
+            int runNumber = 0;
+            if(run->QueryIntAttribute("ID", &runNumber) != TIXML_SUCCESS) continue;
+            RunReport& runReport = inputRuns.emplace(runNumber, RunReport{static_cast<RunNumber>(runNumber), {}}).first->second;
+            for(TiXmlElement const* lumi = run->FirstChildElement("LumiSection"); lumi != nullptr;
+                lumi = lumi->NextSiblingElement("LumiSection")) {
+              int lumiSection = 0;
+              if(lumi->QueryIntAttribute("ID", &lumiSection) == TIXML_SUCCESS) {
+                runReport.lumiSections.insert(lumiSection);
+              }
+            }
+          }
+        }
+      }
+      os << "</ChildProcessReport>\n";
+    }
+    os << "<Runs>";
+    for(auto const& runReport : inputRuns) {
+      os << runReport.second;
+    }
+    os << "\n</Runs>\n";
+    os << "</ChildProcessReports>\n" << std::flush;
+  }
+
   void
   JobReport::childAfterFork(std::string const& jobReportFile, unsigned int childIndex, unsigned int numberOfChildren) {
+    impl_->releasingResourcesForFork_ = false;
     std::ofstream* p = dynamic_cast<std::ofstream*>(impl_->ost());
     if(!p) return;
     std::ostringstream ofilename;
     toFileName(jobReportFile, childIndex, numberOfChildren, ofilename);
+    // this is the parent's report, which the parent flushed before forking
+    if(p->is_open()) {
+      p->close();
+    }
     p->open(ofilename.str().c_str());
     *p << "<FrameworkJobReport>\n";
   }
@@ -454,6 +512,10 @@ namespace edm {
     JobReport::InputFile& f = impl_->getInputFileForToken(inputType, fileToken);
     f.fileHasBeenClosed = true;
     if(inputType == InputType::Primary) {
+      if(impl_->releasingResourcesForFork_) {
+        // no event was read from it yet, the children report what they read
+        return;
+      }
       impl_->writeInputFile(f);
     } else {
       {
@@ -0,0 +1,91 @@
+#include "FWCore/MessageLogger/interface/MessageCategorySuppression.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+
+using namespace edm;
+
+// The tables that were ever published: a table can still be in use by a
+// message being sent while a newer one is published, and its counts are
+// part of the summary, so they are kept until the end of the job.
+[[cms::thread_safe]] static std::mutex publishedTablesMutex;
+[[cms::thread_safe]] static std::vector<std::unique_ptr<MessageCategorySuppression> > publishedTables;
+
+std::atomic<MessageCategorySuppression const *> MessageCategorySuppression::current_{nullptr};
+
+MessageCategorySuppression::Entry::Entry()
+{
+  for (int k = 0; k < ELseverityLevel::nLevels; ++k) {
+    suppressed[k] = false;
+    count[k].store(0, std::memory_order_relaxed);
+  }
+}
+
+MessageCategorySuppression::Entry::Entry( Entry const & other )
+{
+  for (int k = 0; k < ELseverityLevel::nLevels; ++k) {
+    suppressed[k] = other.suppressed[k];
+    count[k].store(other.count[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+}
+
+MessageCategorySuppression::MessageCategorySuppression()
+: entries_()
+{ }
+
+MessageCategorySuppression::~MessageCategorySuppression()
+{ }
+
+void MessageCategorySuppression::suppress( ELstring const & category,
+                                           ELseverityLevel const & sev )
+{
+  if ( sev >= ELerror ) return;
+  entries_[category].suppressed[sev.getLevel()] = true;
+}
+
+bool MessageCategorySuppression::check( ELseverityLevel const & sev,
+                                        ELstring const & category ) const
+{
+  auto e = entries_.find( category );
+  if ( e == entries_.end() ) return false;
+  int const lev = sev.getLevel();
+  if ( !e->second.suppressed[lev] ) return false;
+  e->second.count[lev].fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void MessageCategorySuppression::publish( std::unique_ptr<MessageCategorySuppression> table )
+{
+  std::lock_guard<std::mutex> guard(publishedTablesMutex);
+  MessageCategorySuppression const * p = nullptr;
+  if ( table && !table->empty() ) {
+    p = table.get();
+    publishedTables.push_back( std::move(table) );
+  }
+  current_.store( p, std::memory_order_release );
+}
+
+std::vector<ErrorSummaryEntry> MessageCategorySuppression::suppressedCounts()
+{
+  std::map<std::pair<ELstring,int>, unsigned int> counts;
+  {
+    std::lock_guard<std::mutex> guard(publishedTablesMutex);
+    for ( auto const & table : publishedTables ) {
+      for ( auto const & e : table->entries_ ) {
+        for (int k = 0; k < ELseverityLevel::nLevels; ++k) {
+          unsigned int n = e.second.count[k].load(std::memory_order_relaxed);
+          if ( n > 0 ) counts[std::make_pair(e.first, k)] += n;
+        }
+      }
+    }
+  }
+  std::vector<ErrorSummaryEntry> v;
+  for ( auto const & c : counts ) {
+    v.emplace_back( c.first.first, ELstring(),
+                    ELseverityLevel(ELseverityLevel::ELsev_(c.first.second)), c.second );
+  }
+  std::sort( v.begin(), v.end() );
+  return v;
+}
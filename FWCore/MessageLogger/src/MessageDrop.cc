@@ -54,6 +54,7 @@ using namespace edm;
 bool MessageDrop::debugAlwaysSuppressed=false;		// change log 2
 bool MessageDrop::infoAlwaysSuppressed=false;	 	// change log 2
 bool MessageDrop::warningAlwaysSuppressed=false; 	// change log 2
+std::function<void(MessageDrop&, std::string const&)> MessageDrop::enableForModule{};
 std::string MessageDrop::jobMode{};
 
 MessageDrop *
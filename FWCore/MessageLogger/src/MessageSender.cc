@@ -3,6 +3,7 @@
 #include "FWCore/MessageLogger/interface/MessageDrop.h"
 
 #include "FWCore/MessageLogger/interface/ErrorSummaryEntry.h"
+#include "FWCore/MessageLogger/interface/MessageCategorySuppression.h"
 
 #include <algorithm>
 #include <cassert>
@@ -27,6 +28,9 @@
 // 2  mf 11/2/10	Use new moduleContext method of MessageDrop:
 //			see MessageServer/src/MessageLogger.cc change 17.
 //			
+// 3  Check MessageCategorySuppression before creating the ErrorObj, so
+//    that messages no destination would output are never formatted.
+//
 
 
 using namespace edm;
@@ -84,10 +88,19 @@ namespace  {
 //Each item in the vector is reserved for a different Stream
 [[cms::thread_safe]] static std::vector<tbb::concurrent_unordered_map<ErrorSummaryMapKey, AtomicUnsignedInt,ErrorSummaryMapKey::key_hash>> errorSummaryMaps;
 
+static bool suppressedByCategory( ELseverityLevel const & sev, ELstring const & id )
+{
+  if ( sev >= ELerror ) return false;
+  // warnings still have to reach the per-event error summary when it is kept
+  if ( sev >= ELwarning && errorSummaryIsBeingKept.load(std::memory_order_acquire) )
+    return false;
+  return MessageCategorySuppression::suppressed( sev, id );
+}
+
 MessageSender::MessageSender( ELseverityLevel const & sev, 
 			      ELstring const & id,
 			      bool verbatim, bool suppressed )
-: errorobj_p( suppressed ? nullptr : new ErrorObj(sev,id,verbatim), ErrorObjDeleter())
+: errorobj_p( (suppressed || suppressedByCategory(sev,id)) ? nullptr : new ErrorObj(sev,id,verbatim), ErrorObjDeleter())	// change log 3
 {
   //std::cout << "MessageSender ctor; new ErrorObj at: " << errorobj_p << '\n';
 }
@@ -91,6 +91,10 @@ public:
 
   //Replaces ErrorLog which is no longer needed
   void log(edm::ErrorObj & msg);
+
+  // true if every attached destination would discard any message of this
+  // category and severity
+  bool alwaysDiscards( const ELseverityLevel & sev, const ELstring & category ) const;
   
   // ---  furnish/recall destinations:
   //
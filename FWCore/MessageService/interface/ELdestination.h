@@ -66,6 +66,10 @@ public:
 public:
   virtual ELdestination * clone() const = 0;
   virtual bool log( const edm::ErrorObj & msg );
+  // true only if no message of this category and severity, from any
+  // module, can ever be output or counted by this destination
+  virtual bool alwaysDiscards( const ELseverityLevel & sev,
+                               const ELstring & category ) const;
 
   virtual void summarization(
     		const edm::ELstring & title,
@@ -71,6 +71,7 @@ public:
 //
 public:
   bool add( const ELextendedID & xid );
+  bool neverReacts( const ELstring & id, const ELseverityLevel & sev ) const;
   void setTableLimit( int n );
 
 // -----  Control methods invoked by the framework:
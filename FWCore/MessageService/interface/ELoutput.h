@@ -72,6 +72,8 @@ public:
                 //-| ownership is passed to the new copy.
 
   virtual bool log( const edm::ErrorObj & msg );
+  virtual bool alwaysDiscards( const ELseverityLevel & sev,
+                               const ELstring & category ) const;
 
   // ---  Methods invoked through the ELdestControl handle:
   //
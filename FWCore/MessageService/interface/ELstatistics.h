@@ -77,6 +77,8 @@ public:
 		//-| ownership is passed to the new copy.
 
   virtual bool log( const edm::ErrorObj & msg );
+  virtual bool alwaysDiscards( const ELseverityLevel & sev,
+                               const ELstring & category ) const;
 
   // output( const ELstring & item, const ELseverityLevel & sev )
   // from base class
@@ -42,12 +42,14 @@
 namespace edm  {
 class ModuleDescription;
 class ParameterSet;
+struct MessageDrop;
 namespace service  {
 
 
 class MessageLogger {
 public:
   MessageLogger( ParameterSet const &, ActivityRegistry & );
+  ~MessageLogger();
 
   void  fillErrorObj(edm::ErrorObj& obj) const;
   bool  debugEnabled() const { return debugEnabled_; }
@@ -137,6 +139,8 @@ private:
   void  postPathEvent   ( StreamContext const&, PathContext const&, HLTPathStatus const&);
 
   // set up the module name in the message drop, and the enable/suppress info
+  void  establishEnables      ( MessageDrop* messageDrop,
+                                const std::string& moduleLabel ) const;
   void  establishModule       ( const ModuleDescription& desc,
   		                const char* whichPhase );
   void  unEstablishModule     ( const ModuleDescription& desc,
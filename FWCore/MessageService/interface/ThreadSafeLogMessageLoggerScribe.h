@@ -72,6 +72,7 @@ private:
                       , String const &  filename
 		      );
   void  configure_external_dests( );
+  void  configure_category_suppression( );
 
   template <class T>						// ChangeLog 11
   T getAparameter ( PSet const& p, std::string const & id, T const & def ) 
@@ -111,6 +112,7 @@ private:
   std::atomic<int>  count;			// changeLog 9
   std::atomic<bool> m_messageBeingSent;
   tbb::concurrent_queue<ErrorObj*> m_waitingMessages;
+  std::atomic<unsigned long> m_droppedMessages;	// inactive or purging
   
 };  // ThreadSafeLogMessageLoggerScribe
 
@@ -120,6 +120,16 @@ void ELadministrator::log(edm::ErrorObj & msg) {
 }
 
 
+bool ELadministrator::alwaysDiscards( const ELseverityLevel & sev,
+                                      const ELstring & category ) const  {
+  // with no destination, log() attaches one to cerr
+  if (sinks_.begin() == sinks_.end())  return false;
+  for (auto const& sink : sinks_)
+    if ( ! sink->alwaysDiscards( sev, category ) )  return false;
+  return true;
+}
+
+
 // ----------------------------------------------------------------------
 // ELadministrator functionality:
 // ----------------------------------------------------------------------
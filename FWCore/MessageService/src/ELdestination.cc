@@ -77,6 +77,9 @@ ELdestination::~ELdestination()  {
 
 bool ELdestination::log( const edm::ErrorObj &)  { return false; }
 
+bool ELdestination::alwaysDiscards( const ELseverityLevel &,
+                                    const ELstring & ) const  { return false; }
+
 
 // ----------------------------------------------------------------------
 // Methods invoked through the ELdestControl handle:
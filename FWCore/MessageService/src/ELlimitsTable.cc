@@ -73,6 +73,20 @@ ELlimitsTable::~ELlimitsTable()  {
 // Methods invoked by the logger:
 // ----------------------------------------------------------------------
 
+// True if messages of this category and severity are never reacted to:
+// the limit that add() would establish for them is zero.  When the counts
+// table has a size limit, messages beyond it bypass the limits altogether.
+bool ELlimitsTable::neverReacts( const ELstring & id, const ELseverityLevel & sev ) const  {
+  if ( tableLimit >= 0 )  return false;
+  int lim = -1;
+  ELmap_limits::const_iterator l = limits.find( id );
+  if ( l != limits.end() )  lim = (*l).second.limit;
+  if ( lim < 0 )  lim = severityLimits[sev.getLevel()];
+  if ( lim < 0 )  lim = wildcardLimit;
+  return lim == 0;
+}
+
+
 void ELlimitsTable::setTableLimit( int n )  { tableLimit = n; }
 
 
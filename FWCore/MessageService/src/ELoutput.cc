@@ -526,6 +526,14 @@ bool ELoutput::log( const edm::ErrorObj & msg )  {
 }  // log()
 
 
+bool ELoutput::alwaysDiscards( const ELseverityLevel & sev,
+                               const ELstring & category ) const  {
+  // the same tests as log(), short of the module ones
+  if ( sev < threshold )  return true;
+  return ( sev < ELsevere ) && limits.neverReacts( category, sev );
+}  // alwaysDiscards()
+
+
 // Remainder are from base class.
 
 // ----------------------------------------------------------------------
@@ -226,6 +226,13 @@ bool  ELstatistics::log( const edm::ErrorObj & msg )  {
 }  // log()
 
 
+bool  ELstatistics::alwaysDiscards( const ELseverityLevel & sev,
+                                    const ELstring & ) const  {
+  // every message above threshold is counted, whatever the limits
+  return sev < threshold;
+}  // alwaysDiscards()
+
+
 // ----------------------------------------------------------------------
 // Methods invoked through the ELdestControl handle
 // ----------------------------------------------------------------------
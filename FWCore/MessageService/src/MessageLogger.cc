@@ -71,6 +71,10 @@
 //
 // 20 fwyzard 7/06/11   Add support fro dropping LogError messages
 //                      on a per-module basis (needed at HLT)
+//
+// 21 10/18/26		Publish establishEnables as MessageDrop::enableForModule
+//			for the modules the framework constructs concurrently,
+//			outside of the module construction signals.
 
 // system include files
 // user include files
@@ -339,35 +343,36 @@ namespace edm {
       nonModule_infoEnabled    = messageDrop->infoEnabled;
       nonModule_warningEnabled = messageDrop->warningEnabled;
       nonModule_errorEnabled   = messageDrop->errorEnabled;
+      
+      // for modules constructed outside of the construction signals	// change log 21
+      MessageDrop::enableForModule =
+        [this](MessageDrop& drop, std::string const& moduleLabel) { establishEnables(&drop, moduleLabel); };
     } // ctor
     
+    edm::service::MessageLogger::
+    ~MessageLogger()
+    {
+      MessageDrop::enableForModule = nullptr;
+    }
+    
     //
     // Shared helper routines for establishing module name and enabling behavior
     //
     
     void
-    MessageLogger::establishModule(ModuleDescription const & desc,
-                                   const char * whichPhase)	// ChangeLog 13, 17
+    MessageLogger::establishEnables(MessageDrop* messageDrop,
+                                    std::string const & moduleLabel) const
     {
-      MessageDrop* messageDrop = MessageDrop::instance();
-      
-      // std::cerr << "establishModule( " << desc.moduleName() << ")\n";
-      // Change Log 17
-      messageDrop->setModuleWithPhase(desc.moduleName(), desc.moduleLabel(),
-                                      desc.id(), whichPhase );
-      // Removed caching per change 17 - caching is now done in MessageDrop.cc
-      // in theContext() method, and only happens if a message is actually issued.
-      
       if (!anyDebugEnabled_) {
         messageDrop->debugEnabled = false;
       } else if (everyDebugEnabled_) {
         messageDrop->debugEnabled = true;
       } else {
         messageDrop->debugEnabled =
-        debugEnabledModules_.count(desc.moduleLabel());
+        debugEnabledModules_.count(moduleLabel);
       }
       
-      auto it = suppression_levels_.find(desc.moduleLabel());
+      auto it = suppression_levels_.find(moduleLabel);
       if ( it != suppression_levels_.end() ) {
         messageDrop->debugEnabled  = messageDrop->debugEnabled
         && (it->second < ELseverityLevel::ELsev_success );
@@ -379,6 +384,22 @@ namespace edm {
         messageDrop->warningEnabled = true;
         messageDrop->errorEnabled   = true;
       }
+    } // establishEnables
+    
+    void
+    MessageLogger::establishModule(ModuleDescription const & desc,
+                                   const char * whichPhase)	// ChangeLog 13, 17
+    {
+      MessageDrop* messageDrop = MessageDrop::instance();
+      
+      // std::cerr << "establishModule( " << desc.moduleName() << ")\n";
+      // Change Log 17
+      messageDrop->setModuleWithPhase(desc.moduleName(), desc.moduleLabel(),
+                                      desc.id(), whichPhase );
+      // Removed caching per change 17 - caching is now done in MessageDrop.cc
+      // in theContext() method, and only happens if a message is actually issued.
+      
+      establishEnables(messageDrop, desc.moduleLabel());
     } // establishModule
     
     void
@@ -401,27 +422,7 @@ namespace edm {
       // Removed caching per change 17 - caching is now done in MessageDrop.cc
       // in theContext() method, and only happens if a message is actually issued.
       
-      if (!anyDebugEnabled_) {
-        messageDrop->debugEnabled = false;
-      } else if (everyDebugEnabled_) {
-        messageDrop->debugEnabled = true;
-      } else {
-        messageDrop->debugEnabled =
-        debugEnabledModules_.count(desc->moduleLabel());
-      }
-      
-      auto it = suppression_levels_.find(desc->moduleLabel());
-      if ( it != suppression_levels_.end() ) {
-        messageDrop->debugEnabled  = messageDrop->debugEnabled
-        && (it->second < ELseverityLevel::ELsev_success );
-        messageDrop->infoEnabled    = (it->second < ELseverityLevel::ELsev_info );
-        messageDrop->warningEnabled = (it->second < ELseverityLevel::ELsev_warning );
-        messageDrop->errorEnabled   = (it->second < ELseverityLevel::ELsev_error );
-      } else {
-        messageDrop->infoEnabled    = true;
-        messageDrop->warningEnabled = true;
-        messageDrop->errorEnabled   = true;
-      }
+      establishEnables(messageDrop, desc->moduleLabel());
     } // establishModule
     
     
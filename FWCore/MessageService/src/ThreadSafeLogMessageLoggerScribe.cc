@@ -21,6 +21,7 @@
 #include "FWCore/MessageLogger/interface/ConfigurationHandshake.h"
 #include "FWCore/MessageLogger/interface/MessageDrop.h"		// change log 37
 #include "FWCore/MessageLogger/interface/ELseverityLevel.h"	// change log 37
+#include "FWCore/MessageLogger/interface/MessageCategorySuppression.h"
 
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
@@ -48,6 +49,7 @@ namespace edm {
     , purge_mode (false)						// changeLog 32
     , count (false)							// changeLog 32
     , m_messageBeingSent(false)
+    , m_droppedMessages(0)
     {
     }
     
@@ -90,6 +92,9 @@ namespace edm {
           try {
             if(active && !purge_mode){
               log (errorobj_p);
+            } else {
+              ++m_droppedMessages;
+              delete errorobj_p;
             }
           }
           catch(cms::Exception& e)
@@ -124,6 +129,7 @@ namespace edm {
           try {
             extern_dests.push_back( static_cast<NamedDestination *>(operand) );
             configure_external_dests();
+            configure_category_suppression();
           }
           catch(cms::Exception& e)				// change log 21
           {
@@ -258,6 +264,8 @@ namespace edm {
       
       configure_external_dests();
       
+      configure_category_suppression();
+      
     }  // ThreadSafeLogMessageLoggerScribe::configure_errorlog()
     
     
@@ -800,6 +808,33 @@ namespace edm {
       
     }  // ThreadSafeLogMessageLoggerScribe::configure_external_dests
     
+    void
+    ThreadSafeLogMessageLoggerScribe::configure_category_suppression()
+    {
+      if( ! job_pset_p ) return;
+      
+      // the categories that can have limits of their own
+      vString  empty_vString;
+      vString  categories
+      = getAparameter<vString>(*job_pset_p, "categories", empty_vString);
+      vString  messageIDs
+      = getAparameter<vString>(*job_pset_p, "messageIDs", empty_vString);
+      copy_all( messageIDs, std::back_inserter(categories) );
+      copy_all( messageLoggerDefaults->categories, std::back_inserter(categories) );
+      
+      // a (category, severity) pair is suppressed at the source only if
+      // every destination, statistics ones included, would discard it
+      std::unique_ptr<MessageCategorySuppression> table(new MessageCategorySuppression);
+      ELseverityLevel const severities[] = { ELdebug, ELinfo, ELwarning };
+      for( auto const& cat : categories ) {
+        for( auto const& sev : severities ) {
+          if( admin_p->alwaysDiscards(sev, cat) ) table->suppress(cat, sev);
+        }
+      }
+      MessageCategorySuppression::publish( std::move(table) );
+      
+    }  // ThreadSafeLogMessageLoggerScribe::configure_category_suppression
+    
     void
     ThreadSafeLogMessageLoggerScribe::parseCategories (std::string const & s,
                                                        std::vector<std::string> & cats)
@@ -835,6 +870,14 @@ namespace edm {
       } else {
         statisticsDestControls[0].summaryForJobReport(sm);
       }
+      // messages which never reached the destinations
+      unsigned long suppressed = 0;
+      for( auto const& e : MessageCategorySuppression::suppressedCounts() ) {
+        suppressed += e.count;
+      }
+      if (suppressed > 0) sm["SuppressedMessages"] = suppressed;
+      unsigned long dropped = m_droppedMessages.load();
+      if (dropped > 0) sm["DroppedMessages"] = dropped;
     }
     
     
@@ -0,0 +1,63 @@
+#include "FWCore/MessageService/test/UnitTestClient_Y.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+// counts the times a message holding it is formatted
+struct FormattingCounter
+{
+  explicit FormattingCounter( int & n ) : n_(n) { }
+  int & n_;
+};
+
+std::ostream & operator<< ( std::ostream & os, FormattingCounter const & c )
+{
+  ++c.n_;
+  return os << "formatted";
+}
+
+}  // namespace
+
+namespace edmtest
+{
+
+void
+  UnitTestClient_Y::analyze( edm::Event      const & /*unused*/
+                           , edm::EventSetup const & /*unused*/
+                              )
+{
+  // limit 0 everywhere and below the statistics threshold: never formatted
+  int nSuppressed = 0;
+  for( int i = 0; i != 3; ++i ) {
+    edm::LogInfo   ("cat_suppressed") << "LogInfo was used to send this message, "
+                                      << FormattingCounter(nSuppressed);
+  }
+  // limit 0 in the output, but counted by the statistics
+  int nCounted = 0;
+  for( int i = 0; i != 3; ++i ) {
+    edm::LogWarning("cat_counted")    << "LogWarning was used to send this message, "
+                                      << FormattingCounter(nCounted);
+  }
+  if( nSuppressed != 0 || nCounted != 3 ) {
+    throw cms::Exception("UnitTestClient_Y")
+      << "cat_suppressed was formatted " << nSuppressed << " times instead of 0, "
+      << "cat_counted " << nCounted << " times instead of 3";
+  }
+
+  // a halted logger drops the messages it still receives
+  edm::HaltMessageLogging();
+  edm::LogWarning("cat_counted")      << "LogWarning was used to send this message after the halt";
+}  // MessageLoggerClient::analyze()
+
+
+}  // namespace edmtest
+
+
+using edmtest::UnitTestClient_Y;
+DEFINE_FWK_MODULE(UnitTestClient_Y);
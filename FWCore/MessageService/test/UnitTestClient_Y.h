@@ -0,0 +1,40 @@
+#ifndef FWCore_MessageService_test_UnitTestClient_Y_h
+#define FWCore_MessageService_test_UnitTestClient_Y_h
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+
+
+namespace edm {
+  class ParameterSet;
+}
+
+
+namespace edmtest
+{
+
+class UnitTestClient_Y
+  : public edm::EDAnalyzer
+{
+public:
+  explicit
+    UnitTestClient_Y( edm::ParameterSet const & )
+  { }
+
+  virtual
+    ~UnitTestClient_Y()
+  { }
+
+  virtual
+    void analyze( edm::Event      const & e
+                , edm::EventSetup const & c
+                );
+
+private:
+};
+
+
+}  // namespace edmtest
+
+
+#endif  // FWCore_MessageService_test_UnitTestClient_Y_h
@@ -0,0 +1,35 @@
+#!/bin/bash
+
+pushd $LOCAL_TMP_DIR
+
+status=0
+
+rm -f u37_output.log u37_statistics.log u37_jobreport.xml
+
+cmsRun -j u37_jobreport.xml -p $LOCAL_TEST_DIR/u37_cfg.py || exit $?
+
+# the messages with a limit of 0 are not output
+if grep -q "was used to send this message" u37_output.log
+then
+  echo u37_output.log holds messages of categories with a limit of 0
+  status=1
+fi
+
+for key in 'Category_w_cat_counted  Value="3"' 'SuppressedMessages  Value="3"' 'DroppedMessages  Value="1"'
+do
+  grep -q "<$key" u37_jobreport.xml
+  if [ $? -ne 0 ]
+  then
+    echo u37_jobreport.xml has no $key
+    status=1
+  fi
+done
+if grep -q "cat_suppressed" u37_jobreport.xml
+then
+  echo u37_jobreport.xml counts cat_suppressed in the statistics
+  status=1
+fi
+
+popd
+
+exit $status
@@ -0,0 +1,46 @@
+# Unit test configuration file for MessageLogger service:
+# Categories with a limit of 0.  Messages which neither the output nor
+# the statistics destination would take are dropped before they are
+# formatted, and counted as SuppressedMessages in the job report; the
+# ones the statistics destination takes are still counted there.
+# Messages sent after the logger is halted are counted as DroppedMessages.
+#
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+import FWCore.Framework.test.cmsExceptionsFatal_cff
+process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
+
+process.load("FWCore.MessageService.test.Services_cff")
+
+process.MessageLogger = cms.Service("MessageLogger",
+    categories = cms.untracked.vstring('cat_suppressed', 'cat_counted'),
+    destinations = cms.untracked.vstring('u37_output'),
+    statistics = cms.untracked.vstring('u37_statistics'),
+    messageSummaryToJobReport = cms.untracked.bool(True),
+    u37_statistics = cms.untracked.PSet(
+        threshold = cms.untracked.string('WARNING')
+    ),
+    u37_output = cms.untracked.PSet(
+        threshold = cms.untracked.string('INFO'),
+        noTimeStamps = cms.untracked.bool(True),
+        cat_suppressed = cms.untracked.PSet(
+            limit = cms.untracked.int32(0)
+        ),
+        cat_counted = cms.untracked.PSet(
+            limit = cms.untracked.int32(0)
+        )
+    )
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.sendSomeMessages = cms.EDAnalyzer("UnitTestClient_Y")
+
+process.p = cms.Path(process.sendSomeMessages)
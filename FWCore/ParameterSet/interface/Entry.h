@@ -161,6 +161,12 @@ namespace edm {
           std::vector<std::string> const& value, bool is_tracked);
 
     ~Entry();
+
+    Entry(Entry const&) = default;
+    Entry(Entry&&) = default;
+    Entry& operator=(Entry const&) = default;
+    Entry& operator=(Entry&&) = default;
+
     // encode
 
     std::string toString() const;
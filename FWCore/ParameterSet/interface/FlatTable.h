@@ -0,0 +1,108 @@
+#ifndef FWCore_ParameterSet_FlatTable_h
+#define FWCore_ParameterSet_FlatTable_h
+
+/** \class edm::pset::FlatTable
+
+ Storage for the parameters of a ParameterSet: a vector of (name, value)
+ pairs kept sorted by name.  It offers the subset of the std::map interface
+ the ParameterSet uses, iterating in the same order, but keeps its
+ elements contiguous: a lookup is a binary search over one block of memory
+ and building a table costs one allocation instead of one per parameter.
+
+ Parameters decoded from their string representation arrive in order and
+ are appended at the end; parameters added from a configuration are
+ inserted in place, which for the sizes of real parameter sets is cheaper
+ than the node allocation of a map.
+
+ Unlike with a std::map, inserting or erasing an element invalidates the
+ iterators and references to the other elements.  The values are expected
+ to be cheap to move; the nested ParameterSet of a ParameterSetEntry is
+ owned through a pointer, so it stays where it is when its entry moves.
+
+*/
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace edm {
+  namespace pset {
+
+    template<typename T>
+    class FlatTable {
+    public:
+      typedef std::string key_type;
+      typedef T mapped_type;
+      typedef std::pair<std::string, T> value_type;
+      typedef std::vector<value_type> container_type;
+      typedef typename container_type::iterator iterator;
+      typedef typename container_type::const_iterator const_iterator;
+      typedef typename container_type::size_type size_type;
+
+      FlatTable() : entries_() {}
+
+      iterator begin() {return entries_.begin();}
+      iterator end() {return entries_.end();}
+      const_iterator begin() const {return entries_.begin();}
+      const_iterator end() const {return entries_.end();}
+
+      bool empty() const {return entries_.empty();}
+      size_type size() const {return entries_.size();}
+      void reserve(size_type n) {entries_.reserve(n);}
+      void clear() {entries_.clear();}
+      void swap(FlatTable& other) {entries_.swap(other.entries_);}
+
+      iterator find(std::string const& key) {
+        iterator it = lowerBound(entries_.begin(), entries_.end(), key);
+        return (it != entries_.end() && it->first == key) ? it : entries_.end();
+      }
+
+      const_iterator find(std::string const& key) const {
+        const_iterator it = lowerBound(entries_.begin(), entries_.end(), key);
+        return (it != entries_.end() && it->first == key) ? it : entries_.end();
+      }
+
+      size_type count(std::string const& key) const {
+        return find(key) == end() ? 0 : 1;
+      }
+
+      /// inserts the element unless its name is already present
+      std::pair<iterator, bool> insert(value_type const& value) {
+        return emplace(value.first, value.second);
+      }
+
+      std::pair<iterator, bool> insert(value_type&& value) {
+        return emplace(std::move(value.first), std::move(value.second));
+      }
+
+      template<typename K, typename V>
+      std::pair<iterator, bool> emplace(K&& key, V&& value) {
+        // in order: append
+        if(entries_.empty() || entries_.back().first < key) {
+          entries_.emplace_back(std::forward<K>(key), std::forward<V>(value));
+          return std::make_pair(entries_.end() - 1, true);
+        }
+        iterator it = lowerBound(entries_.begin(), entries_.end(), key);
+        if(it != entries_.end() && it->first == key) {
+          return std::make_pair(it, false);
+        }
+        it = entries_.emplace(it, std::forward<K>(key), std::forward<V>(value));
+        return std::make_pair(it, true);
+      }
+
+      iterator erase(iterator it) {return entries_.erase(it);}
+
+    private:
+      template<typename It>
+      static It lowerBound(It b, It e, std::string const& key) {
+        return std::lower_bound(b, e, key,
+                                [](value_type const& v, std::string const& k) {return v.first < k;});
+      }
+
+      container_type entries_;
+    };
+
+  }
+}
+#endif
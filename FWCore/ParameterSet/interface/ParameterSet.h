@@ -14,6 +14,7 @@
 #include "DataFormats/Provenance/interface/ParameterSetID.h"
 #include "FWCore/ParameterSet/interface/Entry.h"
 #include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "FWCore/ParameterSet/interface/FlatTable.h"
 #include "FWCore/ParameterSet/interface/ParameterSetEntry.h"
 #include "FWCore/ParameterSet/interface/VParameterSetEntry.h"
 
@@ -55,6 +56,10 @@ namespace edm {
 
     ParameterSet& operator=(ParameterSet const& other);
 
+    ParameterSet(ParameterSet&& other) noexcept;
+
+    ParameterSet& operator=(ParameterSet&& other) noexcept;
+
     void swap(ParameterSet& other);
 
     void copyForModify(ParameterSet const& other);
@@ -79,10 +84,10 @@ namespace edm {
     VParameterSetEntry const* retrieveUntrackedVParameterSet(std::string const&) const;
     VParameterSetEntry const* retrieveUnknownVParameterSet(std::string const&) const;
 
-    void insertParameterSet(bool okay_to_replace, std::string const& name, ParameterSetEntry const& entry);
-    void insertVParameterSet(bool okay_to_replace, std::string const& name, VParameterSetEntry const& entry);
-    void insert(bool ok_to_replace, char const* , Entry const&);
-    void insert(bool ok_to_replace, std::string const&, Entry const&);
+    void insertParameterSet(bool okay_to_replace, std::string const& name, ParameterSetEntry entry);
+    void insertVParameterSet(bool okay_to_replace, std::string const& name, VParameterSetEntry entry);
+    void insert(bool ok_to_replace, char const* , Entry);
+    void insert(bool ok_to_replace, std::string const&, Entry);
     void augment(ParameterSet const& from);
     void copyFrom(ParameterSet const& from, std::string const& name);
     std::string getParameterAsString(std::string const& name) const;
@@ -250,13 +255,14 @@ namespace edm {
 
     std::unique_ptr<std::vector<ParameterSet> > popVParameterSet(std::string const& name);
 
-    typedef std::map<std::string, Entry> table;
+    // sorted by name, like the std::map they replace
+    typedef pset::FlatTable<Entry> table;
     table const& tbl() const {return tbl_;}
 
-    typedef std::map<std::string, ParameterSetEntry> psettable;
+    typedef pset::FlatTable<ParameterSetEntry> psettable;
     psettable const& psetTable() const {return psetTable_;}
 
-    typedef std::map<std::string, VParameterSetEntry> vpsettable;
+    typedef pset::FlatTable<VParameterSetEntry> vpsettable;
     vpsettable const& vpsetTable() const {return vpsetTable_;}
 
     ParameterSet*
@@ -29,6 +29,12 @@ namespace edm {
 
     ~ParameterSetEntry();
 
+    ParameterSetEntry(ParameterSetEntry const&) = default;
+    ParameterSetEntry& operator=(ParameterSetEntry const&) = default;
+    // moving an entry keeps the nested ParameterSet where it is
+    ParameterSetEntry(ParameterSetEntry&& other) noexcept;
+    ParameterSetEntry& operator=(ParameterSetEntry&& other) noexcept;
+
     std::string toString() const;
     void toString(std::string& result) const;
     void toDigest(cms::Digest &digest) const;
@@ -29,6 +29,11 @@ namespace edm {
 
     ~VParameterSetEntry();
 
+    VParameterSetEntry(VParameterSetEntry const&) = default;
+    VParameterSetEntry(VParameterSetEntry&&) = default;
+    VParameterSetEntry& operator=(VParameterSetEntry const&) = default;
+    VParameterSetEntry& operator=(VParameterSetEntry&&) = default;
+
     std::string toString() const;
     void toString(std::string& result) const;
     void toDigest(cms::Digest &digest) const;
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <sstream>
 #include <cassert>
+#include <utility>
 
 // ----------------------------------------------------------------------
 // class invariant checker
@@ -120,6 +121,20 @@ namespace edm {
     return *this;
   }
 
+  ParameterSet::ParameterSet(ParameterSet&& other) noexcept
+  : tbl_(),
+    psetTable_(),
+    vpsetTable_(),
+    id_() {
+    swap(other);
+  }
+
+  ParameterSet& ParameterSet::operator=(ParameterSet&& other) noexcept {
+    ParameterSet temp(std::move(other));
+    swap(temp);
+    return *this;
+  }
+
   void ParameterSet::copyForModify(ParameterSet const& other) {
     ParameterSet temp(other);
     swap(temp);
@@ -440,54 +455,54 @@ namespace edm {
   // ----------------------------------------------------------------------
 
   void
-  ParameterSet::insert(bool okay_to_replace, char const* name, Entry const& value) {
-    insert(okay_to_replace, std::string(name), value);
+  ParameterSet::insert(bool okay_to_replace, char const* name, Entry value) {
+    insert(okay_to_replace, std::string(name), std::move(value));
   }
 
   void
-  ParameterSet::insert(bool okay_to_replace, std::string const& name, Entry const& value) {
+  ParameterSet::insert(bool okay_to_replace, std::string const& name, Entry value) {
     // We should probably get rid of 'okay_to_replace', which will
     // simplify the logic in this function.
     table::iterator  it = tbl_.find(name);
 
     if(it == tbl_.end())  {
-      if(!tbl_.insert(std::make_pair(name, value)).second)
+      if(!tbl_.emplace(name, std::move(value)).second)
         throw Exception(errors::Configuration, "InsertFailure")
           << "cannot insert " << name
           << " into a ParameterSet\n";
     }
     else if(okay_to_replace)  {
-      it->second = value;
+      it->second = std::move(value);
     }
   }  // insert()
 
-  void ParameterSet::insertParameterSet(bool okay_to_replace, std::string const& name, ParameterSetEntry const& entry) {
+  void ParameterSet::insertParameterSet(bool okay_to_replace, std::string const& name, ParameterSetEntry entry) {
     // We should probably get rid of 'okay_to_replace', which will
     // simplify the logic in this function.
     psettable::iterator it = psetTable_.find(name);
 
     if(it == psetTable_.end()) {
-      if(!psetTable_.insert(std::make_pair(name, entry)).second)
+      if(!psetTable_.emplace(name, std::move(entry)).second)
         throw Exception(errors::Configuration, "InsertFailure")
           << "cannot insert " << name
           << " into a ParameterSet\n";
     } else if(okay_to_replace) {
-      it->second = entry;
+      it->second = std::move(entry);
     }
   }  // insert()
 
-  void ParameterSet::insertVParameterSet(bool okay_to_replace, std::string const& name, VParameterSetEntry const& entry) {
+  void ParameterSet::insertVParameterSet(bool okay_to_replace, std::string const& name, VParameterSetEntry entry) {
     // We should probably get rid of 'okay_to_replace', which will
     // simplify the logic in this function.
     vpsettable::iterator it = vpsetTable_.find(name);
 
     if(it == vpsetTable_.end()) {
-      if(!vpsetTable_.insert(std::make_pair(name, entry)).second)
+      if(!vpsetTable_.emplace(name, std::move(entry)).second)
         throw Exception(errors::Configuration, "InsertFailure")
           << "cannot insert " << name
           << " into a VParameterSet\n";
     } else if(okay_to_replace) {
-      it->second = entry;
+      it->second = std::move(entry);
     }
   }  // insert()
 
@@ -696,30 +711,30 @@ namespace edm {
       }
       if(rep[1] == 'Q') {
         ParameterSetEntry psetEntry(rep);
-        if(!psetTable_.insert(std::make_pair(name, psetEntry)).second) {
+        if(!psetTable_.emplace(name, std::move(psetEntry)).second) {
           return false;
         }
       } else if(rep[1] == 'q') {
         VParameterSetEntry vpsetEntry(rep);
-        if(!vpsetTable_.insert(std::make_pair(name, vpsetEntry)).second) {
+        if(!vpsetTable_.emplace(name, std::move(vpsetEntry)).second) {
           return false;
         }
       } else if(rep[1] == 'P') {
         Entry value(name, rep);
         ParameterSetEntry psetEntry(value.getPSet(), value.isTracked());
-        if(!psetTable_.insert(std::make_pair(name, psetEntry)).second) {
+        if(!psetTable_.emplace(name, std::move(psetEntry)).second) {
           return false;
         }
       } else if(rep[1] == 'p') {
         Entry value(name, rep);
         VParameterSetEntry vpsetEntry(value.getVPSet(), value.isTracked());
-        if(!vpsetTable_.insert(std::make_pair(name, vpsetEntry)).second) {
+        if(!vpsetTable_.emplace(name, std::move(vpsetEntry)).second) {
           return false;
         }
       } else {
         // form value and insert name/value pair
         Entry  value(name, rep);
-        if(!tbl_.insert(std::make_pair(name, value)).second) {
+        if(!tbl_.emplace(name, std::move(value)).second) {
           return false;
         }
       }
@@ -749,11 +764,11 @@ namespace edm {
     using std::placeholders::_1;
     std::vector<std::string> returnValue;
     std::transform(tbl_.begin(), tbl_.end(), back_inserter(returnValue),
-                   std::bind(&std::pair<std::string const, Entry>::first, _1));
+                   std::bind(&table::value_type::first, _1));
     std::transform(psetTable_.begin(), psetTable_.end(), back_inserter(returnValue),
-                   std::bind(&std::pair<std::string const, ParameterSetEntry>::first, _1));
+                   std::bind(&psettable::value_type::first, _1));
     std::transform(vpsetTable_.begin(), vpsetTable_.end(), back_inserter(returnValue),
-                   std::bind(&std::pair<std::string const, VParameterSetEntry>::first, _1));
+                   std::bind(&vpsettable::value_type::first, _1));
     return returnValue;
   }
 
@@ -797,7 +812,7 @@ namespace edm {
   ParameterSet::getAllParameterSetNames(std::vector<std::string>& output) const {
     using std::placeholders::_1;
     std::transform(psetTable_.begin(), psetTable_.end(), back_inserter(output),
-                   std::bind(&std::pair<std::string const, ParameterSetEntry>::first, _1));
+                   std::bind(&psettable::value_type::first, _1));
     return output.size();
   }
 */
@@ -5,6 +5,7 @@
 
 #include <cassert>
 #include <sstream>
+#include <utility>
 #include <iostream>
 namespace edm {
 
@@ -46,6 +47,22 @@ namespace edm {
     
   ParameterSetEntry::~ParameterSetEntry() {}
 
+  ParameterSetEntry::ParameterSetEntry(ParameterSetEntry&& other) noexcept
+  : isTracked_(other.isTracked_),
+    thePSet_(std::move(other.thePSet_)),
+    theID_()
+  {
+    theID_.swap(other.theID_);
+  }
+
+  ParameterSetEntry&
+  ParameterSetEntry::operator=(ParameterSetEntry&& other) noexcept {
+    isTracked_ = other.isTracked_;
+    thePSet_ = std::move(other.thePSet_);
+    theID_.swap(other.theID_);
+    return *this;
+  }
+
   void
   ParameterSetEntry::toString(std::string& result) const {
     result += isTracked() ? "+Q(" : "-Q(";
@@ -33,7 +33,13 @@ namespace edm {
   
     bool
     Registry::insertMapped(value_type const& v) {
-      return m_map.insert(std::make_pair(v.id(),v)).second;
+      // Identical parameter sets are registered many times while a
+      // configuration is processed; only copy the ones not seen yet.
+      key_type const id = v.id();
+      if(m_map.find(id) != m_map.end()) {
+        return false;
+      }
+      return m_map.insert(std::make_pair(id, v)).second;
     }
     
     void
@@ -17,11 +17,8 @@ namespace edm {
 
   VParameterSetEntry::VParameterSetEntry(std::vector<ParameterSet> const& vpset, bool isTracked) :
       tracked_(isTracked),
-      theVPSet_(new std::vector<ParameterSet>),
+      theVPSet_(new std::vector<ParameterSet>(vpset)),
       theIDs_() {
-    for (std::vector<ParameterSet>::const_iterator i = vpset.begin(), e = vpset.end(); i != e; ++i) {
-      theVPSet_->push_back(*i);
-    }
   }
 
   VParameterSetEntry::VParameterSetEntry(std::string const& rep) :
@@ -0,0 +1,152 @@
+// Times the configuration processing done at process start on a
+// synthetic menu shaped like an HLT menu: a process ParameterSet holding
+// a few thousand module ParameterSets, each with a few tens of
+// parameters, nested PSets and VPSets, many of them identical.
+//
+//   parameterSetStartupBenchmark [number of modules] [repetitions]
+//
+// Reports the time to build the process ParameterSet, to register it
+// (computing all the ParameterSetIDs), to encode and decode it, and to
+// look up every module parameter, and checks that the decoded
+// ParameterSet has the same ID.
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/Registry.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  typedef std::chrono::steady_clock Clock;
+
+  double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  }
+
+  edm::ParameterSet makeModule(unsigned int index) {
+    std::ostringstream label;
+    label << "hltModule" << index;
+
+    edm::ParameterSet module;
+    module.addParameter<std::string>("@module_type", (index % 7 == 0) ? "HLTFilter" : "HLTProducer");
+    module.addParameter<std::string>("@module_label", label.str());
+    module.addParameter<std::string>("@module_edm_type", (index % 7 == 0) ? "EDFilter" : "EDProducer");
+    module.addParameter<edm::InputTag>("src", edm::InputTag("hltModule", label.str()));
+    module.addParameter<std::vector<edm::InputTag> >("inputs",
+      std::vector<edm::InputTag>(4, edm::InputTag("hltInput", "", "HLT")));
+    module.addParameter<bool>("saveTags", index % 2 == 0);
+    module.addParameter<int>("triggerType", index % 100);
+    module.addParameter<int>("MinN", 1);
+    module.addParameter<unsigned int>("maxCandidates", 1000 + index % 10);
+    module.addParameter<double>("MinPt", 0.5 * (index % 80));
+    module.addParameter<double>("MaxEta", 2.5);
+    module.addParameter<double>("MinMass", -1.);
+    module.addParameter<std::vector<double> >("thresholds", std::vector<double>(12, 1.5));
+    module.addParameter<std::vector<int> >("ids", std::vector<int>(8, index % 3));
+    module.addParameter<std::vector<std::string> >("names",
+      std::vector<std::string>(6, "hltSomeCollectionName"));
+    module.addUntrackedParameter<bool>("debug", false);
+    module.addUntrackedParameter<int>("verbosity", 0);
+
+    // nested PSets, the same for most modules
+    edm::ParameterSet cuts;
+    cuts.addParameter<double>("ptMin", 1.);
+    cuts.addParameter<double>("etaMax", 2.4);
+    cuts.addParameter<double>("dzMax", 0.2);
+    cuts.addParameter<std::string>("quality", "highPurity");
+    module.addParameter<edm::ParameterSet>("cuts", cuts);
+
+    edm::ParameterSet services;
+    services.addParameter<std::vector<std::string> >("Propagators",
+      std::vector<std::string>(1, "SteppingHelixPropagatorAny"));
+    services.addUntrackedParameter<bool>("UseMuonNavigation", true);
+    module.addParameter<edm::ParameterSet>("ServiceParameters", services);
+
+    // a VPSet, specific to the module
+    std::vector<edm::ParameterSet> bins;
+    for(unsigned int i = 0; i < 4; ++i) {
+      edm::ParameterSet bin;
+      bin.addParameter<double>("low", i * 1.);
+      bin.addParameter<double>("high", (i + 1) * 1. + index % 5);
+      bin.addParameter<int>("n", i);
+      bins.push_back(bin);
+    }
+    module.addParameter<std::vector<edm::ParameterSet> >("bins", bins);
+    return module;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  unsigned int const nModules = argc > 1 ? std::atoi(argv[1]) : 3000;
+  unsigned int const nRepetitions = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  double tBuild = 0., tRegister = 0., tEncode = 0., tDecode = 0., tLookup = 0.;
+  size_t encodedSize = 0;
+  bool ok = true;
+
+  for(unsigned int rep = 0; rep < nRepetitions; ++rep) {
+    edm::pset::Registry::instance()->clear();
+
+    Clock::time_point start = Clock::now();
+    edm::ParameterSet process;
+    std::vector<std::string> labels;
+    labels.reserve(nModules);
+    for(unsigned int i = 0; i < nModules; ++i) {
+      edm::ParameterSet module = makeModule(i);
+      labels.push_back(module.getParameter<std::string>("@module_label"));
+      process.addParameter<edm::ParameterSet>(labels.back(), module);
+    }
+    process.addParameter<std::vector<std::string> >("@all_modules", labels);
+    process.addParameter<std::string>("@process_name", "HLT");
+    tBuild += msSince(start);
+
+    start = Clock::now();
+    process.registerIt();
+    tRegister += msSince(start);
+
+    start = Clock::now();
+    std::string encoded;
+    process.toString(encoded);
+    tEncode += msSince(start);
+    encodedSize = encoded.size();
+
+    start = Clock::now();
+    edm::ParameterSet decoded(encoded);
+    decoded.registerIt();
+    tDecode += msSince(start);
+    ok = ok && decoded.id() == process.id();
+
+    start = Clock::now();
+    double sum = 0.;
+    for(auto const& label : labels) {
+      edm::ParameterSet const& module = process.getParameterSet(label);
+      sum += module.getParameter<double>("MinPt");
+      sum += module.getParameter<edm::ParameterSet>("cuts").getParameter<double>("ptMin");
+      sum += module.getParameter<std::vector<edm::ParameterSet> >("bins").size();
+    }
+    tLookup += msSince(start);
+    ok = ok && sum > 0.;
+  }
+
+  double const n = nRepetitions > 0 ? nRepetitions : 1;
+  std::cout << std::fixed << std::setprecision(2)
+            << "modules:           " << nModules << "\n"
+            << "registered psets:  " << edm::pset::Registry::instance()->size() << "\n"
+            << "encoded size:      " << encodedSize << " bytes\n"
+            << "build:             " << tBuild / n << " ms\n"
+            << "register (IDs):    " << tRegister / n << " ms\n"
+            << "encode:            " << tEncode / n << " ms\n"
+            << "decode + register: " << tDecode / n << " ms\n"
+            << "lookup:            " << tLookup / n << " ms\n";
+  if(!ok) {
+    std::cerr << "decoded process ParameterSet has a different ID\n";
+    return 1;
+  }
+  return 0;
+}
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <iostream>
 #include <limits>
+#include <sstream>
 #include <string>
 #include <cassert>
 
@@ -39,6 +40,7 @@ class testps: public CppUnit::TestFixture
   CPPUNIT_TEST(testCopyFrom);
   CPPUNIT_TEST(testGetParameterAsString);
   CPPUNIT_TEST(calculateIDTest);
+  CPPUNIT_TEST(testFlatStorage);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -65,6 +67,7 @@ public:
   void testCopyFrom();
   void testGetParameterAsString();
   void calculateIDTest();
+  void testFlatStorage();
   // Still more to do...
 private:
 };
@@ -631,4 +634,55 @@ void testps::testGetParameterAsString()
   CPPUNIT_ASSERT(vpsetStr == vpsetStr2);
 }
 
+void testps::testFlatStorage()
+{
+  // parameters added out of order are iterated in name order
+  edm::ParameterSet ps;
+  ps.addParameter<int>("c", 3);
+  ps.addParameter<int>("a", 1);
+  ps.addParameter<int>("b", 2);
+  ps.addParameter<int>("a", 4);
+  CPPUNIT_ASSERT(ps.tbl().size() == 3);
+  std::string names;
+  for(auto const& item : ps.tbl()) {
+    names += item.first;
+  }
+  CPPUNIT_ASSERT(names == "abc");
+  CPPUNIT_ASSERT(ps.getParameter<int>("a") == 4);
+  CPPUNIT_ASSERT(ps.tbl().find("d") == ps.tbl().end());
+
+  // a nested set obtained for update stays valid while its parent grows
+  edm::ParameterSet inner;
+  inner.addParameter<int>("i", 1);
+  ps.addParameter<edm::ParameterSet>("m", inner);
+  edm::ParameterSet* held = ps.getPSetForUpdate("m");
+  for(int i = 0; i < 100; ++i) {
+    std::ostringstream name;
+    name << (i % 2 ? "a" : "z") << i;
+    ps.addParameter<edm::ParameterSet>(name.str(), inner);
+  }
+  CPPUNIT_ASSERT(held == ps.getPSetForUpdate("m"));
+  held->addParameter<int>("j", 2);
+  CPPUNIT_ASSERT(ps.getParameterSet("m").getParameter<int>("j") == 2);
+
+  // the string representation, and so the ID, are unchanged by the
+  // order in which the parameters were added
+  edm::ParameterSet reversed;
+  for(int i = 99; i >= 0; --i) {
+    std::ostringstream name;
+    name << (i % 2 ? "a" : "z") << i;
+    reversed.addParameter<edm::ParameterSet>(name.str(), inner);
+  }
+  reversed.addParameter<edm::ParameterSet>("m", ps.getParameterSet("m"));
+  reversed.addParameter<int>("b", 2);
+  reversed.addParameter<int>("a", 4);
+  reversed.addParameter<int>("c", 3);
+  ps.registerIt();
+  reversed.registerIt();
+  CPPUNIT_ASSERT(ps.id() == reversed.id());
+  edm::ParameterSet decoded(ps.toString());
+  decoded.registerIt();
+  CPPUNIT_ASSERT(decoded.id() == ps.id());
+}
+
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
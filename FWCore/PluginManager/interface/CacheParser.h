@@ -56,6 +56,10 @@ class CacheParser
         In this way multiple calls to read for different directories will preserve the ordering
         */
       static void read(std::istream&, const boost::filesystem::path& iDirectory, CategoryToInfos& oOut);
+      /**Same as above, parsing the characters [iBegin, iEnd) directly, e.g. a whole
+        cache file mapped in memory, instead of extracting them from a stream
+        */
+      static void read(const char* iBegin, const char* iEnd, const boost::filesystem::path& iDirectory, CategoryToInfos& oOut);
       static void write(const CategoryToInfos&, std::ostream&);
       
       static void read(std::istream&, LoadableToPlugins& oOut);
@@ -21,6 +21,7 @@
 // system include files
 #include <map>
 #include <string>
+#include <vector>
 
 // user include files
 #include "FWCore/PluginManager/interface/PluginFactoryBase.h"
@@ -33,6 +34,13 @@ class PluginCapabilities : public PluginFactoryBase
 {
    friend class DummyFriend;
    public:
+      struct PreloadRecord {
+        PreloadRecord() : classes_(0), libraries_(0), seconds_(0.) {}
+        unsigned int classes_;
+        unsigned int libraries_;
+        double seconds_;
+      };
+
       virtual ~PluginCapabilities();
 
       // ---------- const member functions ---------------------
@@ -51,6 +59,13 @@ class PluginCapabilities : public PluginFactoryBase
       ///Check to see if any capabilities are in the file, returns 'true' if found
       bool tryToFind(const SharedLibrary& iLoadable);
 
+      ///loads in one batch the libraries holding the dictionaries of these
+      /// classes, see PluginManager::preload; unknown classes are skipped
+      void preload(const std::vector<std::string>& iClassNames);
+
+      ///the classes and libraries loaded by preload so far, and the time it took
+      const PreloadRecord& preloadRecord() const { return preloadRecord_; }
+
    private:
       PluginCapabilities();
       PluginCapabilities(const PluginCapabilities&); // stop default
@@ -59,6 +74,7 @@ class PluginCapabilities : public PluginFactoryBase
 
       // ---------- member data --------------------------------
       std::map<std::string, boost::filesystem::path> classToLoadable_;
+      PreloadRecord preloadRecord_;
 };
 
 }
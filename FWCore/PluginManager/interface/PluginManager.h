@@ -27,6 +27,7 @@
 #include <boost/filesystem/path.hpp>
 #include <memory>
 #include "tbb/concurrent_unordered_map.h"
+#include "tbb/concurrent_vector.h"
 
 // user include files
 #include "FWCore/Utilities/interface/Signal.h"
@@ -48,10 +49,21 @@ namespace edmplugin {
 class PluginManager
 {
    friend class DummyFriend;
+   //preload updates its tables of classes while holding pluginLoadMutex
+   friend class PluginCapabilities;
   public:
      typedef std::vector<std::string> SearchPath;
      typedef std::vector<PluginInfo> Infos;
      typedef std::map<std::string, Infos > CategoryToInfos;
+     typedef std::pair<std::string, std::string> CategoryAndPlugin;
+
+     struct LoadRecord {
+       LoadRecord() : seconds_(0.) {}
+       LoadRecord(const boost::filesystem::path& iLoadable, double iSeconds) :
+         loadable_(iLoadable), seconds_(iSeconds) {}
+       boost::filesystem::path loadable_;
+       double seconds_;
+     };
 
      class Config {
       public:
@@ -86,6 +98,15 @@ class PluginManager
       //If can not find iPlugin in category iCategory return null pointer, any other failure will cause a throw
       const SharedLibrary* tryToLoad(const std::string& iCategory,
                                      const std::string& iPlugin);
+
+      /**Loads the libraries holding the plugins before they are asked for: the
+        library files are first read in parallel, then loaded in the order given.
+        Plugins which can not be found are skipped, the error is reported when they are asked for.
+        */
+      void preload(const std::vector<CategoryAndPlugin>& iPlugins);
+
+      ///the libraries loaded so far, in the order they were loaded, with the time each took
+      std::vector<LoadRecord> loadRecords() const;
       
       // ---------- static member functions --------------------
       ///file name of the shared object being loaded
@@ -120,12 +141,14 @@ class PluginManager
       const boost::filesystem::path& loadableFor_(const std::string& iCategory,
                                                   const std::string& iPlugin,
                                                   bool& ioThrowIfFailElseSucceedStatus);
+      const SharedLibrary& loadLibrary_(const boost::filesystem::path& iLoadable);
       // ---------- member data --------------------------------
       SearchPath searchPath_;
       tbb::concurrent_unordered_map<boost::filesystem::path, std::shared_ptr<SharedLibrary>, PluginManagerPathHasher > loadables_;
       
       CategoryToInfos categoryToInfos_;
       std::recursive_mutex pluginLoadMutex_;
+      tbb::concurrent_vector<LoadRecord> loadRecords_;
 };
 
 }
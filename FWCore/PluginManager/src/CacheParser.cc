@@ -147,6 +147,52 @@ CacheParser::read(std::istream& iIn,
   }
 }
 
+void
+CacheParser::read(const char* iBegin, const char* iEnd,
+                  const boost::filesystem::path& iDirectory,
+                  CacheParser::CategoryToInfos& iOut)
+{
+  unsigned long recordNumber=0;
+  
+  std::string fields[3];
+  PluginInfo info;
+  
+  const char* current = iBegin;
+  while(current != iEnd) {
+    const char* endOfLine = std::find(current, iEnd, '\n');
+    unsigned int nFields = 0;
+    while(current != endOfLine and nFields < 3) {
+      while(current != endOfLine and (*current == ' ' or *current == '\t' or *current == '\r')) { ++current; }
+      const char* endOfField = current;
+      while(endOfField != endOfLine and *endOfField != ' ' and *endOfField != '\t' and *endOfField != '\r') { ++endOfField; }
+      if(endOfField != current) {
+        fields[nFields].assign(current, endOfField);
+        restoreSpaces(fields[nFields]);
+        ++nFields;
+      }
+      current = endOfField;
+    }
+    //blank lines are skipped, everything after the third field is ignored
+    if(nFields != 0) {
+      ++recordNumber;
+      if(nFields != 3) {
+        throw cms::Exception("PluginCacheParseFailed")<<"Unexpectedly reached end of line "
+        <<recordNumber<<" just after '"<<fields[nFields-1]<<"'";
+      }
+      info.loadable_ = iDirectory / fields[0];
+      info.name_ = fields[1];
+      iOut[fields[2]].push_back(info);
+    }
+    current = (endOfLine == iEnd) ? iEnd : endOfLine+1;
+  }
+  //now do a sort which preserves any previous order for files
+  for(CacheParser::CategoryToInfos::iterator it = iOut.begin(), itEnd=iOut.end();
+      it != itEnd;
+      ++it) {
+    std::stable_sort(it->second.begin(),it->second.end(), CompPluginInfos());
+  }
+}
+
 void
 CacheParser::write(const CategoryToInfos& iInfos, std::ostream& oOut)
 {
@@ -16,12 +16,21 @@
 #include "FWCore/PluginManager/interface/PluginCapabilities.h"
 #include "FWCore/PluginManager/interface/SharedLibrary.h"
 #include "FWCore/PluginManager/interface/PluginManager.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/Exception.h"
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
 namespace edmplugin {
 //
 // constants, enums and typedefs
 //
+namespace {
+  const std::string& nameOf(const PluginInfo& iInfo) { return iInfo.name_; }
+  const std::string& nameOf(const std::string& iName) { return iName; }
+}
 
 //
 // static data member definitions
@@ -131,6 +140,74 @@ PluginCapabilities::tryToLoad(const std::string& iName)
   }
   return true;
 }
+void
+PluginCapabilities::preload(const std::vector<std::string>& iClassNames)
+{
+  //the dictionary generator names the capabilities 'LCGReflex/<class name>'
+  static const std::string s_prefix("LCGReflex/");
+  auto start = std::chrono::steady_clock::now();
+  PluginManager* db = PluginManager::get();
+  //other threads may be loading libraries: hold the mutex of the PluginManager
+  // while classToLoadable_ and preloadRecord_ are read and changed
+  std::lock_guard<std::recursive_mutex> guard(db->pluginLoadMutex());
+
+  auto itFound = db->categoryToInfos().find(category());
+  if(itFound == db->categoryToInfos().end()) {
+    return;
+  }
+  //the infos are sorted by name
+  auto const& infos = itFound->second;
+  auto known = [&infos](const std::string& iName) {
+    return std::binary_search(infos.begin(), infos.end(), iName,
+                              [](auto const& a, auto const& b) { return nameOf(a) < nameOf(b); });
+  };
+
+  std::vector<std::string> names;
+  for(auto const& className : iClassNames) {
+    std::string name = s_prefix + className;
+    if(classToLoadable_.find(name) != classToLoadable_.end() or
+       classToLoadable_.find(className) != classToLoadable_.end()) {
+      continue;
+    }
+    if(known(name)) {
+      names.push_back(std::move(name));
+    } else if(known(className)) {
+      names.push_back(className);
+    }
+  }
+  if(names.empty()) {
+    return;
+  }
+  std::vector<PluginManager::CategoryAndPlugin> plugins;
+  plugins.reserve(names.size());
+  for(auto const& name : names) {
+    plugins.emplace_back(category(), name);
+  }
+  size_t const nLoaded = db->loadRecords().size();
+  db->preload(plugins);
+
+  //register the classes of the libraries now loaded; a library which could
+  // not be loaded gives its error again when its class is actually asked for
+  unsigned int nClasses = 0;
+  for(auto const& name : names) {
+    if(classToLoadable_.find(name) != classToLoadable_.end()) {
+      ++nClasses;
+      continue;
+    }
+    try {
+      if(tryToLoad(name)) {
+        ++nClasses;
+      }
+    } catch(cms::Exception const& iException) {
+      edm::LogWarning("PluginCapabilities")<<"Could not preload the dictionary for '"<<name<<"':\n"
+      <<iException.explainSelf();
+    }
+  }
+  preloadRecord_.classes_ += nClasses;
+  preloadRecord_.libraries_ += db->loadRecords().size() - nLoaded;
+  preloadRecord_.seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
 //
 // const member functions
 //
@@ -13,9 +13,16 @@
 // system include files
 #include <boost/filesystem/operations.hpp>
 
+#include <chrono>
 #include <fstream>
 #include <functional>
 #include <set>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tbb/parallel_for_each.h"
 
 // TEMPORARY
 #include "TInterpreter.h"
@@ -44,12 +51,35 @@ static bool readCacheFile(const boost::filesystem::path &cacheFile,
                           PluginManager::CategoryToInfos &categoryToInfos) 
 {
   if(exists(cacheFile) ) {
-    std::ifstream file(cacheFile.string().c_str());
-    if(not file) {
+    //the cache file of a release holds every plugin of the release, so it is
+    // mapped in memory and parsed in place rather than read through a stream
+    int fd = ::open(cacheFile.string().c_str(), O_RDONLY);
+    if(fd < 0) {
       throw cms::Exception("PluginMangerCacheProblem")<<"Unable to open the cache file '"<<cacheFile.string()
       <<"'. Please check permissions on file";
     }
-    CacheParser::read(file, dir, categoryToInfos);          
+    struct stat fileStat;
+    if(0 != ::fstat(fd, &fileStat)) {
+      ::close(fd);
+      throw cms::Exception("PluginMangerCacheProblem")<<"Unable to get the size of the cache file '"<<cacheFile.string()<<"'";
+    }
+    if(fileStat.st_size == 0) {
+      ::close(fd);
+      return true;
+    }
+    void* mapped = ::mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(mapped == MAP_FAILED) {
+      throw cms::Exception("PluginMangerCacheProblem")<<"Unable to map the cache file '"<<cacheFile.string()<<"' in memory";
+    }
+    const char* begin = static_cast<const char*>(mapped);
+    try {
+      CacheParser::read(begin, begin+fileStat.st_size, dir, categoryToInfos);
+    } catch(...) {
+      ::munmap(mapped, fileStat.st_size);
+      throw;
+    }
+    ::munmap(mapped, fileStat.st_size);
     return true;
   }
   return false;
@@ -251,31 +281,7 @@ PluginManager::load(const std::string& iCategory,
   askedToLoadCategoryWithPlugin_(iCategory,iPlugin);
   const boost::filesystem::path& p = loadableFor(iCategory,iPlugin);
   
-  //have we already loaded this?
-  auto itLoaded = loadables_.find(p);
-  if(itLoaded == loadables_.end()) {
-    //Need to make sure we only have on SharedLibrary loading at a time
-    std::lock_guard<std::recursive_mutex> guard(pluginLoadMutex());
-    //Another thread may have gotten this while we were waiting on the mutex
-    itLoaded = loadables_.find(p);
-    if(itLoaded == loadables_.end()){
-      //try to make one
-      goingToLoad_(p);
-      Sentry s(loadingLibraryNamed_(), p.string());
-      //boost::filesystem::path native(p.string());
-      std::shared_ptr<SharedLibrary> ptr;
-      {
-	//TEMPORARY: to avoid possible deadlocks from ROOT, we must
-	// take the lock ourselves
-	R__LOCKGUARD2(gInterpreterMutex);
-	ptr.reset( new SharedLibrary(p) );
-      }
-      loadables_[p]=ptr;
-      justLoaded_(*ptr);
-      return *ptr;
-    }
-  }
-  return *(itLoaded->second);
+  return loadLibrary_(p);
 }
 
 const SharedLibrary* 
@@ -290,7 +296,12 @@ PluginManager::tryToLoad(const std::string& iCategory,
     return 0;
   }
   
+  return &loadLibrary_(p);
+}
 
+const SharedLibrary&
+PluginManager::loadLibrary_(const boost::filesystem::path& p)
+{
   //have we already loaded this?
   auto itLoaded = loadables_.find(p);
   if(itLoaded == loadables_.end()) {
@@ -304,18 +315,80 @@ PluginManager::tryToLoad(const std::string& iCategory,
       Sentry s(loadingLibraryNamed_(), p.string());
       //boost::filesystem::path native(p.string());
       std::shared_ptr<SharedLibrary> ptr;
+      auto const start = std::chrono::steady_clock::now();
       {
 	//TEMPORARY: to avoid possible deadlocks from ROOT, we must
 	// take the lock ourselves
-	R__LOCKGUARD(gInterpreterMutex);
+	R__LOCKGUARD2(gInterpreterMutex);
 	ptr.reset( new SharedLibrary(p) );
       }
+      std::chrono::duration<double> const loadTime = std::chrono::steady_clock::now() - start;
+      loadRecords_.push_back(LoadRecord(p, loadTime.count()));
       loadables_[p]=ptr;
       justLoaded_(*ptr);
-      return ptr.get();
+      return *ptr;
+    }
+  }
+  return *(itLoaded->second);
+}
+
+namespace {
+  //Reads the whole file so that it is in the page cache when it is loaded.
+  // This is where the time goes for a library on a network file system.
+  void readAhead(const boost::filesystem::path& iPath) {
+    int fd = ::open(iPath.string().c_str(), O_RDONLY);
+    if(fd < 0) {
+      return;
     }
+#if defined(POSIX_FADV_WILLNEED)
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+    std::vector<char> buffer(1 << 20);
+    while(::read(fd, &buffer[0], buffer.size()) > 0) {}
+    ::close(fd);
   }
-  return (itLoaded->second).get();
+}
+
+void
+PluginManager::preload(const std::vector<CategoryAndPlugin>& iPlugins)
+{
+  //find the libraries not loaded yet, in the order they were asked for
+  std::vector<boost::filesystem::path> toLoad;
+  std::set<boost::filesystem::path> seen;
+  for(auto const& categoryAndPlugin : iPlugins) {
+    bool found = false;
+    const boost::filesystem::path& p = loadableFor_(categoryAndPlugin.first, categoryAndPlugin.second, found);
+    //unknown plugins are reported when they are actually asked for
+    if(not found or p == staticallyLinkedLoadingFileName()) {
+      continue;
+    }
+    if(loadables_.find(p) != loadables_.end() or not seen.insert(p).second) {
+      continue;
+    }
+    //e.g. a poisoned plugin, which must fail when it is asked for
+    if(not exists(p)) {
+      continue;
+    }
+    toLoad.push_back(p);
+  }
+  if(toLoad.empty()) {
+    return;
+  }
+
+  //reading the files is independent and can be done in parallel; loading
+  // them is serialized anyway by the dynamic linker and the static
+  // initializers registering the plugins
+  tbb::parallel_for_each(toLoad.begin(), toLoad.end(), readAhead);
+
+  for(auto const& p : toLoad) {
+    loadLibrary_(p);
+  }
+}
+
+std::vector<PluginManager::LoadRecord>
+PluginManager::loadRecords() const
+{
+  return std::vector<LoadRecord>(loadRecords_.begin(), loadRecords_.end());
 }
 
 //
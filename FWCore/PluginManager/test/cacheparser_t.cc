@@ -15,19 +15,23 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <iostream>
 #include <sstream>
+#include <cstring>
 
 // user include files
 #include "FWCore/PluginManager/interface/CacheParser.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 class TestCacheParser : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(TestCacheParser);
   CPPUNIT_TEST(testSpace);
   CPPUNIT_TEST(testReadWrite);
+  CPPUNIT_TEST(testReadBuffer);
   CPPUNIT_TEST_SUITE_END();
 public:
     void testSpace();
     void testReadWrite();
+    void testReadBuffer();
     void setUp() {}
     void tearDown() {}
 };
@@ -104,3 +108,39 @@ TestCacheParser::testReadWrite()
     }
   }
 }  
+
+void
+TestCacheParser::testReadBuffer()
+{
+  using namespace edmplugin;
+  const std::string cache("pluginB.so GammaClass Cat%Two\r\n"
+                          "\n"
+                          "pluginA.so AlphaClass Cat%One\n"
+                          "pluginA.so\tBetaClass<Itl%>  Cat%Two\n"
+                          "pluginA.so DeltaClass Cat%Two\n");
+
+  std::map<std::string, std::vector<PluginInfo> > fromStream;
+  {
+    std::stringstream s(cache);
+    CacheParser::read(s,"/enee/menee",fromStream);
+  }
+  std::map<std::string, std::vector<PluginInfo> > fromBuffer;
+  CacheParser::read(cache.data(),cache.data()+cache.size(),"/enee/menee",fromBuffer);
+
+  CPPUNIT_ASSERT(2 == fromBuffer.size());
+  CPPUNIT_ASSERT(1 == fromBuffer["Cat One"].size());
+  CPPUNIT_ASSERT(3 == fromBuffer["Cat Two"].size());
+  CPPUNIT_ASSERT(fromBuffer["Cat Two"][0].name_ == "BetaClass<Itl >");
+  CPPUNIT_ASSERT(fromBuffer["Cat Two"][0].loadable_ == "/enee/menee/pluginA.so");
+  {
+    std::stringstream streamOut;
+    CacheParser::write(fromStream,streamOut);
+    std::stringstream bufferOut;
+    CacheParser::write(fromBuffer,bufferOut);
+    CPPUNIT_ASSERT(streamOut.str() == bufferOut.str());
+  }
+
+  const char* const truncated = "pluginA.so AlphaClass\n";
+  std::map<std::string, std::vector<PluginInfo> > bad;
+  CPPUNIT_ASSERT_THROW(CacheParser::read(truncated,truncated+std::strlen(truncated),"/enee/menee",bad), cms::Exception);
+}
@@ -117,5 +117,20 @@ TestPluginManager::test()
   CPPUNIT_ASSERT(nTimesAsked == 2); //request happens even though it failed
   CPPUNIT_ASSERT(nTimesGoingToLoad==1);
   CPPUNIT_ASSERT(nTimesLoaded==1);
+
+  CPPUNIT_ASSERT(db.loadRecords().size() == 1);
+  CPPUNIT_ASSERT(db.loadRecords()[0].loadable_ == db.loadableFor("Test Dummy", "DummyOne"));
+
+  //already loaded, statically linked and unknown plugins are skipped
+  std::vector<PluginManager::CategoryAndPlugin> toPreload;
+  toPreload.emplace_back(toLoadCategory, "DummyOne");
+  toPreload.emplace_back(toLoadCategory, "DummyTwo");
+  toPreload.emplace_back(toLoadCategory, "DummyThree");
+  toPreload.emplace_back(toLoadCategory, "DoesNotExist");
+  db.preload(toPreload);
+  CPPUNIT_ASSERT(nTimesAsked == 2);
+  CPPUNIT_ASSERT(nTimesGoingToLoad==1);
+  CPPUNIT_ASSERT(nTimesLoaded==1);
+  CPPUNIT_ASSERT(db.loadRecords().size() == 1);
   
 }
@@ -22,6 +22,7 @@ namespace edm {
 
       reg.watchPostEndJob(this, &JobReportService::postEndJob);
       reg.watchJobFailure(this, &JobReportService::frameworkShutdownOnFailure);
+      reg.watchPreForkReleaseResources(this, &JobReport::preForkReleaseResources);
 
       // We don't handle PreProcessEvent, because we have to know *which
       // input file* was the event read from. Only the InputSource that
@@ -0,0 +1,80 @@
+#ifndef FWCore_TFWLiteSelector_MultiProcessDriver_h
+#define FWCore_TFWLiteSelector_MultiProcessDriver_h
+// -*- C++ -*-
+//
+// Package:     TFWLiteSelector
+// Class  :     MultiProcessDriver
+//
+/**\class edm::root::MultiProcessDriver MultiProcessDriver.h FWCore/TFWLiteSelector/interface/MultiProcessDriver.h
+
+ Description: Runs a TSelector (e.g. a TFWLiteSelector) on the local machine with several forked worker processes
+
+ Usage:
+    This replaces PROOF-lite for a TFWLiteSelector:
+    \code
+    tfwliteselectortest::ThingsTSelector selector;
+    edm::root::MultiProcessDriver driver(8);
+    driver.process(selector, fileNames);
+    \endcode
+    The original process calls the selector's 'begin' and reads the dictionaries of all the branches of the
+    first file, then forks the workers, so whatever was loaded or set up in 'begin' (dictionaries, geometry,
+    conditions, ...) is shared copy-on-write by all the workers.
+
+    Each worker calls 'preProcessing', then asks the original process for blocks of iEventsPerBlock
+    consecutive events, numbered across all the files in the order given, until there are no events left.
+    The blocks are given out as the workers ask for them (the same protocol as cmsRun's forking mode), so a
+    slow worker gets fewer blocks.  Each worker reads its block through a TTreeCache holding just the
+    entries of the block.  At the end the worker calls 'postProcessing' and writes its output list to a
+    file in the output directory.
+
+    The original process then merges the output lists of all the workers (objects with the same name are
+    merged with their class' Merge function, e.g. histograms are added, and objects which cannot be merged
+    are all kept) into the selector's output list, removes the worker files and calls 'terminate'.
+
+    If a worker fails, process() throws a cms::Exception once all the workers have ended.
+*/
+//
+// system include files
+#include <string>
+#include <vector>
+
+#include "Rtypes.h"
+
+// user include files
+
+// forward declarations
+class TSelector;
+
+namespace edm {
+  namespace root {
+    class MultiProcessDriver {
+
+    public:
+      MultiProcessDriver(unsigned int iNumberOfWorkers, unsigned int iEventsPerBlock = 100);
+
+      // ---------- const member functions ---------------------
+      unsigned int numberOfWorkers() const { return numberOfWorkers_; }
+      unsigned int eventsPerBlock() const { return eventsPerBlock_; }
+
+      // ---------- member functions ---------------------------
+      ///directory where the workers write their output lists, the current directory by default
+      void setOutputDirectory(std::string const& iDirectory) { outputDirectory_ = iDirectory; }
+
+      ///processes the entries of the tree iTreeName in all the files, returns the number of entries
+      Long64_t process(TSelector& iSelector,
+                       std::vector<std::string> const& iFileNames,
+                       char const* iTreeName = "Events");
+
+    private:
+      MultiProcessDriver(MultiProcessDriver const&); // stop default
+      MultiProcessDriver const& operator=(MultiProcessDriver const&); // stop default
+
+      // ---------- member data --------------------------------
+      unsigned int numberOfWorkers_;
+      unsigned int eventsPerBlock_;
+      std::string outputDirectory_;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,292 @@
+// -*- C++ -*-
+//
+// Package:     TFWLiteSelector
+// Class  :     MultiProcessDriver
+//
+// Implementation:
+//     The workers are given their blocks of events by a MessageSenderToSource running in a thread of the
+//     original process, and ask for them with a MessageReceiverForSource, as in cmsRun's forking mode.
+//
+
+// system include files
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include "TBranch.h"
+#include "TClass.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TObjArray.h"
+#include "TSelector.h"
+#include "TTree.h"
+
+// user include files
+#include "FWCore/TFWLiteSelector/interface/MultiProcessDriver.h"
+#include "FWCore/Framework/interface/MessageReceiverForSource.h"
+#include "FWCore/Framework/interface/MessageSenderToSource.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace {
+  TTree* openTree(std::unique_ptr<TFile>& oFile, std::string const& iFileName, char const* iTreeName) {
+    oFile.reset(TFile::Open(iFileName.c_str()));
+    if(!oFile || oFile->IsZombie()) {
+      throw cms::Exception("FileOpenError") << "could not open file '" << iFileName << "'";
+    }
+    TTree* tree = dynamic_cast<TTree*>(oFile->Get(iTreeName));
+    if(nullptr == tree) {
+      throw cms::Exception("MissingTree") << "file '" << iFileName << "' has no TTree named '" << iTreeName << "'";
+    }
+    return tree;
+  }
+
+  //loads in this process the dictionaries of all the branches, so the workers do not each load them
+  void loadDictionaries(TTree& iTree) {
+    TIter next(iTree.GetListOfBranches());
+    while(TBranch* branch = static_cast<TBranch*>(next())) {
+      char const* className = branch->GetClassName();
+      if(nullptr != className && 0 != className[0]) {
+        TClass::GetClass(className);
+      }
+    }
+  }
+
+  std::string workerFileName(std::string const& iDirectory, pid_t iParent, unsigned int iWorker) {
+    std::ostringstream name;
+    name << iDirectory << "/multiProcessDriver_" << iParent << "_" << iWorker << ".root";
+    return name.str();
+  }
+
+  void closeOnExec(int iFd) {
+    int flags = fcntl(iFd, F_GETFD, NULL);
+    if(flags == -1 || fcntl(iFd, F_SETFD, flags | FD_CLOEXEC) == -1) {
+      throw cms::Exception("MultiProcessDriver") << "failed to set fd flags: " << strerror(errno);
+    }
+  }
+
+  /* Body of a worker process: processes the blocks of events it is given until they are past the
+   * last event, then writes its output list.  iOffsets holds for each file the number of events
+   * in the files before it, and the total number of events at the end.
+   */
+  void runWorker(TSelector& iSelector,
+                 edm::multicore::MessageReceiverForSource& iReceiver,
+                 std::vector<std::string> const& iFileNames,
+                 std::vector<Long64_t> const& iOffsets,
+                 char const* iTreeName,
+                 std::string const& iOutputFileName) {
+    Long64_t const nEvents = iOffsets.back();
+    iSelector.SlaveBegin(nullptr);
+
+    std::unique_ptr<TFile> file;
+    TTree* tree = nullptr;
+    size_t currentFile = iFileNames.size();
+    while(true) {
+      iReceiver.receive();
+      Long64_t first = iReceiver.startIndex();
+      if(0 == iReceiver.numberOfConsecutiveIndices() || first >= nEvents) {
+        break;
+      }
+      Long64_t const last = std::min(nEvents, static_cast<Long64_t>(first + iReceiver.numberOfConsecutiveIndices()));
+      while(first < last) {
+        //empty files share their offset with the next file
+        size_t const iFile = std::upper_bound(iOffsets.begin(), iOffsets.end(), first) - iOffsets.begin() - 1;
+        if(iFile != currentFile) {
+          //the selector must see the new tree before the old file goes away
+          std::unique_ptr<TFile> newFile;
+          tree = openTree(newFile, iFileNames[iFile], iTreeName);
+          iSelector.Init(tree);
+          if(!iSelector.Notify()) {
+            throw cms::Exception("MultiProcessDriver") << "the selector could not use file '" << iFileNames[iFile] << "'";
+          }
+          file = std::move(newFile);
+          tree->SetCacheSize();
+          currentFile = iFile;
+        }
+        Long64_t const fileLast = std::min(last, iOffsets[iFile + 1]);
+        Long64_t const beginEntry = first - iOffsets[iFile];
+        Long64_t const endEntry = fileLast - iOffsets[iFile];
+        //prefetch the baskets of the block; the cache learns during the first
+        // entries of the file which branches the selector actually reads
+        tree->SetCacheEntryRange(beginEntry, endEntry);
+        for(Long64_t entry = beginEntry; entry != endEntry; ++entry) {
+          iSelector.Process(entry);
+        }
+        first = fileLast;
+      }
+    }
+    iSelector.SlaveTerminate();
+
+    TFile output(iOutputFileName.c_str(), "RECREATE");
+    if(output.IsZombie()) {
+      throw cms::Exception("FileOpenError") << "could not create file '" << iOutputFileName << "'";
+    }
+    TIter next(iSelector.GetOutputList());
+    while(TObject* object = next()) {
+      object->Write(object->GetName(), TObject::kSingleKey);
+    }
+    output.Close();
+  }
+
+  void mergeInto(TList& ioOutput, TObject* iObject) {
+    TObject* existing = ioOutput.FindObject(iObject->GetName());
+    if(nullptr != existing && existing->IsA() == iObject->IsA()) {
+      ROOT::MergeFunc_t merge = existing->IsA()->GetMerge();
+      if(nullptr != merge) {
+        TList toMerge;
+        toMerge.Add(iObject);
+        merge(existing, &toMerge, nullptr);
+        delete iObject;
+        return;
+      }
+    }
+    ioOutput.Add(iObject);
+  }
+
+  void readWorkerOutput(TList& ioOutput, std::string const& iFileName) {
+    std::unique_ptr<TFile> file(TFile::Open(iFileName.c_str()));
+    if(!file || file->IsZombie()) {
+      throw cms::Exception("FileOpenError") << "could not open the worker output file '" << iFileName << "'";
+    }
+    TIter next(file->GetListOfKeys());
+    while(TKey* key = static_cast<TKey*>(next())) {
+      TObject* object = key->ReadObj();
+      //take the object away from the file, e.g. for histograms
+      ROOT::DirAutoAdd_t removeFromDirectory = object->IsA()->GetDirectoryAutoAdd();
+      if(nullptr != removeFromDirectory) {
+        removeFromDirectory(object, nullptr);
+      }
+      mergeInto(ioOutput, object);
+    }
+  }
+}
+
+namespace edm {
+  namespace root {
+    //
+    // constructors and destructor
+    //
+    MultiProcessDriver::MultiProcessDriver(unsigned int iNumberOfWorkers, unsigned int iEventsPerBlock) :
+      numberOfWorkers_(iNumberOfWorkers > 0 ? iNumberOfWorkers : 1),
+      eventsPerBlock_(iEventsPerBlock > 0 ? iEventsPerBlock : 1),
+      outputDirectory_(".") {
+    }
+
+    //
+    // member functions
+    //
+    Long64_t
+    MultiProcessDriver::process(TSelector& iSelector,
+                                std::vector<std::string> const& iFileNames,
+                                char const* iTreeName) {
+      //number the events across all the files
+      std::vector<Long64_t> offsets;
+      offsets.reserve(iFileNames.size() + 1);
+      offsets.push_back(0);
+      for(auto const& fileName : iFileNames) {
+        std::unique_ptr<TFile> file;
+        TTree* tree = openTree(file, fileName, iTreeName);
+        if(offsets.size() == 1) {
+          loadDictionaries(*tree);
+        }
+        offsets.push_back(offsets.back() + tree->GetEntries());
+      }
+
+      iSelector.Begin(nullptr);
+
+      pid_t const parent = getpid();
+      std::vector<pid_t> childrenIds;
+      std::vector<int> childrenSockets;
+      std::vector<int> childrenPipes;
+      std::cout << std::flush;
+      std::cerr << std::flush;
+      for(unsigned int childIndex = 0; childIndex < numberOfWorkers_; ++childIndex) {
+        int sockets[2], pipes[2];
+        if(socketpair(AF_UNIX, SOCK_DGRAM, 0, sockets) || pipe(pipes)) {
+          throw cms::Exception("MultiProcessDriver") << "failed to create the communication with a worker: " << strerror(errno);
+        }
+        closeOnExec(sockets[0]);
+        closeOnExec(pipes[0]);
+        // the worker must be careful to do select prior to reading from the socket
+        fcntl(sockets[1], F_SETFL, fcntl(sockets[1], F_GETFL) | O_NONBLOCK);
+
+        pid_t value = fork();
+        if(value == 0) {
+          close(sockets[0]);
+          close(pipes[0]);
+          for(int fd : childrenSockets) { close(fd); }
+          for(int fd : childrenPipes) { close(fd); }
+          int status = 0;
+          try {
+            edm::multicore::MessageReceiverForSource receiver(sockets[1], pipes[1]);
+            runWorker(iSelector, receiver, iFileNames, offsets, iTreeName,
+                      workerFileName(outputDirectory_, parent, childIndex));
+          } catch(std::exception const& iException) {
+            std::cerr << "MultiProcessDriver worker " << childIndex << " failed:\n" << iException.what() << std::endl;
+            status = 1;
+          }
+          std::cout << std::flush;
+          std::cerr << std::flush;
+          //do not run the exit handlers of the original process
+          _exit(status);
+        }
+        close(sockets[1]);
+        close(pipes[1]);
+        if(value < 0) {
+          close(sockets[0]);
+          close(pipes[0]);
+          std::cerr << "MultiProcessDriver: failed to create worker " << childIndex << ": " << strerror(errno) << std::endl;
+          break;
+        }
+        childrenIds.push_back(value);
+        childrenSockets.push_back(sockets[0]);
+        childrenPipes.push_back(pipes[0]);
+      }
+      if(childrenIds.empty()) {
+        throw cms::Exception("MultiProcessDriver") << "failed to create any worker";
+      }
+
+      //the sender returns once all the workers have exited
+      edm::multicore::MessageSenderToSource sender(childrenSockets, childrenPipes, eventsPerBlock_);
+      std::thread senderThread(std::ref(sender));
+
+      unsigned int nFailed = 0;
+      for(pid_t child : childrenIds) {
+        int status = 0;
+        while(waitpid(child, &status, 0) < 0 && errno == EINTR) {}
+        if(!WIFEXITED(status) || 0 != WEXITSTATUS(status)) {
+          ++nFailed;
+        }
+      }
+      //the sender has closed all the sockets and pipes of the workers
+      senderThread.join();
+
+      TList& output = *iSelector.GetOutputList();
+      for(unsigned int childIndex = 0; childIndex < childrenIds.size(); ++childIndex) {
+        std::string const fileName = workerFileName(outputDirectory_, parent, childIndex);
+        if(0 == nFailed) {
+          readWorkerOutput(output, fileName);
+        }
+        std::remove(fileName.c_str());
+      }
+      if(0 != nFailed) {
+        throw cms::Exception("ForkedChildFailed") << nFailed << " of the " << childrenIds.size()
+                                                  << " worker processes failed, see their output above";
+      }
+
+      iSelector.Terminate();
+      return offsets.back();
+    }
+  }
+}
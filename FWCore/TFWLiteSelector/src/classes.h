@@ -1 +1,2 @@
 #include "FWCore/TFWLiteSelector/interface/TFWLiteSelectorBasic.h"
+#include "FWCore/TFWLiteSelector/interface/MultiProcessDriver.h"
@@ -16,6 +16,10 @@ rm -f a.jpg refA.jpg
 root -b -n -q ${LOCAL_TEST_DIR}/thing2_sel.C || die 'Failed tfwliteselectortest::ThingsTSelector2 test' $?
 [ -s a.jpg ] && [ -s refA.jpg ] || die 'Failed tfwliteselectortest::ThingsTSelector2 test, no histograms' 20
 
+rm -f a.jpg refA.jpg
+root -b -n -q ${LOCAL_TEST_DIR}/multiprocess_thing_sel.C || die 'Failed tfwliteselectortest::ThingsTSelector multi-process test' $?
+[ -s a.jpg ] && [ -s refA.jpg ] || die 'Failed tfwliteselectortest::ThingsTSelector multi-process test, no histograms' 20
+
 rm -f a.jpg refA.jpg
 root -b -n -q ${LOCAL_TEST_DIR}/proof_thing_sel.C || die 'Failed tfwliteselectortest::ThingsTSelector test' $?
 [ -s a.jpg ] && [ -s refA.jpg ] || die 'Failed tfwliteselectortest::ThingsTSelector test, no histograms' 20
@@ -28,6 +28,8 @@ public:
   void* address() const;
   TypeWithDict typeOf() const;
   TypeWithDict dynamicType() const;
+  // same as dynamicType().typeInfo(), without the dictionary lookup
+  std::type_info const& dynamicTypeInfo() const;
   ObjectWithDict castObject(TypeWithDict const&) const;
   ObjectWithDict get(std::string const& memberName) const;
   //ObjectWithDict construct() const;
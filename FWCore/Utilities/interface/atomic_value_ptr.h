@@ -70,12 +70,19 @@ namespace edm {
       return *this;
     }
 
-    atomic_value_ptr(atomic_value_ptr&& orig) :
-      myP(orig.myP) { orig.myP.store(nullptr); }
+    // Moves are not atomic either, so they need no ordering: they are
+    // cheap enough for containers that shift their elements.
+    atomic_value_ptr(atomic_value_ptr&& orig) noexcept :
+      myP(orig.myP.load(std::memory_order_relaxed)) {
+      orig.myP.store(nullptr, std::memory_order_relaxed);
+    }
 
-    atomic_value_ptr& operator=(atomic_value_ptr&& orig) {
-      atomic_value_ptr<T> local(orig);
-      exchangeWithLocal(local);
+    atomic_value_ptr& operator=(atomic_value_ptr&& orig) noexcept {
+      T* p = orig.myP.load(std::memory_order_relaxed);
+      orig.myP.store(nullptr, std::memory_order_relaxed);
+      T* old = myP.load(std::memory_order_relaxed);
+      myP.store(p, std::memory_order_relaxed);
+      if(old != p) delete old;
       return *this;
     }
 
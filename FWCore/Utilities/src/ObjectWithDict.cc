@@ -59,6 +59,14 @@ namespace edm {
     return TypeWithDict(typeid(*(DummyVT*)address_));
   }
 
+  std::type_info const&
+  ObjectWithDict::dynamicTypeInfo() const {
+    if (!type_.isVirtual()) {
+      return type_.typeInfo();
+    }
+    return typeid(*(DummyVT*)address_);
+  }
+
   ObjectWithDict
   ObjectWithDict::get(std::string const& memberName) const {
     return type_.dataMemberByName(memberName).get(*this);
@@ -0,0 +1,67 @@
+#ifndef GEOMETRY_CALOGEOMETRY_CALOCELLETAPHIINDEX_H
+#define GEOMETRY_CALOGEOMETRY_CALOCELLETAPHIINDEX_H 1
+
+#include <vector>
+#include <cstdint>
+
+/** \class CaloCellEtaPhiIndex
+
+  Uniform eta-phi grid over the reference positions of the cells of one
+  calorimeter subdetector.  Cells are identified by the numbers given at
+  construction, by default their position in the input arrays (for
+  CaloSubdetectorGeometry this is the index into the sorted list of valid
+  ids).  The cells of each bin are stored contiguously
+  together with their eta/phi, so that cone queries only touch the bins
+  overlapping the cone and never go back to the cell geometry objects.
+
+  The index is immutable once built and can be shared between threads.
+
+*/
+
+class CaloCellEtaPhiIndex
+{
+   public:
+
+      typedef float                     Float ;
+      typedef std::vector<unsigned int> IndexVec ;
+
+      /// eta, phi (in [-pi,pi]) and cell, if not empty, must have the same length
+      CaloCellEtaPhiIndex( const std::vector<Float>& eta ,
+			   const std::vector<Float>& phi ,
+			   const IndexVec&           cell = IndexVec() ) ;
+
+      /// append to out the numbers of all cells with deltaR < dR, in no particular order
+      void cellsInCone( Float eta, Float phi, Float dR, IndexVec& out ) const ;
+
+      /// number of the cell with the smallest deltaR, ~0 if the index is
+      /// empty or eta/phi is not finite
+      unsigned int closestCell( Float eta, Float phi ) const ;
+
+      unsigned int size()    const { return m_cell.size() ; }
+      unsigned int nEtaBins() const { return m_nEta ; }
+      unsigned int nPhiBins() const { return m_nPhi ; }
+
+   private:
+
+      int etaBin( Float eta ) const ;
+      int phiBin( Float phi ) const ;
+
+      /// calls f( index, deltaR^2 ) for every cell with deltaR < dR
+      template < class F >
+      void scanCone( Float eta, Float phi, Float dR, F&& f ) const ;
+
+      Float m_etaMin ;
+      Float m_etaMax ;
+      Float m_etaWidth ;
+      Float m_phiWidth ;
+      int   m_nEta ;
+      int   m_nPhi ;
+
+      // m_offset[ iEta*m_nPhi + iPhi ] is the first slot of that bin
+      std::vector<uint32_t>     m_offset ;
+      std::vector<unsigned int> m_cell ;
+      std::vector<Float>        m_eta ;
+      std::vector<Float>        m_phi ;
+};
+
+#endif
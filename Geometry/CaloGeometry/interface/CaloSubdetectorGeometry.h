@@ -9,6 +9,7 @@
 #include "DataFormats/DetId/interface/DetId.h"
 #include "DataFormats/GeometryVector/interface/GlobalPoint.h"
 #include "Geometry/CaloGeometry/interface/CaloCellGeometry.h"
+#include "Geometry/CaloGeometry/interface/CaloCellEtaPhiIndex.h"
 #include "DataFormats/Math/interface/deltaR.h"
 
 #include "FWCore/Utilities/interface/GCC11Compatibility.h"
@@ -61,18 +62,36 @@ public:
   */
   virtual const std::vector<DetId>& getValidDetIds( DetId::Detector det    = DetId::Detector(0) , int subdet = 0 ) const ;
 
-  // Get closest cell, etc...
+  /** \brief Get the cell closest in eta-phi to the given point
+
+      The default implementation queries the eta-phi grid of etaPhiIndex().
+  */
   virtual DetId getClosestCell( const GlobalPoint& r ) const ;
 
   /** \brief Get a list of all cells within a dR of the given cell
 	  
-      The default implementation makes a loop over all cell geometries.
+      The default implementation queries the eta-phi grid of etaPhiIndex().
       Cleverer implementations are suggested to use rough conversions between
       eta/phi and ieta/iphi and test on the boundaries.
   */
   virtual DetIdSet getCells( const GlobalPoint& r, double dR ) const ;
   virtual CellSet getCellSet( const GlobalPoint& r, double dR ) const ;
 
+  /** \brief Append to ids all cells whose reference point is within dR of r
+
+      Same selection as the default getCells, but returned unsorted in a
+      vector that the caller can reuse from one query to the next.
+  */
+  void getCellsInCone( const GlobalPoint& r, double dR, std::vector<DetId>& ids ) const ;
+
+  /** \brief eta-phi grid over the reference points of all valid cells
+
+      Built on first use from the valid ids, i.e. once per geometry
+      object, and never modified afterwards.  Cell numbers are indices
+      into getValidDetIds().
+  */
+  const CaloCellEtaPhiIndex& etaPhiIndex() const ;
+
   CCGFloat deltaPhi( const DetId& detId ) const ;
   
   CCGFloat deltaEta( const DetId& detId ) const ;
@@ -134,9 +153,11 @@ private:
 #if !defined(__CINT__) && !defined(__MAKECINT__) && !defined(__REFLEX__)
   mutable std::atomic<std::vector<CCGFloat>*>  m_deltaPhi ;
   mutable std::atomic<std::vector<CCGFloat>*>  m_deltaEta ;
+  mutable std::atomic<CaloCellEtaPhiIndex*>    m_etaPhiIndex ;
 #else
   mutable std::vector<CCGFloat>*  m_deltaPhi ;
   mutable std::vector<CCGFloat>*  m_deltaEta ;
+  mutable CaloCellEtaPhiIndex*    m_etaPhiIndex ;
 #endif
 };
 
@@ -0,0 +1,164 @@
+#include "Geometry/CaloGeometry/interface/CaloCellEtaPhiIndex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+typedef CaloCellEtaPhiIndex::Float Float ;
+
+namespace
+{
+   // average number of cells per bin aimed for when sizing the grid
+   const Float k_cellsPerBin ( 4 ) ;
+   const int   k_maxBins     ( 1024 ) ;
+}
+
+CaloCellEtaPhiIndex::CaloCellEtaPhiIndex( const std::vector<Float>& eta ,
+					  const std::vector<Float>& phi ,
+					  const IndexVec&           cell  ) :
+   m_etaMin   ( 0 ) ,
+   m_etaMax   ( 0 ) ,
+   m_etaWidth ( 1 ) ,
+   m_phiWidth ( 2*M_PI ) ,
+   m_nEta     ( 1 ) ,
+   m_nPhi     ( 1 )
+{
+   assert( eta.size() == phi.size() ) ;
+   assert( cell.empty() || cell.size() == eta.size() ) ;
+   const unsigned int nCells ( eta.size() ) ;
+
+   if( 0 != nCells )
+   {
+      m_etaMin = *std::min_element( eta.begin(), eta.end() ) ;
+      m_etaMax = *std::max_element( eta.begin(), eta.end() ) ;
+
+      // square bins holding about k_cellsPerBin cells each on average
+      const Float etaSpan ( std::max( m_etaMax - m_etaMin, Float( 1.e-3 ) ) ) ;
+      const Float width   ( std::sqrt( k_cellsPerBin*etaSpan*2*M_PI/nCells ) ) ;
+      m_nEta = std::min( k_maxBins, std::max( 1, int( etaSpan/width ) ) ) ;
+      m_nPhi = std::min( k_maxBins, std::max( 1, int( 2*M_PI/width ) ) ) ;
+      m_etaWidth = etaSpan/m_nEta ;
+      m_phiWidth = 2*M_PI/m_nPhi ;
+   }
+
+   // counting sort of the cells into their bins
+   std::vector<uint32_t> bin ( nCells ) ;
+   m_offset.assign( m_nEta*m_nPhi + 1, 0 ) ;
+   for( unsigned int i ( 0 ) ; i != nCells ; ++i )
+   {
+      bin[i] = etaBin( eta[i] )*m_nPhi + phiBin( phi[i] ) ;
+      ++m_offset[ bin[i] + 1 ] ;
+   }
+   for( unsigned int b ( 1 ) ; b != m_offset.size() ; ++b )
+   {
+      m_offset[b] += m_offset[b-1] ;
+   }
+
+   m_cell.resize( nCells ) ;
+   m_eta.resize( nCells ) ;
+   m_phi.resize( nCells ) ;
+   std::vector<uint32_t> fill ( m_offset.begin(), m_offset.end() - 1 ) ;
+   for( unsigned int i ( 0 ) ; i != nCells ; ++i )
+   {
+      const uint32_t slot ( fill[ bin[i] ]++ ) ;
+      m_cell[ slot ] = cell.empty() ? i : cell[i] ;
+      m_eta[ slot ]  = eta[i] ;
+      m_phi[ slot ]  = phi[i] ;
+   }
+}
+
+int
+CaloCellEtaPhiIndex::etaBin( Float eta ) const
+{
+   const int iEta ( std::floor( ( eta - m_etaMin )/m_etaWidth ) ) ;
+   return std::min( m_nEta - 1, std::max( 0, iEta ) ) ;
+}
+
+int
+CaloCellEtaPhiIndex::phiBin( Float phi ) const
+{
+   const int iPhi ( std::floor( ( phi + M_PI )/m_phiWidth ) ) ;
+   return ( ( iPhi % m_nPhi ) + m_nPhi ) % m_nPhi ;
+}
+
+template < class F >
+void
+CaloCellEtaPhiIndex::scanCone( Float eta, Float phi, Float dR, F&& f ) const
+{
+   if( m_cell.empty() || !std::isfinite( eta ) || !std::isfinite( phi ) ||
+       eta + dR < m_etaMin || eta - dR > m_etaMax ) return ;
+
+   const Float dR2 ( dR*dR ) ;
+   const int etaLo ( etaBin( eta - dR ) ) ;
+   const int etaHi ( etaBin( eta + dR ) ) ;
+
+   int phiLo ( 0 ) ;
+   int nPhi  ( m_nPhi ) ;
+   if( dR < M_PI )
+   {
+      phiLo = std::floor( ( phi - dR + M_PI )/m_phiWidth ) ;
+      const int phiHi ( std::floor( ( phi + dR + M_PI )/m_phiWidth ) ) ;
+      nPhi = std::min( m_nPhi, phiHi - phiLo + 1 ) ;
+   }
+
+   for( int iEta ( etaLo ) ; iEta <= etaHi ; ++iEta )
+   {
+      for( int j ( 0 ) ; j != nPhi ; ++j )
+      {
+	 const int iPhi ( ( ( ( phiLo + j ) % m_nPhi ) + m_nPhi ) % m_nPhi ) ;
+	 const unsigned int b ( iEta*m_nPhi + iPhi ) ;
+	 for( uint32_t k ( m_offset[b] ) ; k != m_offset[b+1] ; ++k )
+	 {
+	    const Float deta ( eta - m_eta[k] ) ;
+	    Float dphi ( std::abs( phi - m_phi[k] ) ) ;
+	    if( dphi > Float( M_PI ) ) dphi = Float( 2*M_PI ) - dphi ;
+	    const Float dist2 ( deta*deta + dphi*dphi ) ;
+	    if( dist2 < dR2 ) f( m_cell[k], dist2 ) ;
+	 }
+      }
+   }
+}
+
+void
+CaloCellEtaPhiIndex::cellsInCone( Float eta, Float phi, Float dR, IndexVec& out ) const
+{
+   scanCone( eta, phi, dR, [&out]( unsigned int i, Float ) { out.push_back( i ) ; } ) ;
+}
+
+unsigned int
+CaloCellEtaPhiIndex::closestCell( Float eta, Float phi ) const
+{
+   const unsigned int none ( ~0u ) ;
+   unsigned int closest ( none ) ;
+   // e.g. a point on the z axis: no cell has a finite distance to it
+   if( m_cell.empty() || !std::isfinite( eta ) || !std::isfinite( phi ) ) return closest ;
+
+   // every cell lies within this distance of any point
+   const Float etaOut  ( std::max( std::abs( eta - m_etaMin ), std::abs( eta - m_etaMax ) ) ) ;
+   const Float maxDist ( std::sqrt( etaOut*etaOut + Float( M_PI*M_PI ) ) + m_etaWidth ) ;
+
+   // grow a cone until it contains a cell: the nearest cell inside the
+   // cone is then the nearest cell overall.  Ties go to the lowest index
+   // as in the linear search this replaces.  The cone at maxDist covers
+   // every cell, so the loop stops after scanning it at the latest.
+   const Float outside ( std::max( Float( 0 ), std::max( m_etaMin - eta, eta - m_etaMax ) ) ) ;
+   Float dR   ( outside + std::max( m_etaWidth, m_phiWidth ) ) ;
+   Float best ( 1e9 ) ;
+   bool last ( false ) ;
+   while( closest == none && !last )
+   {
+      last = ( dR >= maxDist ) ;
+      dR   = std::min( dR, maxDist ) ;
+      scanCone( eta, phi, dR,
+		[&best, &closest]( unsigned int i, Float dist2 )
+		{
+		   if( dist2 < best || ( dist2 == best && i < closest ) )
+		   {
+		      best    = dist2 ;
+		      closest = i ;
+		   }
+		} ) ;
+      dR *= 2 ;
+   }
+   return closest ;
+}
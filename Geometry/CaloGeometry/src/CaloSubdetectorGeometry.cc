@@ -1,6 +1,8 @@
 #include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
 #include "Geometry/CaloGeometry/interface/CaloGenericDetId.h"
 
+#include <algorithm>
+
 #include <Math/Transform3D.h>
 #include <Math/EulerAngles.h>
 
@@ -14,7 +16,8 @@ CaloSubdetectorGeometry::CaloSubdetectorGeometry() :
    m_parMgr ( 0 ) ,
    m_cmgr   ( 0 ) ,
    m_deltaPhi  (nullptr) ,
-   m_deltaEta  (nullptr)
+   m_deltaEta  (nullptr) ,
+   m_etaPhiIndex (nullptr)
 {}
 
 
@@ -24,6 +27,7 @@ CaloSubdetectorGeometry::~CaloSubdetectorGeometry()
    delete m_parMgr ; 
    if (m_deltaPhi) delete m_deltaPhi.load() ;
    if (m_deltaEta) delete m_deltaEta.load() ;
+   if (m_etaPhiIndex) delete m_etaPhiIndex.load() ;
 }
 
 void
@@ -52,74 +56,70 @@ CaloSubdetectorGeometry::present( const DetId& id ) const
    return ( 0 != getGeometry( id ) ) ;
 }
 
-DetId 
-CaloSubdetectorGeometry::getClosestCell( const GlobalPoint& r ) const 
+const CaloCellEtaPhiIndex&
+CaloSubdetectorGeometry::etaPhiIndex() const
 {
-   const CCGFloat eta ( r.eta() ) ;
-   const CCGFloat phi ( r.phi() ) ;
-   uint32_t index ( ~0 ) ;
-   CCGFloat closest ( 1e9 ) ;
-
-   for( uint32_t i ( 0 ); i != m_validIds.size() ; ++i ) 
+   if(!m_etaPhiIndex.load(std::memory_order_acquire))
    {
-      const CaloCellGeometry* cell ( getGeometry( m_validIds[ i ] ) ) ;
-      if( 0 != cell )
+      std::vector<CaloCellEtaPhiIndex::Float> eta ;
+      std::vector<CaloCellEtaPhiIndex::Float> phi ;
+      CaloCellEtaPhiIndex::IndexVec           cell ;
+      eta.reserve( m_validIds.size() ) ;
+      phi.reserve( m_validIds.size() ) ;
+      cell.reserve( m_validIds.size() ) ;
+      for( uint32_t i ( 0 ); i != m_validIds.size() ; ++i ) 
       {
-	 const GlobalPoint& p ( cell->getPosition() ) ;
-	 const CCGFloat eta0 ( p.eta() ) ;
-	 const CCGFloat phi0 ( p.phi() ) ;
-	 const CCGFloat dR2 ( reco::deltaR2( eta0, phi0, eta, phi ) ) ;
-	 if( dR2 < closest ) 
+	 const CaloCellGeometry* cellPtr ( getGeometry( m_validIds[i] ) ) ;
+	 if( 0 != cellPtr )
 	 {
-	    closest = dR2 ;
-	    index   = i   ;
+	    const GlobalPoint& p ( cellPtr->getPosition() ) ;
+	    eta.push_back( p.eta() ) ;
+	    phi.push_back( p.phi() ) ;
+	    cell.push_back( i ) ;
 	 }
       }
+      auto ptr = new CaloCellEtaPhiIndex( eta, phi, cell ) ;
+      CaloCellEtaPhiIndex* expect = nullptr;
+      bool exchanged = m_etaPhiIndex.compare_exchange_strong(expect, ptr, std::memory_order_acq_rel);
+      if (!exchanged) delete ptr;
    }
-   return ( closest > 0.9e9 ||
-	    (uint32_t)(~0) == index       ? DetId(0) :
-	    m_validIds[index] ) ;
+   return *m_etaPhiIndex.load(std::memory_order_acquire) ;
 }
 
-CaloSubdetectorGeometry::DetIdSet 
-CaloSubdetectorGeometry::getCells( const GlobalPoint& r, 
-				   double dR             ) const 
+DetId 
+CaloSubdetectorGeometry::getClosestCell( const GlobalPoint& r ) const 
 {
-   const double dR2 ( dR*dR ) ;
-   const double eta ( r.eta() ) ;
-   const double phi ( r.phi() ) ;
+   const CaloCellEtaPhiIndex& index ( etaPhiIndex() ) ;
+   const unsigned int i ( index.closestCell( r.eta(), r.phi() ) ) ;
+   return ( i < m_validIds.size() ? m_validIds[i] : DetId(0) ) ;
+}
 
-   DetIdSet dss;
-   
+void
+CaloSubdetectorGeometry::getCellsInCone( const GlobalPoint&  r   ,
+					 double              dR  ,
+					 std::vector<DetId>& ids   ) const 
+{
    if( 0.000001 < dR )
    {
-      for( uint32_t i ( 0 ); i != m_validIds.size() ; ++i ) 
-      {
-	 const CaloCellGeometry* cell ( getGeometry( m_validIds[i] ) ) ;
-	 if( 0 != cell )
-	 {
-	    const GlobalPoint& p ( cell->getPosition() ) ;
-	    const CCGFloat eta0 ( p.eta() ) ;
-	    if( fabs( eta - eta0 ) < dR )
-	    {
-	       const CCGFloat phi0 ( p.phi() ) ;
-	       CCGFloat delp ( fabs( phi - phi0 ) ) ;
-	       if( delp > M_PI ) delp = 2*M_PI - delp ;
-	       if( delp < dR )
-	       {
-		  const CCGFloat dist2 ( reco::deltaR2( eta0, phi0, eta, phi ) ) ;
-		  if( dist2 < dR2 ) dss.insert( m_validIds[i] ) ;
-	       }
-	    }
-	 }
-      }   
+      CaloCellEtaPhiIndex::IndexVec found ;
+      etaPhiIndex().cellsInCone( r.eta(), r.phi(), dR, found ) ;
+      ids.reserve( ids.size() + found.size() ) ;
+      for( auto i : found ) ids.push_back( m_validIds[i] ) ;
    }
-   return dss;
+}
+
+CaloSubdetectorGeometry::DetIdSet 
+CaloSubdetectorGeometry::getCells( const GlobalPoint& r, 
+				   double dR             ) const 
+{
+   std::vector<DetId> ids ;
+   getCellsInCone( r, dR, ids ) ;
+   return DetIdSet( ids.begin(), ids.end() ) ;
 }
 
 CaloSubdetectorGeometry::CellSet 
 CaloSubdetectorGeometry::getCellSet( const GlobalPoint& r, double dR ) const {
-  // stupid implementation not to be really used...
+  // through the virtual getCells, so the subdetector specific searches are used
   DetIdSet ids = getCells(r, dR);
   CellSet cells; cells.reserve(ids.size());
   for ( auto id : ids) cells.push_back(getGeometry(id));
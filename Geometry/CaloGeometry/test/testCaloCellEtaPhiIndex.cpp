@@ -0,0 +1,169 @@
+#include "Geometry/CaloGeometry/interface/CaloCellEtaPhiIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+typedef CaloCellEtaPhiIndex::Float    Float ;
+typedef CaloCellEtaPhiIndex::IndexVec IndexVec ;
+
+namespace
+{
+   Float dist2( Float eta1, Float phi1, Float eta2, Float phi2 )
+   {
+      const Float deta ( eta1 - eta2 ) ;
+      Float dphi ( std::abs( phi1 - phi2 ) ) ;
+      if( dphi > Float( M_PI ) ) dphi = Float( 2*M_PI ) - dphi ;
+      return deta*deta + dphi*dphi ;
+   }
+
+   // the linear searches that CaloSubdetectorGeometry used before the index
+   void bruteCone( const std::vector<Float>& eta, const std::vector<Float>& phi,
+		   Float eta0, Float phi0, Float dR, IndexVec& out )
+   {
+      for( unsigned int i ( 0 ) ; i != eta.size() ; ++i )
+      {
+	 if( dist2( eta[i], phi[i], eta0, phi0 ) < dR*dR ) out.push_back( i ) ;
+      }
+   }
+
+   unsigned int bruteClosest( const std::vector<Float>& eta, const std::vector<Float>& phi,
+			      Float eta0, Float phi0 )
+   {
+      unsigned int index ( ~0u ) ;
+      Float closest ( 1e9 ) ;
+      for( unsigned int i ( 0 ) ; i != eta.size() ; ++i )
+      {
+	 const Float d2 ( dist2( eta[i], phi[i], eta0, phi0 ) ) ;
+	 if( d2 < closest )
+	 {
+	    closest = d2 ;
+	    index   = i ;
+	 }
+      }
+      return index ;
+   }
+
+   // regular barrel-like grid plus two endcap-like random discs
+   void makeCells( std::vector<Float>& eta, std::vector<Float>& phi, std::mt19937& gen )
+   {
+      for( int ie ( -85 ) ; ie != 85 ; ++ie )
+      {
+	 for( int ip ( 0 ) ; ip != 360 ; ++ip )
+	 {
+	    eta.push_back( ( ie + 0.5 )*0.0174 ) ;
+	    phi.push_back( -M_PI + ( ip + 0.5 )*2*M_PI/360 ) ;
+	 }
+      }
+      std::uniform_real_distribution<Float> uEta ( 1.5, 3.0 ) ;
+      std::uniform_real_distribution<Float> uPhi ( -M_PI, M_PI ) ;
+      for( unsigned int i ( 0 ) ; i != 15000 ; ++i )
+      {
+	 const Float e ( uEta( gen ) ) ;
+	 eta.push_back( i%2 ? e : -e ) ;
+	 phi.push_back( uPhi( gen ) ) ;
+      }
+   }
+}
+
+int main()
+{
+   std::mt19937 gen ( 12345 ) ;
+   std::vector<Float> eta ;
+   std::vector<Float> phi ;
+   makeCells( eta, phi, gen ) ;
+
+   const CaloCellEtaPhiIndex index ( eta, phi ) ;
+   std::cout << "index of " << index.size() << " cells in "
+	     << index.nEtaBins() << " x " << index.nPhiBins() << " bins" << std::endl ;
+
+   std::uniform_real_distribution<Float> uEta ( -3.5, 3.5 ) ;
+   std::uniform_real_distribution<Float> uPhi ( -M_PI, M_PI ) ;
+   std::uniform_real_distribution<Float> uDR  ( 0.01, 0.5 ) ;
+
+   const unsigned int nQuery ( 2000 ) ;
+   std::vector<Float> qEta, qPhi, qDR ;
+   for( unsigned int i ( 0 ) ; i != nQuery ; ++i )
+   {
+      qEta.push_back( uEta( gen ) ) ;
+      qPhi.push_back( uPhi( gen ) ) ;
+      qDR.push_back( uDR( gen ) ) ;
+   }
+   // wrap-around and out of acceptance corner cases
+   qEta.push_back( 0.1 ) ; qPhi.push_back( Float( M_PI ) ) ; qDR.push_back( 0.3 ) ;
+   qEta.push_back( 0.1 ) ; qPhi.push_back( Float( -M_PI ) ) ; qDR.push_back( 4. ) ;
+   qEta.push_back( 8.0 ) ; qPhi.push_back( 0 ) ; qDR.push_back( 0.3 ) ;
+
+   unsigned int nFail ( 0 ) ;
+   IndexVec fast, slow ;
+   for( unsigned int i ( 0 ) ; i != qEta.size() ; ++i )
+   {
+      fast.clear() ;
+      slow.clear() ;
+      index.cellsInCone( qEta[i], qPhi[i], qDR[i], fast ) ;
+      bruteCone( eta, phi, qEta[i], qPhi[i], qDR[i], slow ) ;
+      std::sort( fast.begin(), fast.end() ) ;
+      if( fast != slow )
+      {
+	 std::cout << "cone mismatch at " << qEta[i] << " " << qPhi[i] << " " << qDR[i]
+		   << ": " << fast.size() << " vs " << slow.size() << std::endl ;
+	 ++nFail ;
+      }
+      if( index.closestCell( qEta[i], qPhi[i] ) != bruteClosest( eta, phi, qEta[i], qPhi[i] ) )
+      {
+	 std::cout << "closest mismatch at " << qEta[i] << " " << qPhi[i] << std::endl ;
+	 ++nFail ;
+      }
+   }
+
+   // points on the z axis have eta = +-inf, or nan for the origin: no
+   // closest cell and an empty cone, as with the linear search
+   const Float inf ( std::numeric_limits<Float>::infinity() ) ;
+   const Float nan ( std::numeric_limits<Float>::quiet_NaN() ) ;
+   const Float badEta[] = { inf, -inf, nan, 0.1f, 0.1f } ;
+   const Float badPhi[] = { 0,   0,    0,   nan,  inf  } ;
+   for( unsigned int i ( 0 ) ; i != 5 ; ++i )
+   {
+      fast.clear() ;
+      index.cellsInCone( badEta[i], badPhi[i], 0.3, fast ) ;
+      if( index.closestCell( badEta[i], badPhi[i] ) != ~0u ||
+	  bruteClosest( eta, phi, badEta[i], badPhi[i] ) != ~0u ||
+	  !fast.empty() )
+      {
+	 std::cout << "non-finite query " << badEta[i] << " " << badPhi[i]
+		   << " found a cell" << std::endl ;
+	 ++nFail ;
+      }
+   }
+
+   // timing comparison of the two search strategies
+   typedef std::chrono::high_resolution_clock Clock ;
+   unsigned int nFound ( 0 ) ;
+   Clock::time_point t0 ( Clock::now() ) ;
+   for( unsigned int i ( 0 ) ; i != nQuery ; ++i )
+   {
+      slow.clear() ;
+      bruteCone( eta, phi, qEta[i], qPhi[i], 0.3, slow ) ;
+      nFound += slow.size() + bruteClosest( eta, phi, qEta[i], qPhi[i] ) ;
+   }
+   Clock::time_point t1 ( Clock::now() ) ;
+   for( unsigned int i ( 0 ) ; i != nQuery ; ++i )
+   {
+      fast.clear() ;
+      index.cellsInCone( qEta[i], qPhi[i], 0.3, fast ) ;
+      nFound -= fast.size() + index.closestCell( qEta[i], qPhi[i] ) ;
+   }
+   Clock::time_point t2 ( Clock::now() ) ;
+   std::cout << "linear search " << std::chrono::duration<double, std::micro>( t1 - t0 ).count()/nQuery
+	     << " us/query, index " << std::chrono::duration<double, std::micro>( t2 - t1 ).count()/nQuery
+	     << " us/query" << std::endl ;
+
+   if( 0 != nFound ) ++nFail ;
+   std::cout << ( 0 == nFail ? "OK" : "FAILED" ) << std::endl ;
+   return ( 0 == nFail ? EXIT_SUCCESS : EXIT_FAILURE ) ;
+}
@@ -0,0 +1,66 @@
+#include "Geometry/CaloGeometry/interface/CaloSubdetectorGeometry.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+   // stands for the subdetectors (EB, EE, HCAL, HGCal) with their own getCells
+   class OverridingGeometry : public CaloSubdetectorGeometry
+   {
+   public:
+      OverridingGeometry() : nGetCells ( 0 ) {}
+
+      void newCell( const GlobalPoint& , const GlobalPoint& , const GlobalPoint& ,
+		    const CCGFloat* , const DetId& ) override {}
+
+      DetIdSet getCells( const GlobalPoint& , double ) const override
+      {
+	 ++nGetCells ;
+	 DetIdSet ids ;
+	 ids.insert( DetId( DetId::Ecal, 1 ) ) ;
+	 ids.insert( DetId( DetId::Ecal, 2 ) ) ;
+	 ids.insert( DetId( DetId::Hcal, 1 ) ) ;
+	 return ids ;
+      }
+
+      const CaloCellGeometry* getGeometry( const DetId& id ) const override
+      {
+	 asked.push_back( id ) ;
+	 return nullptr ;
+      }
+
+      mutable unsigned int       nGetCells ;
+      mutable std::vector<DetId> asked ;
+
+   protected:
+      const CaloCellGeometry* cellGeomPtr( uint32_t ) const override { return nullptr ; }
+   };
+}
+
+int main()
+{
+   const OverridingGeometry geom ;
+   const CaloSubdetectorGeometry& base ( geom ) ;
+   const GlobalPoint point ( 10., 20., 30. ) ;
+
+   const CaloSubdetectorGeometry::DetIdSet ids ( base.getCells( point, 0.3 ) ) ;
+   geom.nGetCells = 0 ;
+   const CaloSubdetectorGeometry::CellSet cells ( base.getCellSet( point, 0.3 ) ) ;
+
+   unsigned int nFail ( 0 ) ;
+   if( 1 != geom.nGetCells )
+   {
+      std::cout << "getCellSet did not use the overriding getCells" << std::endl ;
+      ++nFail ;
+   }
+   if( cells.size() != ids.size() ||
+       geom.asked != std::vector<DetId>( ids.begin(), ids.end() ) )
+   {
+      std::cout << "getCellSet returned other cells than getCells" << std::endl ;
+      ++nFail ;
+   }
+   std::cout << ( 0 == nFail ? "OK" : "FAILED" ) << std::endl ;
+   return ( 0 == nFail ? EXIT_SUCCESS : EXIT_FAILURE ) ;
+}
@@ -107,6 +107,10 @@ public:
   DetId offsetBy(const DetId startId, int nrStepsX, int nrStepsY) const;
   DetId switchZSide(const DetId startId) const;
 
+  /** returns all the cells adjacent to the given one in the same layer; in
+   * hexagon mode these include the cells of the neighbouring wafers */
+  std::vector<DetId> neighbours(const DetId& id) const;
+
   /// Use subSector in square mode as wafer type in hexagon mode
   static const int subSectors_ = 2;
 
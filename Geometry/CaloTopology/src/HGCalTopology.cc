@@ -125,6 +125,27 @@ DetId HGCalTopology::switchZSide(const DetId startId) const {
   return DetId(0);
 }
 
+std::vector<DetId> HGCalTopology::neighbours(const DetId& id) const {
+
+  std::vector<DetId> ids;
+  if (mode_ == HGCalGeometryMode::Square) {
+    for (const auto& nb : {north(id), south(id), east(id), west(id)})
+      ids.insert(ids.end(), nb.begin(), nb.end());
+  } else {
+    HGCalTopology::DecodedDetId id_ = decode(id);
+    std::vector<std::pair<int,int> > cells;
+    hdcons_.neighbourCellsHex(id_.iCell, id_.iSec, id_.iLay, true, cells);
+    for (const auto& cell : cells) {
+      id_.iSec    = cell.first;
+      id_.iSubSec = (hdcons_.waferTypeT(cell.first) == 1) ? 1 : -1;
+      id_.iCell   = cell.second;
+      DetId nextPoint = encode(id_);
+      if (valid(nextPoint)) ids.push_back(nextPoint);
+    }
+  }
+  return ids;
+}
+
 HGCalTopology::DecodedDetId HGCalTopology::geomDenseId2decId(const uint32_t& hi) const {
 
   HGCalTopology::DecodedDetId id_;
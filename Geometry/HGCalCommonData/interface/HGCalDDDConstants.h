@@ -18,6 +18,7 @@
 #include "Geometry/HGCalCommonData/interface/HGCalGeometryMode.h"
 #include "DetectorDescription/Core/interface/DDsvalues.h"
 
+#include <array>
 #include <unordered_map>
 
 class HGCalDDDConstants {
@@ -59,6 +60,11 @@ public:
   std::pair<int,int>  newCell(int cell, int layer, int subsector, int incrz,
 			      bool half) const;
   int                 newCell(int kx, int ky, int lay, int subSec) const;
+  // neighbours (wafer,cell) of a cell in hexagon mode, including the ones
+  // in the adjacent wafers of the same layer
+  void                neighbourCellsHex(int cell, int wafer, int lay, 
+					bool reco, std::vector<std::pair<int,int> >& cells) const;
+  void                neighbourWafers(int wafer, std::vector<int>& wafers) const;
   std::vector<int>    numberCells(int lay, bool reco) const;
   std::vector<int>    numberCellsSquare(float h, float bl, float tl, 
 					float alpha, float cellSize) const;
@@ -88,9 +94,27 @@ public:
   std::pair<int,float> getIndex(int lay, bool reco) const;
 
 private:
-  int cellHex(double xx, double yy, const double& cellR, 
-	      const std::vector<double>& posX,
-	      const std::vector<double>& posY) const;  
+  // Positions of the hexagons (wafers in a layer or cells in a wafer) of one
+  // kind together with a uniform x-y grid of bin size 2*cellR listing, in 
+  // increasing order, the hexagons overlapping each bin and the table of 
+  // adjacent hexagons.  All wafers of a given type share the cell table.
+  struct HexLookup {
+    void fill(const std::vector<double>& posX, const std::vector<double>& posY,
+	      double cellR);
+    // index of the first hexagon containing (xx,yy), 0 if there is none
+    int  find(double xx, double yy) const;
+    // appends the hexagons with centre within dist of (xx,yy)
+    void near(double xx, double yy, double dist, std::vector<int>& out) const;
+    int  bin(double xx, double yy) const;
+
+    std::vector<double> posX_, posY_;
+    double              cellR_, cellY_, xmin_, ymin_, bin_;
+    int                 nx_, ny_;
+    std::vector<int>    offset_, index_;
+    std::vector<int>    nbOffset_, nb_;
+  };
+
+  static bool insideHex(double dx, double dy, double cellR, double cellY);
   void getParameterSquare(int lay, int subSec, bool reco, float& h, float& bl,
 			  float& tl, float& alpha) const;
   bool waferInLayer(int wafer, int lay) const;
@@ -102,6 +126,9 @@ private:
   int32_t tot_wafers_;
   std::array<uint32_t,2> tot_layers_;
   simrecovecs max_modules_layer_; 
+  HexLookup              waferLookup_;
+  std::array<HexLookup,2> cellLookup_;      // fine, coarse
+  std::vector<std::vector<bool> > waferIn_;  // [layer index][wafer]
 };
 
 #endif
@@ -12,6 +12,9 @@
 #include "CLHEP/Units/GlobalPhysicalConstants.h"
 #include "CLHEP/Units/GlobalSystemOfUnits.h"
 
+#include <algorithm>
+#include <cmath>
+
 //#define DebugLog
 
 constexpr double k_horizontalShift = 1.0;
@@ -41,6 +44,24 @@ HGCalDDDConstants::HGCalDDDConstants(const HGCalParameters* hp,
   } else {
     rmax_ = k_ScaleFromDDD * (hgpar_->waferR_) * std::cos(30.0*CLHEP::deg);
 
+    // lookup tables for the wafers and for the cells of the two wafer types
+    waferLookup_.fill(hgpar_->waferPosX_, hgpar_->waferPosY_, rmax_);
+    cellLookup_[0].fill(hgpar_->cellFineX_, hgpar_->cellFineY_, 
+			cellSizeHex(1));
+    cellLookup_[1].fill(hgpar_->cellCoarseX_, hgpar_->cellCoarseY_, 
+			cellSizeHex(2));
+    const double rr = 2*rmax_*tan30deg_;
+    waferIn_.resize(hgpar_->rMinLayHex_.size());
+    for (unsigned int i=0; i<waferIn_.size(); ++i) {
+      waferIn_[i].resize(hgpar_->waferPosX_.size());
+      for (unsigned int k=0; k<hgpar_->waferPosX_.size(); ++k) {
+	const double rpos = std::sqrt(hgpar_->waferPosX_[k]*hgpar_->waferPosX_[k] +
+				      hgpar_->waferPosY_[k]*hgpar_->waferPosY_[k]);
+	waferIn_[i][k] = (rpos-rr >= hgpar_->rMinLayHex_[i] && 
+			  rpos+rr <= hgpar_->rMaxLayHex_[i]);
+      }
+    }
+
     // init maps and constants    
     for( int simreco = 0; simreco < 2; ++simreco ) {
       tot_layers_[simreco] = layersInit((bool)simreco);
@@ -135,15 +156,11 @@ std::pair<int,int> HGCalDDDConstants::assignCellHexagon(float x,
 							float y) const {
   double xx(x), yy(y);
   //First the wafer
-  int wafer = cellHex(xx, yy, rmax_, hgpar_->waferPosX_, hgpar_->waferPosY_);
+  int wafer = waferLookup_.find(xx, yy);
   // Now the cell
   xx -= hgpar_->waferPosX_[wafer];
   yy -= hgpar_->waferPosY_[wafer];
-  int cell(0);
-  if (hgpar_->waferTypeT_[wafer] == 1) 
-    cell  = cellHex(xx, yy, 0.5*k_ScaleFromDDD*hgpar_->cellSize_[0], hgpar_->cellFineX_, hgpar_->cellFineY_);
-  else
-    cell  = cellHex(xx, yy, 0.5*k_ScaleFromDDD*hgpar_->cellSize_[1], hgpar_->cellCoarseX_, hgpar_->cellCoarseY_);
+  int cell = cellLookup_[(hgpar_->waferTypeT_[wafer] == 1) ? 0 : 1].find(xx, yy);
   return std::pair<int,int>(wafer,cell);
 }
 
@@ -609,25 +626,152 @@ bool HGCalDDDConstants::isHalfCell(int waferType, int cell) const {
   return waferType == 2 ? hgpar_->cellCoarseHalf_[cell] : hgpar_->cellFineHalf_[cell];
 }
 
-int HGCalDDDConstants::cellHex(double xx, double yy, 
-                               const double& cellR, 
-			       const std::vector<double>& posX,
-			       const std::vector<double>& posY) const {
-  int num(0);
+void HGCalDDDConstants::neighbourCellsHex(int cell, int wafer, int lay,
+					  bool reco, 
+					  std::vector<std::pair<int,int> >& cells) const {
+
+  std::pair<int,float> index = getIndex(lay, reco);
+  if (index.first < 0 || wafer < 0 || 
+      wafer >= (int)(hgpar_->waferTypeT_.size())) return;
+  const int        type = (hgpar_->waferTypeT_[wafer] == 1) ? 0 : 1;
+  const HexLookup& own  = cellLookup_[type];
+  if (cell < 0 || cell >= (int)(own.posX_.size())) return;
+  for (int k=own.nbOffset_[cell]; k<own.nbOffset_[cell+1]; ++k)
+    cells.push_back(std::pair<int,int>(wafer,own.nb_[k]));
+
+  // cells of the adjacent wafers touching this one
+  const double xx = hgpar_->waferPosX_[wafer] + own.posX_[cell];
+  const double yy = hgpar_->waferPosY_[wafer] + own.posY_[cell];
+  std::vector<int> near;
+  for (int k=waferLookup_.nbOffset_[wafer]; k<waferLookup_.nbOffset_[wafer+1]; ++k) {
+    const int w = waferLookup_.nb_[k];
+    if (!waferInLayer(w,index.first)) continue;
+    const HexLookup& other = cellLookup_[(hgpar_->waferTypeT_[w] == 1) ? 0 : 1];
+    near.clear();
+    other.near(xx-hgpar_->waferPosX_[w], yy-hgpar_->waferPosY_[w],
+	       1.25*(own.cellR_+other.cellR_), near);
+    for (auto c : near) cells.push_back(std::pair<int,int>(w,c));
+  }
+}
+
+void HGCalDDDConstants::neighbourWafers(int wafer, 
+					std::vector<int>& wafers) const {
+  if (wafer < 0 || wafer+1 >= (int)(waferLookup_.nbOffset_.size())) return;
+  wafers.insert(wafers.end(), 
+		waferLookup_.nb_.begin()+waferLookup_.nbOffset_[wafer],
+		waferLookup_.nb_.begin()+waferLookup_.nbOffset_[wafer+1]);
+}
+
+bool HGCalDDDConstants::insideHex(double dx, double dy, double cellR,
+				  double cellY) {
   const double tol(0.00001);
-  double cellY = 2.0*cellR*tan30deg_;
-  for (unsigned int k=0; k<posX.size(); ++k) {
-    double dx = std::abs(xx - posX[k]);
-    double dy = std::abs(yy - posY[k]);
-    if (dx <= (cellR+tol) && dy <= (cellY+tol)) {
-      double xmax = (dy<=0.5*cellY) ? cellR : (cellR-(dy-0.5*cellY)/tan30deg_);
-      if (dx <= (xmax+tol)) {
-	num = k;
-	break;
+  dx = std::abs(dx);
+  dy = std::abs(dy);
+  if (dx <= (cellR+tol) && dy <= (cellY+tol)) {
+    double xmax = (dy<=0.5*cellY) ? cellR : (cellR-(dy-0.5*cellY)/tan30deg_);
+    if (dx <= (xmax+tol)) return true;
+  }
+  return false;
+}
+
+void HGCalDDDConstants::HexLookup::fill(const std::vector<double>& posX,
+					const std::vector<double>& posY,
+					double cellR) {
+  posX_  = posX;
+  posY_  = posY;
+  cellR_ = cellR;
+  cellY_ = 2.0*cellR*tan30deg_;
+  bin_   = (cellR > 0) ? 2.0*cellR : 1.0;
+  offset_.clear(); index_.clear(); nbOffset_.clear(); nb_.clear();
+  nx_ = ny_ = 0;
+  xmin_ = ymin_ = 0;
+  const int n = (int)(std::min(posX_.size(),posY_.size()));
+  if (n == 0) return;
+
+  // grid covering the bounding boxes of all hexagons with one spare bin
+  const double xlo = *std::min_element(posX_.begin(),posX_.begin()+n);
+  const double xhi = *std::max_element(posX_.begin(),posX_.begin()+n);
+  const double ylo = *std::min_element(posY_.begin(),posY_.begin()+n);
+  const double yhi = *std::max_element(posY_.begin(),posY_.begin()+n);
+  xmin_ = xlo - cellR_ - bin_;
+  ymin_ = ylo - cellY_ - bin_;
+  nx_   = (int)((xhi - xmin_ + cellR_)/bin_) + 2;
+  ny_   = (int)((yhi - ymin_ + cellY_)/bin_) + 2;
+
+  // counting sort of the hexagons into every bin their bounding box
+  // (enlarged by a margin for rounding) overlaps; bins stay sorted by index
+  const double mx = cellR_ + 0.01*bin_;
+  const double my = cellY_ + 0.01*bin_;
+  offset_.assign(nx_*ny_+1, 0);
+  for (int pass=0; pass<2; ++pass) {
+    std::vector<int> slot(offset_.begin(), offset_.end()-1);
+    if (pass == 1) index_.resize(offset_.back());
+    for (int k=0; k<n; ++k) {
+      const int ix0 = std::max(0,     (int)((posX_[k]-mx-xmin_)/bin_));
+      const int ix1 = std::min(nx_-1, (int)((posX_[k]+mx-xmin_)/bin_));
+      const int iy0 = std::max(0,     (int)((posY_[k]-my-ymin_)/bin_));
+      const int iy1 = std::min(ny_-1, (int)((posY_[k]+my-ymin_)/bin_));
+      for (int iy=iy0; iy<=iy1; ++iy) {
+	for (int ix=ix0; ix<=ix1; ++ix) {
+	  if (pass == 0) ++offset_[iy*nx_+ix+1];
+	  else           index_[slot[iy*nx_+ix]++] = k;
+	}
+      }
+    }
+    if (pass == 0) {
+      for (unsigned int b=1; b<offset_.size(); ++b) offset_[b] += offset_[b-1];
+    }
+  }
+
+  // adjacent hexagons: centres are 2*cellR apart, the next ring at 3.46*cellR
+  std::vector<int> near;
+  nbOffset_.reserve(n+1);
+  nbOffset_.push_back(0);
+  for (int k=0; k<n; ++k) {
+    near.clear();
+    this->near(posX_[k], posY_[k], 2.5*cellR_, near);
+    for (auto j : near) if (j != k) nb_.push_back(j);
+    nbOffset_.push_back((int)(nb_.size()));
+  }
+}
+
+int HGCalDDDConstants::HexLookup::bin(double xx, double yy) const {
+  const double fx = (xx-xmin_)/bin_;
+  const double fy = (yy-ymin_)/bin_;
+  if (fx < 0 || fy < 0 || fx >= nx_ || fy >= ny_) return -1;
+  return ((int)(fy))*nx_ + (int)(fx);
+}
+
+int HGCalDDDConstants::HexLookup::find(double xx, double yy) const {
+  const int b = bin(xx, yy);
+  if (b < 0) return 0;
+  for (int j=offset_[b]; j<offset_[b+1]; ++j) {
+    const int k = index_[j];
+    if (insideHex(xx-posX_[k], yy-posY_[k], cellR_, cellY_)) return k;
+  }
+  return 0;
+}
+
+void HGCalDDDConstants::HexLookup::near(double xx, double yy, double dist,
+					std::vector<int>& out) const {
+  if (nx_ == 0) return;
+  const int ix0 = std::max(0,     (int)(std::floor((xx-dist-xmin_)/bin_)));
+  const int ix1 = std::min(nx_-1, (int)(std::floor((xx+dist-xmin_)/bin_)));
+  const int iy0 = std::max(0,     (int)(std::floor((yy-dist-ymin_)/bin_)));
+  const int iy1 = std::min(ny_-1, (int)(std::floor((yy+dist-ymin_)/bin_)));
+  for (int iy=iy0; iy<=iy1; ++iy) {
+    for (int ix=ix0; ix<=ix1; ++ix) {
+      const int b = iy*nx_+ix;
+      for (int j=offset_[b]; j<offset_[b+1]; ++j) {
+	// a hexagon is listed in several bins: take it from the one of its centre
+	const int k = index_[j];
+	if (bin(posX_[k], posY_[k]) != b) continue;
+	const double dx = xx-posX_[k];
+	const double dy = yy-posY_[k];
+	if (dx*dx+dy*dy <= dist*dist) out.push_back(k);
       }
     }
   }
-  return num;
 }
 
 std::pair<int,float> HGCalDDDConstants::getIndex(int lay, bool reco) const {
@@ -665,6 +809,9 @@ void HGCalDDDConstants::getParameterSquare(int lay, int subSec, bool reco,
 
 bool HGCalDDDConstants::waferInLayer(int wafer, int lay) const {
 
+  if (lay >= 0 && lay < (int)(waferIn_.size()) && 
+      wafer >= 0 && wafer < (int)(waferIn_[lay].size()))
+    return waferIn_[lay][wafer];
   const double rr   = 2*rmax_*tan30deg_;
   const double waferX = hgpar_->waferPosX_[wafer];
   const double waferY = hgpar_->waferPosY_[wafer];
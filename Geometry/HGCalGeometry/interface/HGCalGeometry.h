@@ -68,6 +68,10 @@ public:
 			   CaloSubdetectorGeometry::IVec& dinsVector ) const override;
   
   GlobalPoint getPosition( const DetId& id ) const;
+
+  /// Positions of a set of cells (e.g. all hits of an event) in one go
+  void getPositions( const std::vector<DetId>& ids,
+		     std::vector<GlobalPoint>& positions ) const;
       
   /// Returns the corner points of this cell's volume.
   CornersVec getCorners( const DetId& id ) const; 
@@ -112,6 +116,10 @@ private:
   
   CellVec                 m_cellVec ; 
   std::vector<DetId>      m_validGeomIds;
+  // z of every layer (both sides), sorted, and the modules of each layer;
+  // used to find the module of a point in hexagon mode
+  std::vector<float>                      m_layerZ;
+  std::vector<std::vector<unsigned int> > m_layerCells;
   bool                    m_halfType;
   ForwardSubdetector      m_subdet;
 };
@@ -11,6 +11,7 @@
 #include "Geometry/CaloGeometry/interface/TruncatedPyramid.h"
 #include "FWCore/Utilities/interface/Exception.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <Math/Transform3D.h>
@@ -72,6 +73,15 @@ void HGCalGeometry::newCell( const GlobalPoint& f1 ,
   m_cellVec.at( cellIndex ) = FlatTrd( cornersMgr(), f1, f2, f3, parm ) ;
   m_validGeomIds.at( cellIndex ) = geomId ;
 
+  const float z = m_cellVec[cellIndex].getPosition().z();
+  auto itr = std::lower_bound(m_layerZ.begin(), m_layerZ.end(), z-0.001f);
+  const unsigned int lay = itr - m_layerZ.begin();
+  if (itr == m_layerZ.end() || *itr > z+0.001f) {
+    m_layerZ.insert(itr, z);
+    m_layerCells.insert(m_layerCells.begin()+lay, std::vector<unsigned int>());
+  }
+  m_layerCells[lay].push_back(cellIndex);
+
 #ifdef DebugLog
   unsigned int nOld = m_validIds.size();
 #endif
@@ -155,6 +165,28 @@ GlobalPoint HGCalGeometry::getPosition(const DetId& id) const {
   return glob;
 }
 
+void HGCalGeometry::getPositions(const std::vector<DetId>& ids,
+				 std::vector<GlobalPoint>& positions) const {
+
+  positions.clear();
+  positions.reserve(ids.size());
+  const HGCalDDDConstants& hdcons = topology().dddConstants();
+  const bool square = (hdcons.geomMode() == HGCalGeometryMode::Square);
+  for (const auto& id : ids) {
+    unsigned int cellIndex = indexFor(id);
+    if (cellIndex < m_cellVec.size()) {
+      HGCalTopology::DecodedDetId id_ = topology().decode(id);
+      std::pair<float,float> xy = (square ?
+	hdcons.locateCell(id_.iCell,id_.iLay,id_.iSubSec,true) :
+	hdcons.locateCellHex(id_.iCell,id_.iSec,true));
+      const HepGeom::Point3D<float> lcoord(xy.first,xy.second,0);
+      positions.push_back(m_cellVec[cellIndex].getPosition(lcoord));
+    } else {
+      positions.push_back(GlobalPoint());
+    }
+  }
+}
+
 HGCalGeometry::CornersVec HGCalGeometry::getCorners(const DetId& id) const {
 
   HGCalGeometry::CornersVec co (8, GlobalPoint(0,0,0));
@@ -273,6 +305,31 @@ unsigned int HGCalGeometry::getClosestCellIndex (const GlobalPoint& r) const {
   float zp   = r.z();
   unsigned int cellIndex =  m_cellVec.size();
   float dzmin(9999), dphimin(9999), dphi10(0.175);
+  if (topology().dddConstants().geomMode() != HGCalGeometryMode::Square) {
+    // same choice as the loop below: the nearest layer in z having a module
+    // within dphi10 in phi, and in it the module nearest in phi; the layers
+    // are tried in order of their distance in z
+    int hi = std::lower_bound(m_layerZ.begin(), m_layerZ.end(), zp) - m_layerZ.begin();
+    int lo = hi-1;
+    while (cellIndex >= m_cellVec.size() && (lo >= 0 || hi < (int)(m_layerZ.size()))) {
+      int lay;
+      if (hi >= (int)(m_layerZ.size()) || (lo >= 0 && (zp-m_layerZ[lo]) < (m_layerZ[hi]-zp)))
+	lay = lo--;
+      else
+	lay = hi++;
+      dphimin = dphi10;
+      for (auto k : m_layerCells[lay]) {
+	float dphi = phip-m_cellVec[k].phiPos();
+	while (dphi >   M_PI) dphi -= 2*M_PI;
+	while (dphi <= -M_PI) dphi += 2*M_PI;
+	if (fabs(dphi) < dphimin) {
+	  cellIndex = k;
+	  dphimin   = fabs(dphi);
+	}
+      }
+    }
+    return cellIndex;
+  }
   for (unsigned int k=0; k<m_cellVec.size(); ++k) {
     float dphi = phip-m_cellVec[k].phiPos();
     while (dphi >   M_PI) dphi -= 2*M_PI;
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/one/EDAnalyzer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "Geometry/Records/interface/IdealGeometryRecord.h"
+#include "Geometry/HGCalCommonData/interface/HGCalParameters.h"
+#include "Geometry/HGCalGeometry/interface/HGCalGeometry.h"
+#include "DataFormats/ForwardDetId/interface/HGCalDetId.h"
+
+// Compares, in hexagon mode, getClosestCell and assignCellHexagon with the
+// linear searches they replaced over a grid of points, and getPositions
+// with getPosition for all valid ids.  Prints the number of differences
+// and "***** ERROR *****" if there are any.
+
+class HGCalGeometryLookupTester : public edm::one::EDAnalyzer<> {
+public:
+  explicit HGCalGeometryLookupTester(const edm::ParameterSet& );
+  ~HGCalGeometryLookupTester();
+
+  void beginJob() override {}
+  void analyze(edm::Event const& iEvent, edm::EventSetup const&) override;
+  void endJob() override {}
+
+private:
+  int   cellHex(double xx, double yy, double cellR,
+		const std::vector<double>& posX,
+		const std::vector<double>& posY) const;
+  std::pair<int,int> assignCellHexagon(const HGCalParameters& hp,
+				       float x, float y) const;
+  DetId getClosestCell(const HGCalGeometry& geom, const HGCalParameters& hp,
+		       const GlobalPoint& r) const;
+
+  std::string    name;
+  double         step, stepXY;
+};
+
+HGCalGeometryLookupTester::HGCalGeometryLookupTester(const edm::ParameterSet& iC) {
+  name   = iC.getParameter<std::string>("Detector");
+  step   = iC.getParameter<double>("Step");
+  stepXY = iC.getParameter<double>("StepXY");
+}
+
+HGCalGeometryLookupTester::~HGCalGeometryLookupTester() {}
+
+// the linear search HGCalDDDConstants::cellHex used before the lookup tables
+int HGCalGeometryLookupTester::cellHex(double xx, double yy, double cellR,
+				       const std::vector<double>& posX,
+				       const std::vector<double>& posY) const {
+  const double tan30deg(0.5773502693), tol(0.00001);
+  int num(0);
+  double cellY = 2.0*cellR*tan30deg;
+  for (unsigned int k=0; k<posX.size(); ++k) {
+    double dx = std::abs(xx - posX[k]);
+    double dy = std::abs(yy - posY[k]);
+    if (dx <= (cellR+tol) && dy <= (cellY+tol)) {
+      double xmax = (dy<=0.5*cellY) ? cellR : (cellR-(dy-0.5*cellY)/tan30deg);
+      if (dx <= (xmax+tol)) {
+	num = k;
+	break;
+      }
+    }
+  }
+  return num;
+}
+
+std::pair<int,int> HGCalGeometryLookupTester::assignCellHexagon(const HGCalParameters& hp,
+								float x, float y) const {
+  const double scale(0.1);
+  double xx(x), yy(y);
+  const double rmax = scale*hp.waferR_*std::cos(30.0*M_PI/180.0);
+  int wafer = cellHex(xx, yy, rmax, hp.waferPosX_, hp.waferPosY_);
+  xx -= hp.waferPosX_[wafer];
+  yy -= hp.waferPosY_[wafer];
+  int cell(0);
+  if (hp.waferTypeT_[wafer] == 1)
+    cell  = cellHex(xx, yy, 0.5*scale*hp.cellSize_[0], hp.cellFineX_, hp.cellFineY_);
+  else
+    cell  = cellHex(xx, yy, 0.5*scale*hp.cellSize_[1], hp.cellCoarseX_, hp.cellCoarseY_);
+  return std::pair<int,int>(wafer,cell);
+}
+
+// HGCalGeometry::getClosestCell with the linear module search used before
+DetId HGCalGeometryLookupTester::getClosestCell(const HGCalGeometry& geom,
+						const HGCalParameters& hp,
+						const GlobalPoint& r) const {
+  const std::vector<DetId>& ids = geom.getValidGeomDetIds();
+  float phip = r.phi();
+  float zp   = r.z();
+  unsigned int cellIndex = ids.size();
+  float dzmin(9999), dphimin(9999), dphi10(0.175);
+  for (unsigned int k=0; k<ids.size(); ++k) {
+    const CaloCellGeometry* cell = geom.getGeometry(ids[k]);
+    if (cell == 0) continue;
+    float dphi = phip-cell->phiPos();
+    while (dphi >   M_PI) dphi -= 2*M_PI;
+    while (dphi <= -M_PI) dphi += 2*M_PI;
+    if (std::abs(dphi) < dphi10) {
+      float dz = std::abs(zp - cell->getPosition().z());
+      if (dz < (dzmin+0.001)) {
+	dzmin     = dz;
+	if (std::abs(dphi) < (dphimin+0.01)) {
+	  cellIndex = k;
+	  dphimin   = std::abs(dphi);
+	} else {
+	  if (cellIndex >= ids.size()) cellIndex = k;
+	}
+      }
+    }
+  }
+  if (cellIndex >= ids.size()) return DetId();
+
+  HGCalTopology::DecodedDetId id_ = geom.topology().decode(ids[cellIndex]);
+  if (geom.topology().dddConstants().getIndex(id_.iLay,true).first < 0)
+    return DetId();
+  float x = (r.z() > 0) ? r.x() : -r.x();
+  std::pair<int,int> kxy = assignCellHexagon(hp, x, r.y());
+  id_.iCell   = kxy.second;
+  id_.iSec    = kxy.first;
+  id_.iSubSec = (hp.waferTypeT_[kxy.first] == 1) ? 1 : -1;
+  return (id_.iCell >= 0) ? geom.topology().encode(id_) : DetId();
+}
+
+void HGCalGeometryLookupTester::analyze(const edm::Event& ,
+					const edm::EventSetup& iSetup ) {
+
+  edm::ESHandle<HGCalGeometry> geom;
+  iSetup.get<IdealGeometryRecord>().get(name,geom);
+  edm::ESHandle<HGCalParameters> hp;
+  iSetup.get<IdealGeometryRecord>().get(name,hp);
+  if (!geom.isValid() || !hp.isValid()) {
+    std::cout << "Cannot get valid HGCalGeometry Object for " << name
+	      << std::endl;
+    return;
+  }
+  const HGCalDDDConstants& hgdc = geom->topology().dddConstants();
+  if (hgdc.geomMode() == HGCalGeometryMode::Square) {
+    std::cout << name << " is not in hexagon mode: nothing to compare"
+	      << std::endl;
+    return;
+  }
+
+  // extent of the wafers and z of the layers
+  double rmax(0);
+  for (unsigned int k=0; k<hp->waferPosX_.size(); ++k)
+    rmax = std::max(rmax, std::sqrt(hp->waferPosX_[k]*hp->waferPosX_[k] +
+				    hp->waferPosY_[k]*hp->waferPosY_[k]));
+  rmax += 0.1*hp->waferR_;
+  std::vector<float> zs;
+  for (auto const& id : geom->getValidGeomDetIds()) {
+    const CaloCellGeometry* cell = geom->getGeometry(id);
+    if (cell == 0) continue;
+    float z = cell->getPosition().z();
+    bool known(false);
+    for (auto zz : zs) if (std::abs(zz-z) < 0.001) known = true;
+    if (!known) zs.push_back(z);
+  }
+
+  // wafer and cell assignment in the local frame of a layer
+  unsigned int nAssign(0), nAssignBad(0);
+  for (double x = -rmax; x <= rmax; x += stepXY) {
+    for (double y = -rmax; y <= rmax; y += stepXY) {
+      std::pair<int,int> kxy0 = hgdc.assignCellHexagon(x,y);
+      std::pair<int,int> kxy1 = assignCellHexagon(*hp,x,y);
+      ++nAssign;
+      if (kxy0 != kxy1) {
+	if (nAssignBad < 10)
+	  std::cout << "assignCellHexagon(" << x << ", " << y << ") gives "
+		    << kxy0.first << ":" << kxy0.second << ", linear search "
+		    << kxy1.first << ":" << kxy1.second << std::endl;
+	++nAssignBad;
+      }
+    }
+  }
+
+  // closest cell on the layers and between them (off the midpoint, where
+  // both layers are equally close)
+  std::sort(zs.begin(), zs.end());
+  unsigned int nClose(0), nCloseBad(0);
+  for (unsigned int iz=0; iz<zs.size(); ++iz) {
+    for (int half=0; half<2; ++half) {
+      if (half == 1 && iz+1 == zs.size()) continue;
+      float z = (half == 0) ? zs[iz] : zs[iz]+0.4*(zs[iz+1]-zs[iz]);
+      for (double x = -rmax; x <= rmax; x += step) {
+	for (double y = -rmax; y <= rmax; y += step) {
+	  const GlobalPoint r(x,y,z);
+	  DetId id0 = geom->getClosestCell(r);
+	  DetId id1 = getClosestCell(*geom,*hp,r);
+	  ++nClose;
+	  if (id0 != id1) {
+	    if (nCloseBad < 10)
+	      std::cout << "getClosestCell(" << x << ", " << y << ", " << z
+			<< ") gives " << HGCalDetId(id0) << ", linear search "
+			<< HGCalDetId(id1) << std::endl;
+	    ++nCloseBad;
+	  }
+	}
+      }
+    }
+  }
+
+  // batch positions
+  unsigned int nPosBad(0);
+  const std::vector<DetId>& ids = geom->getValidDetIds();
+  std::vector<GlobalPoint> positions;
+  geom->getPositions(ids, positions);
+  for (unsigned int k=0; k<ids.size(); ++k) {
+    if ((positions[k]-geom->getPosition(ids[k])).mag() > 1.e-4) ++nPosBad;
+  }
+
+  // adjacency of the wafers has to be symmetric
+  unsigned int nNbBad(0);
+  std::vector<int> nb, nb2;
+  for (int w=0; w<(int)(hp->waferPosX_.size()); ++w) {
+    nb.clear();
+    hgdc.neighbourWafers(w, nb);
+    for (auto w2 : nb) {
+      nb2.clear();
+      hgdc.neighbourWafers(w2, nb2);
+      if (std::find(nb2.begin(), nb2.end(), w) == nb2.end()) ++nNbBad;
+    }
+  }
+
+  std::cout << name << ": assignCellHexagon " << nAssignBad << " of "
+	    << nAssign << " points differ, getClosestCell " << nCloseBad
+	    << " of " << nClose << ", getPositions " << nPosBad << " of "
+	    << ids.size() << " ids, " << nNbBad << " one-sided wafer neighbours"
+	    << std::endl;
+  if (nAssignBad+nCloseBad+nPosBad+nNbBad > 0)
+    std::cout << "***** ERROR *****\n";
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(HGCalGeometryLookupTester);
@@ -0,0 +1,41 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("PROD")
+process.load("SimGeneral.HepPDTESSource.pdt_cfi")
+process.load("Geometry.HGCalCommonData.testHGCXML_cfi")
+process.load("Geometry.HGCalCommonData.hgcalV6ParametersInitialization_cfi")
+process.load("Geometry.HGCalCommonData.hgcalV6NumberingInitialization_cfi")
+
+process.hgcalEETopology = cms.ESProducer("HGCalTopologyBuilder",
+    Name     = cms.untracked.string("HGCalEESensitive"),
+    Type     = cms.untracked.int32(0),
+    HalfType = cms.untracked.bool(False)
+)
+process.hgcalHEFTopology = process.hgcalEETopology.clone(
+    Name = "HGCalHESiliconSensitive",
+    Type = 1
+)
+process.hgcalEEGeometry = cms.ESProducer("HGCalGeometryESProducer",
+    Name = cms.untracked.string("HGCalEESensitive")
+)
+process.hgcalHEFGeometry = process.hgcalEEGeometry.clone(
+    Name = "HGCalHESiliconSensitive"
+)
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+)
+
+process.prodEE = cms.EDAnalyzer("HGCalGeometryLookupTester",
+                                Detector = cms.string("HGCalEESensitive"),
+                                Step     = cms.double(2.0),
+                                StepXY   = cms.double(0.25)
+)
+
+process.prodHEF = process.prodEE.clone(
+    Detector = "HGCalHESiliconSensitive"
+)
+
+process.p1 = cms.Path(process.prodEE*process.prodHEF)
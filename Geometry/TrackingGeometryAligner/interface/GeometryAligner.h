@@ -3,8 +3,12 @@
 
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
@@ -72,55 +76,106 @@ void GeometryAligner::applyAlignments( C* geometry,
 	  << "Size mismatch between geometry (size=" << geometry->theMap.size() 
 	  << ") and alignment errors (size=" << alignmentErrors->m_alignError.size() << ")";
 
+  // Dets ordered by DetId in a contiguous array, like the alignments
+  typedef std::pair<unsigned int, GeomDet const*> IdAndDet;
+  std::vector<IdAndDet> dets(geometry->theMap.begin(), geometry->theMap.end());
+  std::sort(dets.begin(), dets.end(),
+	    [](const IdAndDet& a, const IdAndDet& b) { return a.first < b.first; });
+  const size_t nDets = dets.size();
+
+  // Check all DetIds before touching the geometry
+  for ( size_t i = 0; i < nDets; ++i ) {
+    if ( dets[i].first != alignments->m_align[i].rawId() )
+      throw cms::Exception("GeometryMismatch") 
+	<< "DetId mismatch between geometry (rawId=" << dets[i].first
+	<< ") and alignments (rawId=" << alignments->m_align[i].rawId();
+    if ( dets[i].first != alignmentErrors->m_alignError[i].rawId() )
+      throw cms::Exception("GeometryMismatch") 
+	<< "DetId mismatch between geometry (rawId=" << dets[i].first
+	<< ") and alignment errors (rawId=" << alignmentErrors->m_alignError[i].rawId();
+  }
+
+  // Positions and rotations of all dets as structure of arrays: the
+  // (Euler angle) decoding is done in parallel, the global correction
+  // in plain loops over contiguous arrays
+  std::vector<double> pos[3];
+  std::vector<double> rot[9];
+  for ( auto& v : pos ) v.resize(nDets);
+  for ( auto& v : rot ) v.resize(nDets);
+
+  tbb::parallel_for( tbb::blocked_range<size_t>(0, nDets),
+		     [&]( const tbb::blocked_range<size_t>& range ) {
+    for ( size_t i = range.begin(); i != range.end(); ++i ) {
+      const AlignTransform& align = alignments->m_align[i];
+      const AlignTransform::Translation& t = align.translation();
+      const AlignTransform::Rotation r = align.rotation();
+      pos[0][i] = t.x(); pos[1][i] = t.y(); pos[2][i] = t.z();
+      rot[0][i] = r.xx(); rot[1][i] = r.xy(); rot[2][i] = r.xz();
+      rot[3][i] = r.yx(); rot[4][i] = r.yy(); rot[5][i] = r.yz();
+      rot[6][i] = r.zx(); rot[7][i] = r.zy(); rot[8][i] = r.zz();
+    }
+  });
+
+  // Apply global correction: position = G * t + shift, rotation = R * G^-1
   const AlignTransform::Translation &globalShift = globalCoordinates.translation();
   const AlignTransform::Rotation globalRotation = globalCoordinates.rotation(); // by value!
   const AlignTransform::Rotation inverseGlobalRotation = globalRotation.inverse();
+  const double g[9] = { globalRotation.xx(), globalRotation.xy(), globalRotation.xz(),
+			globalRotation.yx(), globalRotation.yy(), globalRotation.yz(),
+			globalRotation.zx(), globalRotation.zy(), globalRotation.zz() };
+  const double gi[9] = { inverseGlobalRotation.xx(), inverseGlobalRotation.xy(), inverseGlobalRotation.xz(),
+			 inverseGlobalRotation.yx(), inverseGlobalRotation.yy(), inverseGlobalRotation.yz(),
+			 inverseGlobalRotation.zx(), inverseGlobalRotation.zy(), inverseGlobalRotation.zz() };
+  const double shift[3] = { globalShift.x(), globalShift.y(), globalShift.z() };
+
+  std::vector<double> newPos[3];
+  for ( unsigned int k = 0; k < 3; ++k ) {
+    newPos[k].resize(nDets);
+    double* out = newPos[k].data();
+    const double* x = pos[0].data();
+    const double* y = pos[1].data();
+    const double* z = pos[2].data();
+    for ( size_t i = 0; i < nDets; ++i )
+      out[i] = g[3*k]*x[i] + g[3*k+1]*y[i] + g[3*k+2]*z[i] + shift[k];
+  }
+  std::vector<double> newRot[9];
+  for ( unsigned int k = 0; k < 9; ++k ) {
+    const unsigned int row = k/3, col = k%3;
+    newRot[k].resize(nDets);
+    double* out = newRot[k].data();
+    const double* r0 = rot[3*row].data();
+    const double* r1 = rot[3*row+1].data();
+    const double* r2 = rot[3*row+2].data();
+    for ( size_t i = 0; i < nDets; ++i )
+      out[i] = r0[i]*gi[col] + r1[i]*gi[3+col] + r2[i]*gi[6+col];
+  }
 
-  // Parallel loop on alignments, alignment errors and geomdets
-  std::vector<AlignTransform>::const_iterator iAlign = alignments->m_align.begin();
-  std::vector<AlignTransformErrorExtended>::const_iterator 
-	iAlignError = alignmentErrors->m_alignError.begin();
-  //copy  geometry->theMap to a real map to order it....
-  std::map<unsigned int, GeomDet const *> theMap;
-  std::copy(geometry->theMap.begin(), geometry->theMap.end(), std::inserter(theMap,theMap.begin()));
-  unsigned int nAPE = 0;
-  for ( auto iPair = theMap.begin(); 
-	iPair != theMap.end(); ++iPair, ++iAlign, ++iAlignError )
-	{
-	  // Check DetIds
-	  if ( (*iPair).first != (*iAlign).rawId() )
-	    throw cms::Exception("GeometryMismatch") 
-	      << "DetId mismatch between geometry (rawId=" << (*iPair).first
-	      << ") and alignments (rawId=" << (*iAlign).rawId();
-	  
-	  if ( (*iPair).first != (*iAlignError).rawId() )
-	    throw cms::Exception("GeometryMismatch") 
-	      << "DetId mismatch between geometry (rawId=" << (*iPair).first
-	      << ") and alignment errors (rawId=" << (*iAlignError).rawId();
-
-	  // Apply global correction
-	  CLHEP::Hep3Vector positionHep = globalRotation * CLHEP::Hep3Vector( (*iAlign).translation() ) + globalShift;
-	  CLHEP::HepRotation rotationHep = CLHEP::HepRotation( (*iAlign).rotation() )  * inverseGlobalRotation;
-
-	  // Define new position/rotation objects and apply
-	  Surface::PositionType position( positionHep.x(), positionHep.y(), positionHep.z() );
-	  Surface::RotationType rotation( rotationHep.xx(), rotationHep.xy(), rotationHep.xz(), 
-					  rotationHep.yx(), rotationHep.yy(), rotationHep.yz(), 
-					  rotationHep.zx(), rotationHep.zy(), rotationHep.zz() );
-	  GeomDet* iGeomDet = const_cast<GeomDet*>((*iPair).second);
-	  this->setGeomDetPosition( *iGeomDet, position, rotation );
-
-	  // Alignment Position Error only if non-zero to save memory
-	  GlobalErrorExtended error( asSMatrix<6>((*iAlignError).matrix()) );
-
-	  AlignmentPositionError ape( error );
-	  if (this->setAlignmentPositionError( *iGeomDet, ape ))
-	    ++nAPE;
-	  
-	}
+  // Define new position/rotation objects and apply; setGeomDetPosition and
+  // setAlignmentPositionError do not touch components, so dets are independent
+  std::atomic<unsigned int> nAPE(0);
+  tbb::parallel_for( tbb::blocked_range<size_t>(0, nDets),
+		     [&]( const tbb::blocked_range<size_t>& range ) {
+    unsigned int nLocalAPE = 0;
+    for ( size_t i = range.begin(); i != range.end(); ++i ) {
+      Surface::PositionType position( newPos[0][i], newPos[1][i], newPos[2][i] );
+      Surface::RotationType rotation( newRot[0][i], newRot[1][i], newRot[2][i],
+				      newRot[3][i], newRot[4][i], newRot[5][i],
+				      newRot[6][i], newRot[7][i], newRot[8][i] );
+      GeomDet* iGeomDet = const_cast<GeomDet*>(dets[i].second);
+      this->setGeomDetPosition( *iGeomDet, position, rotation );
+
+      // Alignment Position Error only if non-zero to save memory
+      GlobalErrorExtended error( asSMatrix<6>(alignmentErrors->m_alignError[i].matrix()) );
+
+      AlignmentPositionError ape( error );
+      if (this->setAlignmentPositionError( *iGeomDet, ape ))
+	++nLocalAPE;
+    }
+    nAPE += nLocalAPE;
+  });
 
   edm::LogInfo("Alignment") << "@SUB=GeometryAligner::applyAlignments" 
-			    << "Finished to apply " << theMap.size() << " alignments with "
+			    << "Finished to apply " << nDets << " alignments with "
 			    << nAPE << " non-zero APE.";
 }
 
@@ -28,8 +28,11 @@ protected:
 private:
     XMLIdealGeometryESSource(const XMLIdealGeometryESSource &);
     const XMLIdealGeometryESSource & operator=(const XMLIdealGeometryESSource &);
+    /// name of the DDStreamer file for the current XML input, empty if caching is off
+    std::string cacheFileName() const;
     std::string rootNodeName_;
     bool userNS_;
+    std::string cacheDirectory_;
     GeometryConfiguration geoConfig_;
 
 };
@@ -4,6 +4,7 @@
 #include "DetectorDescription/Parser/interface/DDLParser.h"
 #include "DetectorDescription/Core/interface/DDCompactView.h"
 #include "DetectorDescription/Core/interface/DDRoot.h"
+#include "DetectorDescription/Core/interface/DDStreamer.h"
 
 #include "DetectorDescription/Core/interface/DDMaterial.h"
 #include "DetectorDescription/Core/interface/DDSolid.h"
@@ -16,12 +17,22 @@
 #include "DetectorDescription/Core/src/Specific.h"
 
 #include "FWCore/ParameterSet/interface/FileInPath.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/Digest.h"
+#include "FWCore/Version/interface/GetReleaseVersion.h"
 
+#include <cstdio>
+#include <exception>
+#include <fstream>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <unistd.h>
 
 
 XMLIdealGeometryESSource::XMLIdealGeometryESSource(const edm::ParameterSet & p): rootNodeName_(p.getParameter<std::string>("rootNodeName")),
                                                                                  userNS_(p.getUntrackedParameter<bool>("userControlledNamespace", false)),
+                                                                                 cacheDirectory_(p.getUntrackedParameter<std::string>("cacheDirectory", "")),
                                                                                  geoConfig_(p)
 {
   if ( rootNodeName_ == "" || rootNodeName_ == "\\" ) {
@@ -54,17 +65,98 @@ XMLIdealGeometryESSource::produceMagField(const IdealMagneticFieldRecord &)
 }
 
 
+std::string
+XMLIdealGeometryESSource::cacheFileName() const
+{
+  if ( cacheDirectory_.empty() ) return std::string();
+
+  // the key covers everything the parser result depends on: the release
+  // and streamer format, the root, the namespace handling and name and
+  // content of every XML file; the cache is only written when nothing
+  // else was in the DD stores before
+  cms::Digest digest(edm::getReleaseVersion());
+  digest.append(std::to_string(DDStreamer::formatVersion));
+  digest.append(rootNodeName_);
+  digest.append(userNS_ ? "1" : "0");
+  for ( const auto& fname : geoConfig_.getFileList() ) {
+    std::ifstream in(fname.c_str(), std::ios::binary);
+    if ( !in ) return std::string();
+    std::ostringstream content;
+    content << in.rdbuf();
+    digest.append(fname);
+    digest.append(content.str());
+  }
+  return cacheDirectory_ + "/DDCompactView_" + digest.digest().toString() + ".ddstream";
+}
+
 std::unique_ptr<DDCompactView>
 XMLIdealGeometryESSource::produce() {
   
+  // DDStreamer dumps the global DD stores, so a cache written after another
+  // source filled them would hold more than what the key covers
+  const bool storesEmpty(DDStreamer::storesEmpty());
+
   DDName ddName(rootNodeName_);
   DDLogicalPart rootNode(ddName);
   DDRootDef::instance().set(rootNode);
   std::unique_ptr<DDCompactView> returnValue(new DDCompactView(rootNode));
-  DDLParser parser(*returnValue); //* parser = DDLParser::instance();
-  parser.getDDLSAX2FileHandler()->setUserNS(userNS_);
-  int result2 = parser.parse(geoConfig_);
-  if (result2 != 0) throw cms::Exception("DDException") << "DDD-Parser: parsing failed!";
+
+  const std::string cacheFile(cacheFileName());
+  std::ifstream cached;
+  if ( !cacheFile.empty() ) cached.open(cacheFile.c_str(), std::ios::binary);
+
+  bool parse = !cached;
+  bool cacheReadFailed = false;
+  if ( cached ) {
+    // a previous job already parsed exactly this XML input
+    edm::LogInfo("XMLIdealGeometryESSource") << "Reading geometry from cache " << cacheFile;
+    try {
+      DDStreamer streamer(cached);
+      streamer.setCompactView(*returnValue);
+      streamer.read();
+    } catch ( const std::exception& e ) {
+      // e.g. a truncated or corrupted file: drop it and parse the XML
+      edm::LogWarning("XMLIdealGeometryESSource") << "Could not read geometry cache " << cacheFile
+                                                  << ", removing it and parsing the XML files instead: " << e.what();
+      cached.close();
+      std::remove(cacheFile.c_str());
+      // the parser redefines what the read already put in the DD stores,
+      // but the positions go to a new view
+      returnValue.reset(new DDCompactView(rootNode));
+      parse = true;
+      cacheReadFailed = true;
+    }
+  }
+  if ( parse ) {
+    DDLParser parser(*returnValue); //* parser = DDLParser::instance();
+    parser.getDDLSAX2FileHandler()->setUserNS(userNS_);
+    int result2 = parser.parse(geoConfig_);
+    if (result2 != 0) throw cms::Exception("DDException") << "DDD-Parser: parsing failed!";
+
+    if ( cacheReadFailed ) {
+      edm::LogInfo("XMLIdealGeometryESSource") << "Not writing geometry cache " << cacheFile
+                                               << ": the DD stores hold what was read from the bad cache";
+    } else if ( !cacheFile.empty() && !storesEmpty ) {
+      edm::LogInfo("XMLIdealGeometryESSource") << "Not writing geometry cache " << cacheFile
+                                               << ": the DD stores were already filled by another source";
+    } else if ( !cacheFile.empty() && rootNode.isValid() ) {
+      // write under a private name and rename so that concurrent jobs
+      // never see a partially written cache
+      std::ostringstream tmpName;
+      tmpName << cacheFile << ".tmp" << ::getpid();
+      std::ofstream out(tmpName.str().c_str(), std::ios::binary);
+      if ( out ) {
+        DDStreamer streamer(out);
+        streamer.setCompactView(*returnValue);
+        streamer.write();
+        out.close();
+      }
+      if ( !out || 0 != std::rename(tmpName.str().c_str(), cacheFile.c_str()) ) {
+        std::remove(tmpName.str().c_str());
+        edm::LogWarning("XMLIdealGeometryESSource") << "Could not write geometry cache " << cacheFile;
+      }
+    }
+  }
 
   // after parsing the root node should be valid!
 
@@ -0,0 +1,75 @@
+#ifndef HLTrigger_HLTfilters_TriggerExpressionBitMask_h
+#define HLTrigger_HLTfilters_TriggerExpressionBitMask_h
+
+#include <vector>
+#include <utility>
+#include <stdint.h>
+
+namespace edm {
+  class HLTGlobalStatus;
+}
+
+namespace triggerExpression {
+
+// trigger decisions packed 64 per word: bit (i % 64) of word (i / 64) is the decision of path (or L1 bit) i
+typedef std::vector<uint64_t> BitWords;
+
+// pack the accept decisions of the HLT paths
+void packAccept(const edm::HLTGlobalStatus & results, BitWords & words);
+
+// pack an L1 decision word
+void packBits(const std::vector<bool> & bits, BitWords & words);
+
+// the set of paths (or L1 bits) matched by a pattern, resolved once per menu;
+// only the non-empty words are stored, so a pattern matching a few paths
+// spread over a large menu is tested with a handful of word-wide ANDs
+class BitMask {
+public:
+  BitMask() :
+    m_words()
+  { }
+
+  void clear() {
+    m_words.clear();
+  }
+
+  bool empty() const {
+    return m_words.empty();
+  }
+
+  // add a bit; bits are expected in increasing order, but any order works
+  void set(unsigned int bit) {
+    unsigned int index = bit / 64;
+    uint64_t     mask  = uint64_t(1) << (bit % 64);
+    if (m_words.empty() or m_words.back().first < index) {
+      m_words.push_back( std::make_pair(index, mask) );
+      return;
+    }
+    for (auto & word: m_words)
+      if (word.first == index) {
+        word.second |= mask;
+        return;
+      }
+    m_words.push_back( std::make_pair(index, mask) );
+    for (unsigned int i = m_words.size() - 1; i > 0 and m_words[i-1].first > m_words[i].first; --i)
+      std::swap(m_words[i-1], m_words[i]);
+  }
+
+  // is any of the bits set in the packed decisions ?
+  bool any(const BitWords & words) const {
+    for (auto const & word: m_words) {
+      if (word.first >= words.size())
+        return false;
+      if (words[word.first] & word.second)
+        return true;
+    }
+    return false;
+  }
+
+private:
+  std::vector<std::pair<unsigned int, uint64_t> > m_words;
+};
+
+} // namespace triggerExpression
+
+#endif // HLTrigger_HLTfilters_TriggerExpressionBitMask_h
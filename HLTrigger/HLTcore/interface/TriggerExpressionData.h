@@ -8,6 +8,7 @@
 #include "DataFormats/Provenance/interface/EventID.h"
 #include "DataFormats/Common/interface/TriggerResults.h"
 #include "DataFormats/L1GlobalTrigger/interface/L1GlobalTriggerReadoutRecord.h"
+#include "HLTrigger/HLTcore/interface/TriggerExpressionBitMask.h"
 
 namespace edm {
   class Event;
@@ -40,11 +41,15 @@ public:
     m_l1tTechMask(0),
     m_l1tCacheID(),
     m_l1tUpdated(false),
+    m_l1tAlgoWords(),
+    m_l1tAlgoWordsValid(false),
     // hlt values and status
     m_hltResults(0),
     m_hltMenu(0),
     m_hltCacheID(),
     m_hltUpdated(false),
+    m_hltAcceptWords(),
+    m_hltAcceptWordsValid(false),
     // event values
     m_eventNumber()
   { }
@@ -67,11 +72,15 @@ public:
     m_l1tTechMask(0),
     m_l1tCacheID(),
     m_l1tUpdated(false),
+    m_l1tAlgoWords(),
+    m_l1tAlgoWordsValid(false),
     // hlt values and status
     m_hltResults(0),
     m_hltMenu(0),
     m_hltCacheID(),
     m_hltUpdated(false),
+    m_hltAcceptWords(),
+    m_hltAcceptWordsValid(false),
     // event values
     m_eventNumber()
       {
@@ -104,11 +113,15 @@ public:
     m_l1tTechMask(0),
     m_l1tCacheID(),
     m_l1tUpdated(false),
+    m_l1tAlgoWords(),
+    m_l1tAlgoWordsValid(false),
     // hlt values and status
     m_hltResults(0),
     m_hltMenu(0),
     m_hltCacheID(),
     m_hltUpdated(false),
+    m_hltAcceptWords(),
+    m_hltAcceptWordsValid(false),
     // event values
     m_eventNumber()
       {
@@ -167,6 +180,25 @@ public:
     return * m_l1tResults;
   }
 
+  // the HLT accept decisions and the L1 algorithm decision word, packed
+  // 64 bits per word; computed on first use in each event, and shared by
+  // all the expressions evaluated on this Data
+  const BitWords & hltAcceptWords() const {
+    if (not m_hltAcceptWordsValid) {
+      packAccept(* m_hltResults, m_hltAcceptWords);
+      m_hltAcceptWordsValid = true;
+    }
+    return m_hltAcceptWords;
+  }
+
+  const BitWords & l1tAlgoWords() const {
+    if (not m_l1tAlgoWordsValid) {
+      packBits(m_l1tResults->decisionWord(), m_l1tAlgoWords);
+      m_l1tAlgoWordsValid = true;
+    }
+    return m_l1tAlgoWords;
+  }
+
   const L1GtTriggerMenu & l1tMenu() const {
     return * m_l1tMenu;
   }
@@ -229,12 +261,16 @@ private:
   const L1GtTriggerMask               * m_l1tTechMask;
   unsigned long long                    m_l1tCacheID;
   bool                                  m_l1tUpdated;
+  mutable BitWords                      m_l1tAlgoWords;
+  mutable bool                          m_l1tAlgoWordsValid;
 
   // hlt values and status
   const edm::TriggerResults           * m_hltResults;
   const edm::TriggerNames             * m_hltMenu;
   edm::ParameterSetID                   m_hltCacheID;
   bool                                  m_hltUpdated;
+  mutable BitWords                      m_hltAcceptWords;
+  mutable bool                          m_hltAcceptWordsValid;
 
   // event values
   edm::EventNumber_t                    m_eventNumber;
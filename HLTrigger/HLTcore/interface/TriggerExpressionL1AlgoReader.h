@@ -5,6 +5,7 @@
 #include <string>
 
 #include "HLTrigger/HLTcore/interface/TriggerExpressionEvaluator.h"
+#include "HLTrigger/HLTcore/interface/TriggerExpressionBitMask.h"
 
 namespace triggerExpression {
 
@@ -12,7 +13,8 @@ class L1AlgoReader : public Evaluator {
 public:
   L1AlgoReader(const std::string & pattern) :
     m_pattern(pattern),
-    m_triggers()
+    m_triggers(),
+    m_mask()
   { }
 
   bool operator()(const Data & data) const;
@@ -24,6 +26,7 @@ public:
 private:
   std::string m_pattern;
   std::vector<std::pair<std::string, unsigned int> > m_triggers;
+  BitMask m_mask;      // the same triggers, for patterns matching more than one
 };
 
 } // namespace triggerExpression
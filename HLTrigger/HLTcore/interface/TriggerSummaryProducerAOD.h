@@ -152,16 +152,20 @@ class TriggerSummaryProducerAOD : public edm::stream::EDProducer<edm::GlobalCach
   /// trigger object collection
   trigger::TriggerObjectCollection toc_;
   std::vector<std::string> tags_;
-  /// global map for indices into toc_: offset per input L3 collection
-  std::map<edm::ProductID,unsigned int> offset_;
+  /// global index into toc_: offset per input L3 collection, sorted by
+  /// ProductID once all collections are packed, so that the filter refs
+  /// are resolved by binary search (and mostly by the last hit)
+  typedef std::vector<std::pair<edm::ProductID,unsigned int> > Offsets;
+  Offsets offset_;
+  Offsets::const_iterator findOffset(const edm::ProductID&) const;
 
   /// keys
   trigger::Keys keys_;
   /// ids
   trigger::Vids ids_;
 
-  /// packing decision
-  std::vector<bool> maskFilters_;
+  /// packing decision: index into the filter objects and tag of each L3 filter
+  std::vector<std::pair<unsigned int,edm::InputTag> > packedFilters_;
 
   edm::GetterOfProducts<trigger::TriggerFilterObjectWithRefs> getTriggerFilterObjectWithRefs_;
   edm::GetterOfProducts<reco::RecoEcalCandidateCollection> getRecoEcalCandidateCollection_;
@@ -66,7 +66,7 @@ TriggerSummaryProducerAOD::TriggerSummaryProducerAOD(const edm::ParameterSet& ps
   offset_(),
   keys_(),
   ids_(),
-  maskFilters_()
+  packedFilters_()
 {
   if (pn_=="@") {
     edm::Service<edm::service::TriggerNamesService> tns;
@@ -204,22 +204,18 @@ TriggerSummaryProducerAOD::produce(edm::Event& iEvent, const edm::EventSetup& iS
    /// so, these are L3 collections to be packed up, and the
    /// corresponding filter is a L3 filter also to be packed up.
    /// Record the InputTags of those L3 filters and L3 collections.
-   maskFilters_.clear();
-   maskFilters_.resize(nfob);
+   packedFilters_.clear();
    filterTagsEvent_.clear();
    collectionTagsEvent_.clear();
    unsigned int nf(0);
    for (unsigned int ifob=0; ifob!=nfob; ++ifob) {
-     maskFilters_[ifob]=false;
      const vector<string>& collectionTags_(fobs[ifob]->getCollectionTagsAsStrings());
      const unsigned int ncol(collectionTags_.size());
      if (ncol>0) {
        nf++;
-       maskFilters_[ifob]=true;
-       const string& label    (fobs[ifob].provenance()->moduleLabel());
-       const string& instance (fobs[ifob].provenance()->productInstanceName());
-       const string& process  (fobs[ifob].provenance()->processName());
-       filterTagsEvent_.insert(InputTag(label,instance,process));
+       const Provenance& provenance(*(fobs[ifob].provenance()));
+       packedFilters_.push_back(make_pair(ifob,InputTag(provenance.moduleLabel(),provenance.productInstanceName(),provenance.processName())));
+       filterTagsEvent_.insert(packedFilters_.back().second);
        for (unsigned int icol=0; icol!=ncol; ++icol) {
 	 // overwrite process name (usually not set)
 	 tokenizeTag(collectionTags_[icol],tagLabel,tagInstance,tagProcess);
@@ -292,6 +288,17 @@ TriggerSummaryProducerAOD::produce(edm::Event& iEvent, const edm::EventSetup& iS
    fillTriggerObjectCollections<                      PFTauCollection>(iEvent, getPFTauCollection_);
    fillTriggerObjectCollections<                      PFMETCollection>(iEvent, getPFMETCollection_);
    ///
+   /// sort the offsets once, so the filter refs below are resolved by
+   /// binary search rather than by a map lookup per ref; the sort is
+   /// stable so that for a duplicate pid the last entry is the one
+   /// written last, which is the one used (as with the map before)
+   stable_sort(offset_.begin(),offset_.end(),
+	       [](const Offsets::value_type& l, const Offsets::value_type& r){ return l.first<r.first; });
+   if (adjacent_find(offset_.begin(),offset_.end(),
+		     [](const Offsets::value_type& l, const Offsets::value_type& r){ return l.first==r.first; })!=offset_.end()) {
+     LogError("TriggerSummaryProducerAOD") << "Duplicate pid!";
+   }
+   ///
    const unsigned int nk(tags_.size());
    LogDebug("TriggerSummaryProducerAOD") << "Number of collections found: " << nk;
    const unsigned int no(toc_.size());
@@ -305,38 +312,34 @@ TriggerSummaryProducerAOD::produce(edm::Event& iEvent, const edm::EventSetup& iS
    product->addCollections(tags_,keys_);
    product->addObjects(toc_);
 
-   /// fill the L3 filter objects
-   for (unsigned int ifob=0; ifob!=nfob; ++ifob) {
-     if (maskFilters_[ifob]) {
-       const string& label    (fobs[ifob].provenance()->moduleLabel());
-       const string& instance (fobs[ifob].provenance()->productInstanceName());
-       const string& process  (fobs[ifob].provenance()->processName());
-       const edm::InputTag filterTag(label,instance,process);
-       ids_.clear();
-       keys_.clear();
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->photonIds()   ,fobs[ifob]->photonRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->electronIds() ,fobs[ifob]->electronRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->muonIds()     ,fobs[ifob]->muonRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->jetIds()      ,fobs[ifob]->jetRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->compositeIds(),fobs[ifob]->compositeRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->basemetIds()  ,fobs[ifob]->basemetRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->calometIds()  ,fobs[ifob]->calometRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->pixtrackIds() ,fobs[ifob]->pixtrackRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1emIds()     ,fobs[ifob]->l1emRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1muonIds()   ,fobs[ifob]->l1muonRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1jetIds()    ,fobs[ifob]->l1jetRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1etmissIds() ,fobs[ifob]->l1etmissRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1hfringsIds(),fobs[ifob]->l1hfringsRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1tmuonIds()  ,fobs[ifob]->l1tmuonRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1tegammaIds(),fobs[ifob]->l1tegammaRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1tjetIds()   ,fobs[ifob]->l1tjetRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1ttauIds()   ,fobs[ifob]->l1ttauRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->l1tetsumIds() ,fobs[ifob]->l1tetsumRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->pfjetIds()    ,fobs[ifob]->pfjetRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->pftauIds()    ,fobs[ifob]->pftauRefs());
-       fillFilterObjectMembers(iEvent,filterTag,fobs[ifob]->pfmetIds()    ,fobs[ifob]->pfmetRefs());
-       product->addFilter(filterTag,ids_,keys_);
-     }
+   /// fill the L3 filter objects, in one pass over the packed filters
+   for (unsigned int ipf=0; ipf!=packedFilters_.size(); ++ipf) {
+     const TriggerFilterObjectWithRefs& fob(*fobs[packedFilters_[ipf].first]);
+     const edm::InputTag& filterTag(packedFilters_[ipf].second);
+     ids_.clear();
+     keys_.clear();
+     fillFilterObjectMembers(iEvent,filterTag,fob.photonIds(),   fob.photonRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.electronIds(), fob.electronRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.muonIds(),     fob.muonRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.jetIds(),      fob.jetRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.compositeIds(),fob.compositeRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.basemetIds(),  fob.basemetRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.calometIds(),  fob.calometRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.pixtrackIds(), fob.pixtrackRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1emIds(),     fob.l1emRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1muonIds(),   fob.l1muonRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1jetIds(),    fob.l1jetRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1etmissIds(), fob.l1etmissRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1hfringsIds(),fob.l1hfringsRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1tmuonIds(),  fob.l1tmuonRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1tegammaIds(),fob.l1tegammaRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1tjetIds(),   fob.l1tjetRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1ttauIds(),   fob.l1ttauRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.l1tetsumIds(), fob.l1tetsumRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.pfjetIds(),    fob.pfjetRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.pftauIds(),    fob.pftauRefs());
+     fillFilterObjectMembers(iEvent,filterTag,fob.pfmetIds(),    fob.pfmetRefs());
+     product->addFilter(filterTag,ids_,keys_);
    }
 
    OrphanHandle<TriggerEvent> ref = iEvent.put(std::move(product));
@@ -372,10 +375,7 @@ void TriggerSummaryProducerAOD::fillTriggerObjectCollections(const edm::Event& i
 
     if (collectionTagsEvent_.find(collectionTag)!=collectionTagsEvent_.end()) {
       const ProductID pid(collections[ic].provenance()->productID());
-      if (offset_.find(pid)!=offset_.end()) {
-	LogError("TriggerSummaryProducerAOD") << "Duplicate pid!";
-      }
-      offset_[pid]=toc_.size();
+      offset_.push_back(make_pair(pid,toc_.size()));
       const unsigned int n(collections[ic]->size());
       for (unsigned int i=0; i!=n; ++i) {
 	fillTriggerObject( (*collections[ic])[i] );
@@ -489,9 +489,14 @@ void TriggerSummaryProducerAOD::fillFilterObjectMembers(const edm::Event& iEvent
 					  << ids.size() << " " << refs.size();
   }
 
+  /// consecutive refs almost always point into the same collection
+  Offsets::const_iterator offset(offset_.end());
   const unsigned int n(min(ids.size(),refs.size()));
   for (unsigned int i=0; i!=n; ++i) {
     const ProductID pid(refs[i].id());
+    if ((offset==offset_.end()) || (offset->first!=pid)) {
+      offset=findOffset(pid);
+    }
     if (!(pid.isValid())) {
       LogError("TriggerSummaryProducerAOD")
 	<< "Iinvalid pid: " << pid
@@ -501,7 +506,7 @@ void TriggerSummaryProducerAOD::fillFilterObjectMembers(const edm::Event& iEvent
 	<< " <Unrecoverable>"
 	<< " / " << refs[i].key()
 	<< " CollectionType: " << typeid(C).name();
-    } else if (offset_.find(pid)==offset_.end()) {
+    } else if (offset==offset_.end()) {
       const string&    label(iEvent.getProvenance(pid).moduleLabel());
       const string& instance(iEvent.getProvenance(pid).productInstanceName());
       const string&  process(iEvent.getProvenance(pid).processName());
@@ -514,13 +519,21 @@ void TriggerSummaryProducerAOD::fillFilterObjectMembers(const edm::Event& iEvent
 	<< " / " << refs[i].key()
 	<< " CollectionType: " << typeid(C).name();
     } else {
-      fillFilterObjectMember(offset_[pid],ids[i],refs[i]);
+      fillFilterObjectMember(offset->second,ids[i],refs[i]);
     }
   }
   return;
 
 }
 
+TriggerSummaryProducerAOD::Offsets::const_iterator TriggerSummaryProducerAOD::findOffset(const edm::ProductID& pid) const {
+
+  // last entry for pid: the one written last if there are duplicates
+  const Offsets::const_iterator i(std::upper_bound(offset_.begin(),offset_.end(),pid,
+      [](const edm::ProductID& l, const Offsets::value_type& r){ return l<r.first; }));
+  return ((i!=offset_.begin()) && ((i-1)->first==pid)) ? i-1 : offset_.end();
+}
+
 template <typename C>
 void TriggerSummaryProducerAOD::fillFilterObjectMember(const int& offset, const int& id, const edm::Ref<C> & ref) {
 
@@ -0,0 +1,22 @@
+#include "DataFormats/Common/interface/HLTGlobalStatus.h"
+#include "HLTrigger/HLTcore/interface/TriggerExpressionBitMask.h"
+
+namespace triggerExpression {
+
+void packAccept(const edm::HLTGlobalStatus & results, BitWords & words) {
+  const unsigned int size = results.size();
+  words.assign((size + 63) / 64, 0);
+  for (unsigned int i = 0; i < size; ++i)
+    if (results.accept(i))
+      words[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+void packBits(const std::vector<bool> & bits, BitWords & words) {
+  const unsigned int size = bits.size();
+  words.assign((size + 63) / 64, 0);
+  for (unsigned int i = 0; i < size; ++i)
+    if (bits[i])
+      words[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+} // namespace triggerExpression
@@ -45,6 +45,10 @@ bool Data::setEvent(const edm::Event & event, const edm::EventSetup & setup) {
   // cache the event number
   m_eventNumber = event.id().event();
 
+  // the packed decisions are recomputed on demand for the new event
+  m_l1tAlgoWordsValid   = false;
+  m_hltAcceptWordsValid = false;
+
   // access L1 objects only if L1 is used
   if (hasL1T()) {
     // cache the L1 GT results objects
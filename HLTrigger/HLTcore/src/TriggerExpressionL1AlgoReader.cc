@@ -18,16 +18,14 @@ bool L1AlgoReader::operator()(const Data & data) const {
   if (not data.hasL1T())
     return false;
 
-  const std::vector<bool> & word = data.l1tResults().decisionWord();
-  if (word.empty())
-    return false;
-
-  typedef std::pair<std::string, unsigned int> value_type;
-  BOOST_FOREACH(const value_type & trigger, m_triggers)
-    if (trigger.second < word.size() and word[trigger.second])
-      return true;
+  if (m_triggers.size() == 1) {
+    const std::vector<bool> & word = data.l1tResults().decisionWord();
+    unsigned int bit = m_triggers[0].second;
+    return bit < word.size() and word[bit];
+  }
 
-  return false;
+  // test all the matching bits at once, a word at a time
+  return m_mask.any(data.l1tAlgoWords());
 }
 
 void L1AlgoReader::dump(std::ostream & out) const {
@@ -52,6 +50,7 @@ void L1AlgoReader::init(const Data & data) {
 
   // clear the previous configuration
   m_triggers.clear();
+  m_mask.clear();
 
   // check if the pattern has is a glob expression, or a single trigger name
   if (not edm::is_glob(m_pattern)) {
@@ -75,8 +74,10 @@ void L1AlgoReader::init(const Data & data) {
     BOOST_FOREACH(const AlgorithmMap::value_type & entry, triggerMap)
       if (boost::regex_match(entry.first, re)) {
         match = true;
-        if (data.ignoreL1Mask() or (mask.gtTriggerMask()[entry.second.algoBitNumber()] & data.daqPartitions()) != data.daqPartitions()) // unmasked in one or more partitions
+        if (data.ignoreL1Mask() or (mask.gtTriggerMask()[entry.second.algoBitNumber()] & data.daqPartitions()) != data.daqPartitions()) { // unmasked in one or more partitions
           m_triggers.push_back( std::make_pair(entry.first, entry.second.algoBitNumber()) );
+          m_mask.set(entry.second.algoBitNumber());
+        }
       }
 
     if (not match) {
@@ -16,12 +16,11 @@ bool PathReader::operator()(const Data & data) const {
   if (not data.hasHLT())
     return false;
 
-  typedef std::pair<std::string, unsigned int> value_type;
-  BOOST_FOREACH(const value_type & trigger, m_triggers)
-    if (data.hltResults().accept(trigger.second))
-      return true;
+  if (m_triggers.size() == 1)
+    return data.hltResults().accept(m_triggers[0].second);
 
-  return false;
+  // test all the matching paths at once, a word at a time
+  return m_mask.any(data.hltAcceptWords());
 }
 
 void PathReader::dump(std::ostream & out) const {
@@ -41,6 +40,7 @@ void PathReader::dump(std::ostream & out) const {
 void PathReader::init(const Data & data) {
   // clear the previous configuration
   m_triggers.clear();
+  m_mask.clear();
 
   // check if the pattern has is a glob expression, or a single trigger name
   const edm::TriggerNames & hltMenu = data.hltMenu();
@@ -84,6 +84,7 @@ void PathReader::init(const Data & data) {
         unsigned int index = hltMenu.triggerIndex(*match);
         assert(index < hltMenu.size());
         m_triggers.push_back( std::make_pair(*match, index) );
+        m_mask.set(index);
       }
     }
   }
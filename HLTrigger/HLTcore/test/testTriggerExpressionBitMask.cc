@@ -0,0 +1,109 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "DataFormats/Common/interface/HLTGlobalStatus.h"
+#include "HLTrigger/HLTcore/interface/TriggerExpressionBitMask.h"
+
+#include <random>
+#include <vector>
+
+class testTriggerExpressionBitMask : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testTriggerExpressionBitMask);
+  CPPUNIT_TEST(checkMask);
+  CPPUNIT_TEST(checkRandom);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp() {}
+  void tearDown() {}
+  void checkMask();
+  void checkRandom();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( testTriggerExpressionBitMask );
+
+namespace {
+  // the previous evaluation: loop over the indices of the matching paths
+  bool anyAccept(const edm::HLTGlobalStatus & results, const std::vector<unsigned int> & indices) {
+    for (unsigned int index: indices)
+      if (results.accept(index))
+        return true;
+    return false;
+  }
+
+  void randomResults(std::mt19937 & rng, double probability, edm::HLTGlobalStatus & results) {
+    std::bernoulli_distribution accept(probability);
+    for (unsigned int i = 0; i < results.size(); ++i)
+      results[i] = edm::HLTPathStatus(accept(rng) ? edm::hlt::Pass : edm::hlt::Fail);
+  }
+}
+
+void testTriggerExpressionBitMask::checkMask() {
+  triggerExpression::BitMask mask;
+  CPPUNIT_ASSERT(mask.empty());
+  CPPUNIT_ASSERT(not mask.any(triggerExpression::BitWords()));
+
+  // bits out of order and in the same word
+  mask.set(130);
+  mask.set(3);
+  mask.set(63);
+  mask.set(64);
+  CPPUNIT_ASSERT(not mask.empty());
+
+  for (unsigned int bit = 0; bit < 200; ++bit) {
+    std::vector<bool> bits(200, false);
+    bits[bit] = true;
+    triggerExpression::BitWords words;
+    triggerExpression::packBits(bits, words);
+    CPPUNIT_ASSERT(words.size() == 4);
+    bool expected = (bit == 3 or bit == 63 or bit == 64 or bit == 130);
+    CPPUNIT_ASSERT(mask.any(words) == expected);
+  }
+
+  // decisions shorter than the mask
+  std::vector<bool> bits(100, true);
+  triggerExpression::BitWords words;
+  triggerExpression::packBits(bits, words);
+  triggerExpression::BitMask high;
+  high.set(120);
+  CPPUNIT_ASSERT(not high.any(words));
+
+  // accept decisions from the HLT results
+  edm::HLTGlobalStatus results(70);
+  results[65] = edm::HLTPathStatus(edm::hlt::Pass);
+  results[66] = edm::HLTPathStatus(edm::hlt::Exception);
+  triggerExpression::packAccept(results, words);
+  CPPUNIT_ASSERT(words.size() == 2);
+  CPPUNIT_ASSERT(words[0] == 0);
+  CPPUNIT_ASSERT(words[1] == 2);
+}
+
+// random decisions of a large menu, and expressions matching a few paths each
+void testTriggerExpressionBitMask::checkRandom() {
+  const unsigned int paths       = 600;
+  const unsigned int expressions = 400;
+  const unsigned int events      = 200;
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<unsigned int> path(0, paths - 1);
+  std::uniform_int_distribution<unsigned int> matches(2, 24);
+
+  std::vector<std::vector<unsigned int> > indices(expressions);
+  std::vector<triggerExpression::BitMask> masks(expressions);
+  for (unsigned int e = 0; e < expressions; ++e) {
+    unsigned int n = matches(rng);
+    for (unsigned int i = 0; i < n; ++i) {
+      unsigned int index = path(rng);
+      indices[e].push_back(index);
+      masks[e].set(index);
+    }
+  }
+
+  edm::HLTGlobalStatus results(paths);
+  triggerExpression::BitWords words;
+  for (unsigned int event = 0; event < events; ++event) {
+    randomResults(rng, 0.005, results);
+    triggerExpression::packAccept(results, words);
+    for (unsigned int e = 0; e < expressions; ++e)
+      CPPUNIT_ASSERT(anyAccept(results, indices[e]) == masks[e].any(words));
+  }
+}
@@ -0,0 +1,88 @@
+// Times the evaluation of the trigger expressions matching several paths,
+// with the loop over the path indices and with the bit masks of
+// TriggerExpressionBitMask.h, for a skim with hundreds of expressions on a
+// large menu. Not run as a unit test: testTriggerExpression checks that both
+// give the same decisions.
+//
+//   timeTriggerExpressionBitMask [events]
+
+#include "DataFormats/Common/interface/HLTGlobalStatus.h"
+#include "HLTrigger/HLTcore/interface/TriggerExpressionBitMask.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+  // the previous evaluation: loop over the indices of the matching paths
+  bool anyAccept(const edm::HLTGlobalStatus & results, const std::vector<unsigned int> & indices) {
+    for (unsigned int index: indices)
+      if (results.accept(index))
+        return true;
+    return false;
+  }
+
+  void randomResults(std::mt19937 & rng, double probability, edm::HLTGlobalStatus & results) {
+    std::bernoulli_distribution accept(probability);
+    for (unsigned int i = 0; i < results.size(); ++i)
+      results[i] = edm::HLTPathStatus(accept(rng) ? edm::hlt::Pass : edm::hlt::Fail);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const unsigned int paths       = 600;
+  const unsigned int expressions = 400;
+  const unsigned int events      = argc > 1 ? std::atoi(argv[1]) : 2000;
+  if (events == 0) {
+    std::cerr << "usage: " << argv[0] << " [events]" << std::endl;
+    return 1;
+  }
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<unsigned int> path(0, paths - 1);
+  std::uniform_int_distribution<unsigned int> matches(2, 24);
+
+  std::vector<std::vector<unsigned int> > indices(expressions);
+  std::vector<triggerExpression::BitMask> masks(expressions);
+  for (unsigned int e = 0; e < expressions; ++e) {
+    unsigned int n = matches(rng);
+    for (unsigned int i = 0; i < n; ++i) {
+      unsigned int index = path(rng);
+      indices[e].push_back(index);
+      masks[e].set(index);
+    }
+  }
+
+  edm::HLTGlobalStatus results(paths);
+  triggerExpression::BitWords words;
+  double tLoop = 0., tMask = 0.;
+  unsigned int nLoop = 0, nMask = 0;
+  for (unsigned int event = 0; event < events; ++event) {
+    randomResults(rng, 0.005, results);
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    for (unsigned int e = 0; e < expressions; ++e)
+      nLoop += anyAccept(results, indices[e]);
+    auto t1 = std::chrono::high_resolution_clock::now();
+    // the packing is done once per event, and shared by all expressions
+    triggerExpression::packAccept(results, words);
+    for (unsigned int e = 0; e < expressions; ++e)
+      nMask += masks[e].any(words);
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    tLoop += std::chrono::duration<double, std::micro>(t1 - t0).count();
+    tMask += std::chrono::duration<double, std::micro>(t2 - t1).count();
+  }
+
+  // the accepted counts also keep the loops from being optimised away
+  std::cout << expressions << " expressions on " << paths << " paths, " << events << " events: "
+            << tLoop / events << " us/event with the path indices, "
+            << tMask / events << " us/event with the bit masks" << std::endl;
+  if (nLoop != nMask) {
+    std::cerr << nLoop << " expressions accepted with the path indices, " << nMask << " with the bit masks" << std::endl;
+    return 1;
+  }
+  return 0;
+}
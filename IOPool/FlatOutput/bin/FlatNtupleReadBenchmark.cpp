@@ -0,0 +1,118 @@
+/** Reader benchmark for FlatNtupleOutputModule files
+
+   Reads the same quantities from a flat ntuple and from an EDM (e.g. MiniAOD)
+   file and prints the events/s of both.
+
+   From the flat ntuple only the columns whose name starts with one of the
+   given prefixes are read; from the EDM file only the branches whose name
+   starts with one of the given prefixes are read, i.e. the whole objects
+   are deserialized, as an analyzer of the EDM file would do.
+
+   Usage:
+     flatNtupleReadBenchmark <flat file> <EDM file> <column prefix>[,...] <EDM branch prefix>[,...] [passes]
+*/
+
+#include "FWCore/FWLite/interface/FWLiteEnabler.h"
+
+#include "TBranch.h"
+#include "TFile.h"
+#include "TObjArray.h"
+#include "TTree.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  std::vector<std::string> split(std::string const& list) {
+    std::vector<std::string> items;
+    std::istringstream in(list);
+    std::string item;
+    while(std::getline(in, item, ',')) {
+      if(!item.empty()) items.push_back(item);
+    }
+    return items;
+  }
+
+  // enables the branches matching one of the prefixes, returns their number
+  unsigned int selectBranches(TTree& tree, std::vector<std::string> const& prefixes) {
+    tree.SetBranchStatus("*", 0);
+    unsigned int selected = 0;
+    TObjArray* branches = tree.GetListOfBranches();
+    for(int i = 0; i < branches->GetEntriesFast(); ++i) {
+      std::string const name = static_cast<TBranch*>(branches->At(i))->GetName();
+      for(auto const& prefix : prefixes) {
+        if(name.compare(0, prefix.size(), prefix) == 0) {
+          tree.SetBranchStatus((name + "*").c_str(), 1);
+          ++selected;
+          break;
+        }
+      }
+    }
+    return selected;
+  }
+
+  // reads all entries of the Events tree, returns the events/s of the fastest pass
+  double eventsPerSecond(std::string const& fileName, std::vector<std::string> const& prefixes,
+                         unsigned int passes, Long64_t& bytes) {
+    double best = 0.;
+    for(unsigned int pass = 0; pass < passes; ++pass) {
+      std::unique_ptr<TFile> file(TFile::Open(fileName.c_str()));
+      if(!file || file->IsZombie()) {
+        std::cerr << "cannot open " << fileName << std::endl;
+        return 0.;
+      }
+      TTree* tree = dynamic_cast<TTree*>(file->Get("Events"));
+      if(tree == nullptr) {
+        std::cerr << "no Events tree in " << fileName << std::endl;
+        return 0.;
+      }
+      if(selectBranches(*tree, prefixes) == 0) {
+        std::cerr << "no branch of " << fileName << " matches the requested prefixes" << std::endl;
+        return 0.;
+      }
+      tree->SetCacheSize(30 * 1024 * 1024);
+      tree->AddBranchToCache("*", kFALSE);
+
+      auto start = std::chrono::steady_clock::now();
+      Long64_t const entries = tree->GetEntries();
+      bytes = 0;
+      for(Long64_t entry = 0; entry < entries; ++entry) {
+        bytes += tree->GetEntry(entry);
+      }
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      if(elapsed.count() > 0.) {
+        double rate = entries / elapsed.count();
+        if(rate > best) best = rate;
+      }
+    }
+    return best;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  if(argc < 5) {
+    std::cerr << "Usage: " << argv[0]
+              << " <flat file> <EDM file> <column prefix>[,...] <EDM branch prefix>[,...] [passes]" << std::endl;
+    return 1;
+  }
+  unsigned int passes = argc > 5 ? std::stoul(argv[5]) : 3;
+
+  // the dictionaries of the EDM products are needed to read their branches
+  FWLiteEnabler::enable();
+
+  Long64_t flatBytes = 0, edmBytes = 0;
+  double flat = eventsPerSecond(argv[1], split(argv[3]), passes, flatBytes);
+  double edm = eventsPerSecond(argv[2], split(argv[4]), passes, edmBytes);
+  if(flat == 0. || edm == 0.) {
+    return 1;
+  }
+
+  std::cout << "flat ntuple: " << flat << " events/s (" << flatBytes << " bytes unpacked)\n"
+            << "EDM file:    " << edm << " events/s (" << edmBytes << " bytes unpacked)\n"
+            << "ratio:       " << flat / edm << std::endl;
+  return 0;
+}
@@ -0,0 +1,368 @@
+// -*- C++ -*-
+//
+// Package:     IOPool/FlatOutput
+// Class  :     FlatNtupleOutputModule
+//
+// Implementation:
+//     Writes selected collections of the event as flat columns: for each
+//     collection a counter branch "n<name>" and, for each configured
+//     variable, a variable-length float array "<name>_<variable>[n<name>]".
+//     The variables are string expressions evaluated through the same
+//     parser as StringObjectFunction, on the element type of the collection.
+//     Only the collections kept by outputCommands can be configured; they
+//     are looked up in beginJob, once the kept products are known.
+//
+
+// system include files
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "Compression.h"
+
+// user include files
+#include "FWCore/Framework/interface/one/OutputModule.h"
+#include "FWCore/Framework/interface/EventForOutput.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/MessageLogger/interface/JobReport.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/ObjectWithDict.h"
+#include "FWCore/Utilities/interface/TypeWithDict.h"
+#include "DataFormats/Common/interface/BasicHandle.h"
+#include "DataFormats/Common/interface/FillViewHelperVector.h"
+#include "DataFormats/Common/interface/WrapperBase.h"
+#include "DataFormats/Provenance/interface/BranchDescription.h"
+#include "DataFormats/Provenance/interface/ProcessHistory.h"
+#include "DataFormats/Provenance/interface/ProcessHistoryID.h"
+#include "CommonTools/Utils/interface/expressionParser.h"
+#include "CommonTools/Utils/src/ExpressionBase.h"
+
+namespace edm {
+
+  class FlatNtupleOutputModule : public one::OutputModule<> {
+  public:
+    explicit FlatNtupleOutputModule(ParameterSet const& pset);
+    virtual ~FlatNtupleOutputModule();
+
+    static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+  private:
+    struct Column {
+      std::string name_;
+      std::string expression_;
+      reco::parser::ExpressionPtr expr_;
+      std::vector<float> values_;
+      TBranch* branch_;
+    };
+
+    struct Collection {
+      InputTag src_;
+      std::string name_;
+      std::string type_;
+      bool lazy_;
+      TypeID productType_;
+      TypeWithDict elementType_;
+      // the kept products matching src, with the process which made each
+      std::vector<std::pair<std::string, EDGetToken>> candidates_;
+      // the product read for the events of this process history
+      ProcessHistoryID historyID_;
+      EDGetToken token_;
+      Int_t size_;
+      std::vector<Column> columns_;
+    };
+
+    virtual void beginJob() override;
+    virtual void write(EventForOutput const& e) override;
+    virtual void writeLuminosityBlock(LuminosityBlockForOutput const&) override {}
+    virtual void writeRun(RunForOutput const&) override {}
+    virtual bool isFileOpen() const override;
+    virtual void openFile(FileBlock const& fb) override;
+    virtual void reallyCloseFile() override;
+
+    void resolveCollection(Collection& collection) const;
+    EDGetToken const& tokenFor(EventForOutput const& e, Collection& collection) const;
+    void fillCollection(EventForOutput const& e, Collection& collection);
+
+    std::string fileName_;
+    std::string logicalFileName_;
+    int compressionAlgorithm_;
+    int compressionLevel_;
+    int basketSize_;
+    Long64_t autoFlush_;
+
+    std::vector<Collection> collections_;
+    std::vector<void const*> pointers_;
+    FillViewHelperVector helpers_;
+
+    std::unique_ptr<TFile> file_;
+    TTree* tree_;
+    UInt_t run_;
+    UInt_t luminosityBlock_;
+    ULong64_t event_;
+    JobReport::Token jrToken_;
+  };
+
+  FlatNtupleOutputModule::FlatNtupleOutputModule(ParameterSet const& pset) :
+    one::OutputModuleBase::OutputModuleBase(pset),
+    one::OutputModule<>(pset),
+    fileName_(pset.getUntrackedParameter<std::string>("fileName")),
+    logicalFileName_(pset.getUntrackedParameter<std::string>("logicalFileName")),
+    compressionAlgorithm_(0),
+    compressionLevel_(pset.getUntrackedParameter<int>("compressionLevel")),
+    basketSize_(pset.getUntrackedParameter<int>("basketSize")),
+    autoFlush_(pset.getUntrackedParameter<int>("eventAutoFlushCompressedSize")),
+    collections_(),
+    pointers_(),
+    helpers_(),
+    file_(),
+    tree_(nullptr),
+    run_(0),
+    luminosityBlock_(0),
+    event_(0),
+    jrToken_(0) {
+
+    std::string const& algorithm = pset.getUntrackedParameter<std::string>("compressionAlgorithm");
+    if(algorithm == std::string("ZLIB")) {
+      compressionAlgorithm_ = ROOT::kZLIB;
+    } else if(algorithm == std::string("LZMA")) {
+      compressionAlgorithm_ = ROOT::kLZMA;
+    } else {
+      throw Exception(errors::Configuration) << "FlatNtupleOutputModule configured with unknown compression algorithm '" << algorithm << "'\n"
+        << "Allowed compression algorithms are ZLIB and LZMA\n";
+    }
+
+    for(auto const& collectionPSet : pset.getParameterSetVector("collections")) {
+      Collection collection;
+      collection.src_ = collectionPSet.getParameter<InputTag>("src");
+      collection.name_ = collectionPSet.getParameter<std::string>("name");
+      collection.type_ = collectionPSet.getParameter<std::string>("type");
+      collection.lazy_ = collectionPSet.getParameter<bool>("lazyParser");
+      collection.size_ = 0;
+      for(auto const& variablePSet : collectionPSet.getParameterSetVector("variables")) {
+        Column column;
+        column.name_ = variablePSet.getParameter<std::string>("name");
+        column.expression_ = variablePSet.getParameter<std::string>("expr");
+        column.branch_ = nullptr;
+        collection.columns_.push_back(std::move(column));
+      }
+      collections_.push_back(std::move(collection));
+    }
+  }
+
+  FlatNtupleOutputModule::~FlatNtupleOutputModule() {
+  }
+
+  void
+  FlatNtupleOutputModule::beginJob() {
+    for(auto& collection : collections_) {
+      resolveCollection(collection);
+    }
+  }
+
+  void
+  FlatNtupleOutputModule::resolveCollection(Collection& collection) const {
+    // all the kept products which src may refer to; which process is read is
+    // decided for each event from its process history, as getByLabel does
+    BranchDescription const* product = nullptr;
+    for(auto const& selected : keptProducts()[InEvent]) {
+      BranchDescription const& desc = *selected.first;
+      if(desc.moduleLabel() != collection.src_.label() ||
+         desc.productInstanceName() != collection.src_.instance()) continue;
+      if(!collection.src_.process().empty() && desc.processName() != collection.src_.process()) continue;
+      if(!collection.type_.empty() &&
+         desc.className() != collection.type_ && desc.friendlyClassName() != collection.type_) continue;
+      if(product != nullptr && desc.unwrappedTypeID() != product->unwrappedTypeID()) {
+        throw Exception(errors::Configuration) << "FlatNtupleOutputModule: collection '" << collection.name_
+          << "' reads " << collection.src_.encode() << ", which is kept with the types " << product->className()
+          << " and " << desc.className() << "\nSet 'type' to the class of the collection to read\n";
+      }
+      product = &desc;
+      collection.candidates_.emplace_back(desc.processName(), selected.second);
+    }
+    if(product == nullptr) {
+      throw Exception(errors::Configuration) << "FlatNtupleOutputModule: collection '" << collection.name_
+        << "' reads " << collection.src_.encode()
+        << (collection.type_.empty() ? std::string() : " of type " + collection.type_)
+        << ", which is not kept by outputCommands\n";
+    }
+    collection.productType_ = product->unwrappedTypeID();
+    collection.elementType_ = TypeWithDict(collection.productType_.typeInfo()).nestedType("value_type");
+    if(!collection.elementType_) {
+      throw Exception(errors::Configuration) << "FlatNtupleOutputModule: collection '" << collection.name_
+        << "' reads " << collection.src_.encode() << " of type " << product->className()
+        << ", which is not a collection\n";
+    }
+
+    for(auto& column : collection.columns_) {
+      if(!reco::parser::expressionParser(collection.elementType_, column.expression_, column.expr_, collection.lazy_)) {
+        throw Exception(errors::Configuration) << "FlatNtupleOutputModule: failed to parse expression '" << column.expression_
+          << "' for " << collection.name_ << "_" << column.name_ << "\n";
+      }
+    }
+  }
+
+  EDGetToken const&
+  FlatNtupleOutputModule::tokenFor(EventForOutput const& e, Collection& collection) const {
+    if(collection.candidates_.size() == 1) {
+      return collection.candidates_.front().second;
+    }
+    if(collection.historyID_ != e.processHistoryID()) {
+      // the product of the latest process of the history which made one
+      collection.historyID_ = e.processHistoryID();
+      collection.token_ = EDGetToken();
+      ProcessHistory const& history = e.processHistory();
+      for(auto it = history.rbegin(), itEnd = history.rend(); it != itEnd && collection.token_.isUninitialized(); ++it) {
+        for(auto const& candidate : collection.candidates_) {
+          if(candidate.first == it->processName()) {
+            collection.token_ = candidate.second;
+            break;
+          }
+        }
+      }
+    }
+    return collection.token_;
+  }
+
+  bool
+  FlatNtupleOutputModule::isFileOpen() const {
+    return nullptr != file_.get();
+  }
+
+  void
+  FlatNtupleOutputModule::openFile(FileBlock const&) {
+    file_.reset(TFile::Open(fileName_.c_str(), "RECREATE"));
+    if(!file_ || file_->IsZombie()) {
+      throw Exception(errors::FileOpenError) << "FlatNtupleOutputModule: could not open " << fileName_ << "\n";
+    }
+    file_->SetCompressionAlgorithm(compressionAlgorithm_);
+    file_->SetCompressionLevel(compressionLevel_);
+
+    tree_ = new TTree("Events", "Events");
+    tree_->SetDirectory(file_.get());
+    // clusters of whole events, so that a reader of a few columns does
+    // one large read per basket of each column it touches
+    tree_->SetAutoFlush(autoFlush_);
+    tree_->Branch("run", &run_, "run/i", basketSize_);
+    tree_->Branch("luminosityBlock", &luminosityBlock_, "luminosityBlock/i", basketSize_);
+    tree_->Branch("event", &event_, "event/l", basketSize_);
+    for(auto& collection : collections_) {
+      std::string const counter = "n" + collection.name_;
+      tree_->Branch(counter.c_str(), &collection.size_, (counter + "/I").c_str(), basketSize_);
+      for(auto& column : collection.columns_) {
+        std::string const name = collection.name_ + "_" + column.name_;
+        // the buffer is not allocated yet: the address is set before each Fill
+        column.values_.resize(1);
+        column.branch_ = tree_->Branch(name.c_str(), column.values_.data(), (name + "[" + counter + "]/F").c_str(), basketSize_);
+      }
+    }
+
+    Service<JobReport> reportSvc;
+    jrToken_ = reportSvc->outputFileOpened(fileName_, logicalFileName_, std::string(),
+                                           "FlatNtupleOutputModule", description().moduleLabel(),
+                                           std::string(), std::string(), std::string(),
+                                           std::vector<std::string>());
+  }
+
+  void
+  FlatNtupleOutputModule::fillCollection(EventForOutput const& e, Collection& collection) {
+    pointers_.clear();
+    helpers_.clear();
+    BasicHandle handle;
+    EDGetToken const& token = tokenFor(e, collection);
+    if(!token.isUninitialized()) {
+      e.getByToken(token, collection.productType_, handle);
+    }
+    if(handle.isValid()) {
+      handle.wrapper()->fillView(handle.id(), pointers_, helpers_);
+    } else {
+      LogWarning("FlatNtupleOutputModule") << "Product " << collection.src_.encode()
+        << " not found, writing an empty " << collection.name_ << " collection\n";
+    }
+    collection.size_ = pointers_.size();
+
+    // one column at a time, so that each output buffer is written contiguously
+    for(auto& column : collection.columns_) {
+      column.values_.resize(std::max<size_t>(pointers_.size(), 1));
+      for(size_t i = 0; i < pointers_.size(); ++i) {
+        ObjectWithDict object(collection.elementType_, const_cast<void*>(pointers_[i]));
+        column.values_[i] = column.expr_->value(object);
+      }
+      column.branch_->SetAddress(column.values_.data());
+    }
+  }
+
+  void
+  FlatNtupleOutputModule::write(EventForOutput const& e) {
+    run_ = e.id().run();
+    luminosityBlock_ = e.id().luminosityBlock();
+    event_ = e.id().event();
+    for(auto& collection : collections_) {
+      fillCollection(e, collection);
+    }
+    tree_->Fill();
+
+    Service<JobReport> reportSvc;
+    reportSvc->eventWrittenToFile(jrToken_, e.id().run(), e.id().event());
+  }
+
+  void
+  FlatNtupleOutputModule::reallyCloseFile() {
+    file_->cd();
+    tree_->Write();
+    tree_ = nullptr;
+    file_->Close();
+    file_.reset();
+
+    Service<JobReport> reportSvc;
+    reportSvc->outputFileClosed(jrToken_);
+  }
+
+  void
+  FlatNtupleOutputModule::fillDescriptions(ConfigurationDescriptions& descriptions) {
+    ParameterSetDescription desc;
+    desc.setComment("Writes selected collections as flat columns, one variable-length float array per variable.");
+    desc.addUntracked<std::string>("fileName")
+      ->setComment("Name of the output file.");
+    desc.addUntracked<std::string>("logicalFileName", "")
+      ->setComment("Passed to the job report.");
+    desc.addUntracked<std::string>("compressionAlgorithm", "ZLIB")
+      ->setComment("Algorithm used to compress the columns: ZLIB or LZMA.\n"
+                   "ZLIB decompresses several times faster, which dominates columnar reading.");
+    desc.addUntracked<int>("compressionLevel", 4)
+      ->setComment("ROOT compression level of the output file.");
+    desc.addUntracked<int>("basketSize", 32768)
+      ->setComment("Initial basket size of each column; ROOT resizes them at the first cluster.");
+    desc.addUntracked<int>("eventAutoFlushCompressedSize", -20 * 1024 * 1024)
+      ->setComment("Passed to TTree::SetAutoFlush: negative is the compressed size of a cluster in bytes,\n"
+                   "positive a number of events.");
+
+    ParameterSetDescription variable;
+    variable.add<std::string>("name");
+    variable.add<std::string>("expr");
+
+    ParameterSetDescription collection;
+    collection.add<InputTag>("src");
+    collection.add<std::string>("name");
+    collection.add<std::string>("type", "")
+      ->setComment("Class of the collection, needed only if src is kept with several types.");
+    collection.add<bool>("lazyParser", false);
+    collection.addVPSet("variables", variable, std::vector<ParameterSet>());
+
+    desc.addVPSet("collections", collection, std::vector<ParameterSet>());
+
+    one::OutputModule<>::fillDescription(desc);
+    descriptions.add("flatNtupleOutputModule", desc);
+  }
+}
+
+using edm::FlatNtupleOutputModule;
+DEFINE_FWK_MODULE(FlatNtupleOutputModule);
@@ -0,0 +1,40 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTFLATOUTPUT")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1000)
+)
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.flat = cms.OutputModule("FlatNtupleOutputModule",
+    fileName = cms.untracked.string('file:FlatNtupleOutputTest.root'),
+    outputCommands = cms.untracked.vstring(
+        'drop *',
+        'keep *_Thing_*_*'
+    ),
+    collections = cms.VPSet(
+        cms.PSet(
+            src = cms.InputTag("Thing"),
+            name = cms.string("thing"),
+            variables = cms.VPSet(
+                cms.PSet(name = cms.string("a"), expr = cms.string("a")),
+                cms.PSet(name = cms.string("twiceA"), expr = cms.string("2 * a"))
+            )
+        )
+    )
+)
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:FlatNtupleOutputTestEDM.root'),
+    outputCommands = cms.untracked.vstring(
+        'drop *',
+        'keep *_Thing_*_*'
+    )
+)
+
+process.source = cms.Source("EmptySource")
+
+process.p = cms.Path(process.Thing)
+process.ep = cms.EndPath(process.flat + process.output)
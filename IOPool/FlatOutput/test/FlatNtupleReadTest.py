@@ -0,0 +1,14 @@
+# Checks the columns written by FlatNtupleOutputTest_cfg.py
+import sys
+import ROOT
+
+f = ROOT.TFile.Open("FlatNtupleOutputTest.root")
+t = f.Get("Events")
+if t.GetEntries() != 1000:
+    sys.exit("expected 1000 events, found %d" % t.GetEntries())
+for event in t:
+    if event.nthing != 20:
+        sys.exit("event %d: expected 20 things, found %d" % (event.event, event.nthing))
+    for i in range(event.nthing):
+        if event.thing_twiceA[i] != 2 * event.thing_a[i]:
+            sys.exit("event %d: thing_twiceA[%d] is not 2 * thing_a[%d]" % (event.event, i, i))
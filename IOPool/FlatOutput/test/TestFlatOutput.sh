@@ -0,0 +1,13 @@
+#!/bin/sh
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+pushd ${LOCAL_TMP_DIR}
+
+cmsRun --parameter-set ${LOCAL_TEST_DIR}/FlatNtupleOutputTest_cfg.py || die 'Failure using FlatNtupleOutputTest_cfg.py' $?
+
+python ${LOCAL_TEST_DIR}/FlatNtupleReadTest.py || die 'Failure using FlatNtupleReadTest.py' $?
+
+flatNtupleReadBenchmark FlatNtupleOutputTest.root FlatNtupleOutputTestEDM.root thing edmtestThings_Thing__ 1 || die 'Failure using flatNtupleReadBenchmark' $?
+
+popd
@@ -31,6 +31,8 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/Registry.h"
+#include "FWCore/PluginManager/interface/PluginCapabilities.h"
+#include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/Sources/interface/EventSkipperByID.h"
 #include "FWCore/Sources/interface/DaqProvenanceHelper.h"
 #include "FWCore/Utilities/interface/Algorithms.h"
@@ -39,6 +41,7 @@
 #include "FWCore/Utilities/interface/FriendlyName.h"
 #include "FWCore/Utilities/interface/GlobalIdentifier.h"
 #include "FWCore/Utilities/interface/ReleaseVersion.h"
+#include "FWCore/Utilities/interface/WrappedClassName.h"
 #include "FWCore/Version/interface/GetReleaseVersion.h"
 #include "IOPool/Common/interface/getWrapperBasePtr.h"
 
@@ -446,6 +449,16 @@ namespace edm {
 
     // Set product presence information in the product registry.
     ProductRegistry::ProductList& pList = inputProdDescReg.productListUpdator();
+    // Load the dictionaries of all the products of the file in one go,
+    // instead of one library at a time as each branch asks for its class.
+    if(edmplugin::PluginManager::isAvailable()) {
+      std::vector<std::string> classNames;
+      classNames.reserve(pList.size());
+      for(auto const& product : pList) {
+        classNames.push_back(wrappedClassName(product.second.className()));
+      }
+      edmplugin::PluginCapabilities::get()->preload(classNames);
+    }
     for(auto& product : pList) {
       BranchDescription& prod = product.second;
       prod.init();
@@ -29,6 +29,10 @@ cmsRun --parameter-set ${LOCAL_TEST_DIR}/poolsource_multiprocess_gen_file_cfg.py
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/poolsource_multiprocess_cfg.py || die 'Failure using poolsource_multiprocess_cfg.py' $?
 
+cmsRun -j multiprocess_jobreport_0.xml ${LOCAL_TEST_DIR}/poolsource_multiprocess_jobreport_cfg.py 0 || die 'Failure using poolsource_multiprocess_jobreport_cfg.py 0' $?
+cmsRun -j multiprocess_jobreport_2.xml ${LOCAL_TEST_DIR}/poolsource_multiprocess_jobreport_cfg.py 2 || die 'Failure using poolsource_multiprocess_jobreport_cfg.py 2' $?
+python ${LOCAL_TEST_DIR}/check_multiprocess_jobreport.py multiprocess_jobreport_2.xml multiprocess_jobreport_0.xml 2 || die 'Failure checking the job report of poolsource_multiprocess_jobreport_cfg.py' $?
+
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/poolsource_multiprocess_gen_file_oneRun_cfg.py || die 'Failure using poolsource_multiprocess_gen_file_oneRun_cfg.py' $?
 
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/poolsource_multiprocess_oneRun_cfg.py || die 'Failure using poolsource_multiprocess_oneRun_cfg.py' $?
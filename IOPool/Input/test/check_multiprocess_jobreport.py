@@ -0,0 +1,104 @@
+#!/usr/bin/env python
+# Checks the job report of poolsource_multiprocess_jobreport_cfg.py run with
+# forked children against the one of the same job run as a single process:
+#  - the report is well formed XML;
+#  - it holds one ChildProcessReport per child, each with the report of
+#    the child;
+#  - it holds no InputFile of its own, the parent reads no events;
+#  - the Runs of the ChildProcessReports are the union of the runs and lumi
+#    sections the children read, and these are the ones the single process
+#    read;
+#  - the private memory which SimpleMemoryCheck reports for each child at its
+#    largest RSS event is below the one of the single process: the pages set
+#    up before the fork are shared with the parent and the other children and
+#    only count in the PSS of the child. A child redoing that work would have
+#    them private, as the single process does.
+#
+#   check_multiprocess_jobreport.py <forked report> <single process report> <children>
+
+import sys
+import xml.etree.ElementTree as ET
+
+# private memory of a child over the one of the single process
+maxPrivateRatio = 0.9
+
+def fail(message):
+    print("check_multiprocess_jobreport.py: " + message)
+    sys.exit(1)
+
+def parse(fileName):
+    try:
+        return ET.parse(fileName).getroot()
+    except Exception as e:
+        fail("%s is not a well formed job report: %s" % (fileName, e))
+
+def runsIn(element):
+    runs = {}
+    for run in element.findall("Run"):
+        lumis = runs.setdefault(int(run.get("ID")), set())
+        for lumi in run.findall("LumiSection"):
+            lumis.add(int(lumi.get("ID")))
+    return runs
+
+def addRuns(runs, moreRuns):
+    for run, lumis in moreRuns.items():
+        runs.setdefault(run, set()).update(lumis)
+
+def inputRuns(report):
+    runs = {}
+    for inputFile in report.findall("InputFile"):
+        addRuns(runs, runsIn(inputFile.find("Runs")))
+    return runs
+
+def applicationMemory(report, metricName, name):
+    for summary in report.findall("PerformanceReport/PerformanceSummary"):
+        if summary.get("Metric") == "ApplicationMemory":
+            for metric in summary.findall("Metric"):
+                if metric.get("Name") == metricName:
+                    return float(metric.get("Value"))
+    fail("no %s from SimpleMemoryCheck in %s" % (metricName, name))
+
+def privateMemory(report, name):
+    return applicationMemory(report, "LargestRssEvent-g-PRIVATE", name)
+
+def pss(report, name):
+    return applicationMemory(report, "LargestRssEvent-h-PSS", name)
+
+forked = parse(sys.argv[1])
+single = parse(sys.argv[2])
+numberOfChildren = int(sys.argv[3])
+
+if forked.findall("InputFile"):
+    fail("the report of the parent holds InputFiles outside of the ChildProcessReports")
+
+childReports = forked.findall("ChildProcessReports")
+if len(childReports) != 1:
+    fail("%d ChildProcessReports instead of 1" % len(childReports))
+children = childReports[0].findall("ChildProcessReport")
+indices = sorted(int(child.get("Index")) for child in children)
+if indices != list(range(numberOfChildren)):
+    fail("ChildProcessReports for the children %s instead of 0 to %d" % (indices, numberOfChildren - 1))
+
+singleRuns = inputRuns(single)
+singlePrivate = privateMemory(single, "the single process report")
+childrenRuns = {}
+for child in children:
+    index = child.get("Index")
+    if child.find("ReadError") is not None:
+        fail("the report of child %s could not be read" % index)
+    addRuns(childrenRuns, inputRuns(child))
+    name = "the report of child " + index
+    private = privateMemory(child, name)
+    print("child %s: private %.1f MB, PSS %.1f MB; single process: private %.1f MB" %
+          (index, private, pss(child, name), singlePrivate))
+    if private > maxPrivateRatio * singlePrivate:
+        fail("child %s has more than %.2f times the private memory of the single process" % (index, maxPrivateRatio))
+
+mergedRuns = runsIn(childReports[0].find("Runs"))
+if mergedRuns != childrenRuns:
+    fail("the merged Runs %s are not the union of those of the children %s" % (mergedRuns, childrenRuns))
+if mergedRuns != singleRuns:
+    fail("the children read the runs %s, the single process %s" % (mergedRuns, singleRuns))
+if not singleRuns:
+    fail("no runs read")
+print("job report of %d children OK" % numberOfChildren)
@@ -0,0 +1,29 @@
+# Reads the file of poolsource_multiprocess_gen_file_cfg.py with the number
+# of forked children given on the command line, 0 for a single process, and
+# reports the private memory and PSS used in the job report.
+#
+#   cmsRun -j report.xml poolsource_multiprocess_jobreport_cfg.py <children>
+
+import FWCore.ParameterSet.Config as cms
+from sys import argv
+
+process = cms.Process("TEST")
+
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+numberOfChildren = int(argv[2])
+if numberOfChildren > 0:
+    process.options = cms.untracked.PSet(multiProcesses=cms.untracked.PSet(
+        maxChildProcesses=cms.untracked.int32(numberOfChildren),
+        maxSequentialEventsPerChild=cms.untracked.uint32(3)))
+
+process.source = cms.Source("PoolSource", fileNames = cms.untracked.vstring("file:multiprocess_test.root"))
+
+process.SimpleMemoryCheck = cms.Service("SimpleMemoryCheck",
+    ignoreTotal = cms.untracked.int32(1),
+    monitorPssAndPrivate = cms.untracked.bool(True))
+
+process.out = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string("multiprocess_jobreport_%d.root" % numberOfChildren))
+
+process.ep = cms.EndPath(process.out)
@@ -0,0 +1,54 @@
+///
+/// Description: Dense (ieta,iphi) arrays of the tower quantities used by the Stage 2 algorithms
+///
+/// Implementation:
+///    Filled once per event from the tower collection, with the same tower
+///    selection as CaloTools::getTower, so that the algorithms read the
+///    hardware quantities of a ring as contiguous arrays instead of looking
+///    up each tower; positions without a tower read as 0, like the null tower.
+///    Towers outside of |iEta|<=kHFEnd, 1<=iPhi<=kNPhi are ignored, while
+///    getTower would still find them by their (invalid) coordinates
+///
+
+#ifndef L1Trigger_L1TCalorimeter_CaloTowerGrid_h
+#define L1Trigger_L1TCalorimeter_CaloTowerGrid_h
+
+#include "DataFormats/L1TCalorimeter/interface/CaloTower.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloTools.h"
+
+#include <vector>
+
+namespace l1t {
+
+  class CaloTowerGrid {
+  public:
+    static const int kNEta = 2*CaloTools::kHFEnd+1; // ieta=0 is a row of empty towers
+    static const int kNPhi = CaloTools::kNPhi;
+
+    explicit CaloTowerGrid(const std::vector<l1t::CaloTower>& towers);
+
+    //hardware quantities of tower (iEta,iPhi), 0 outside the calorimeter
+    int hwPt(int iEta,int iPhi)const{return inGrid(iEta,iPhi) ? hwPt_[index(iEta,iPhi)] : 0;}
+    int hwEtEm(int iEta,int iPhi)const{return inGrid(iEta,iPhi) ? hwEtEm_[index(iEta,iPhi)] : 0;}
+    int hwEtHad(int iEta,int iPhi)const{return inGrid(iEta,iPhi) ? hwEtHad_[index(iEta,iPhi)] : 0;}
+    int hwQual(int iEta,int iPhi)const{return inGrid(iEta,iPhi) ? hwQual_[index(iEta,iPhi)] : 0;}
+
+    //the kNPhi values of a ring, iphi=1 first; iEta must be in [-kHFEnd,kHFEnd]
+    const int* hwPtRing(int iEta)const{return &hwPt_[index(iEta,1)];}
+    const int* hwQualRing(int iEta)const{return &hwQual_[index(iEta,1)];}
+
+  private:
+    static bool inGrid(int iEta,int iPhi){
+      return iEta>=-CaloTools::kHFEnd && iEta<=CaloTools::kHFEnd && iPhi>=1 && iPhi<=kNPhi;
+    }
+    static size_t index(int iEta,int iPhi){return (iEta+CaloTools::kHFEnd)*kNPhi+iPhi-1;}
+
+    std::vector<int> hwPt_;
+    std::vector<int> hwEtEm_;
+    std::vector<int> hwEtHad_;
+    std::vector<int> hwQual_;
+  };
+
+}
+
+#endif
@@ -15,6 +15,7 @@
 
 #include "L1Trigger/L1TCalorimeter/interface/Stage2Layer2JetAlgorithm.h"
 #include "L1Trigger/L1TCalorimeter/interface/CaloParamsHelper.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloTowerGrid.h"
 
 namespace l1t {
 
@@ -34,10 +35,10 @@ namespace l1t {
     double calibFit(double, double*);
 
     int donutPUEstimate(int jetEta, int jetPhi, int size,
-                        const std::vector<l1t::CaloTower> & towers);
+                        const l1t::CaloTowerGrid & grid);
 
     int chunkyDonutPUEstimate(int jetEta, int jetPhi, int pos,
-                              const std::vector<l1t::CaloTower> & towers);
+                              const l1t::CaloTowerGrid & grid);
 
   private:
 
@@ -0,0 +1,28 @@
+#include "L1Trigger/L1TCalorimeter/interface/CaloTowerGrid.h"
+
+l1t::CaloTowerGrid::CaloTowerGrid(const std::vector<l1t::CaloTower>& towers):
+  hwPt_(kNEta*kNPhi,0),
+  hwEtEm_(kNEta*kNPhi,0),
+  hwEtHad_(kNEta*kNPhi,0),
+  hwQual_(kNEta*kNPhi,0)
+{
+  //CaloTools::getTower returns the tower at the hashed position if it is the
+  //right one, and the first tower with the right (iEta,iPhi) otherwise:
+  //fill the grid in the same order so that both agree even for unusual layouts.
+  //Invalid positions inside the grid (iEta=0) are found by the search as well
+  std::vector<bool> filled(kNEta*kNPhi,false);
+  for(int pass=0;pass<2;pass++){
+    for(size_t towerNr=0;towerNr<towers.size();towerNr++){
+      const l1t::CaloTower& tower = towers[towerNr];
+      if(!inGrid(tower.hwEta(),tower.hwPhi())) continue;
+      if(pass==0 && CaloTools::caloTowerHash(tower.hwEta(),tower.hwPhi())!=towerNr) continue;
+      size_t i = index(tower.hwEta(),tower.hwPhi());
+      if(filled[i]) continue;
+      filled[i] = true;
+      hwPt_[i] = tower.hwPt();
+      hwEtEm_[i] = tower.hwEtEm();
+      hwEtHad_[i] = tower.hwEtHad();
+      hwQual_[i] = tower.hwQual();
+    }
+  }
+}
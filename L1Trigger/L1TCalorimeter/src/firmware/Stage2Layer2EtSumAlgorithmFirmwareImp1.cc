@@ -8,6 +8,7 @@
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "L1Trigger/L1TCalorimeter/interface/Stage2Layer2EtSumAlgorithmFirmware.h"
 #include "L1Trigger/L1TCalorimeter/interface/CaloTools.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloTowerGrid.h"
 #include <math.h>
 
 
@@ -32,7 +33,10 @@ l1t::Stage2Layer2EtSumAlgorithmFirmwareImp1::~Stage2Layer2EtSumAlgorithmFirmware
 void l1t::Stage2Layer2EtSumAlgorithmFirmwareImp1::processEvent(const std::vector<l1t::CaloTower> & towers,
                                                                std::vector<l1t::EtSum> & etsums) {
 
-  
+
+  // the tower quantities as one array per ring
+  const CaloTowerGrid grid(towers);
+
   // etaSide=1 is positive eta, etaSide=-1 is negative eta
   for (int etaSide=1; etaSide>=-1; etaSide-=2) {
 
@@ -46,46 +50,55 @@ void l1t::Stage2Layer2EtSumAlgorithmFirmwareImp1::processEvent(const std::vector
 
       // TODO add the eta and Et thresholds
 
+      // all towers of a ring share their eta, so the eta conditions are decided
+      // once per ring; towers missing from the input read as hwPt 0 and
+      // quality 0, and so contribute nothing, as the null tower did
+      const int mpEta = CaloTools::mpEta(absieta);
+      const bool inMet  = mpEta<=metEtaMax_;
+      const bool inMet2 = mpEta<=metEtaMax2_;
+      const bool inEtt  = mpEta<=ettEtaMax_;
+      const bool inMB   = mpEta>CaloTools::kHFBegin && mpEta<CaloTools::kHFEnd;
+
+      const int* pt   = grid.hwPtRing(ieta);
+      const int* qual = grid.hwQualRing(ieta);
+
       int32_t ringEx(0), ringEy(0), ringEt(0);
       int32_t ringEx2(0), ringEy2(0);
       uint32_t ringMB0(0), ringMB1(0);
 
-      for (int iphi=1; iphi<=CaloTools::kHBHENrPhi; iphi++) {
-      
-        l1t::CaloTower tower = l1t::CaloTools::getTower(towers, ieta, iphi);
-	
-	
-
-
-	  if (tower.hwPt()>metTowThresholdHw_ && CaloTools::mpEta(abs(tower.hwEta()))<=metEtaMax_) {
-	    
-	    // x- and -y coefficients are truncated by after multiplication of Et by trig coefficient.
-	    // The trig coefficients themselves take values [-1023,1023] and so were scaled by
-	    // 2^10 = 1024, which requires bitwise shift to the right of the final value by 10 bits.
-	    // This is accounted for at ouput of demux (see Stage2Layer2DemuxSumsAlgoFirmwareImp1.cc)
-	    ringEx += (int32_t) (tower.hwPt() * CaloTools::cos_coeff[iphi - 1] );
-	    ringEy += (int32_t) (tower.hwPt() * CaloTools::sin_coeff[iphi - 1] );	    
-	  }
-
-
-	// MET no HF
-	if (tower.hwPt()>metTowThresholdHw2_ && CaloTools::mpEta(abs(tower.hwEta()))<=metEtaMax2_) {
-	  ringEx2 += (int32_t) (tower.hwPt() * CaloTools::cos_coeff[iphi - 1] );
-	  ringEy2 += (int32_t) (tower.hwPt() * CaloTools::sin_coeff[iphi - 1] );	    
-	}
-	
-	// scalar sum
-	if (tower.hwPt()>ettTowThresholdHw_ && CaloTools::mpEta(abs(tower.hwEta()))<=ettEtaMax_) 
-	  ringEt += tower.hwPt();
-		
-	// count HF tower HCAL flags
-	if (CaloTools::mpEta(abs(tower.hwEta()))>CaloTools::kHFBegin &&
-	    CaloTools::mpEta(abs(tower.hwEta()))<CaloTools::kHFEnd &&
-	    (tower.hwQual() & 0x4) > 0) 
-	  ringMB1 += 1;
-	
-      }    
-      
+      // x- and -y coefficients are truncated by after multiplication of Et by trig coefficient.
+      // The trig coefficients themselves take values [-1023,1023] and so were scaled by
+      // 2^10 = 1024, which requires bitwise shift to the right of the final value by 10 bits.
+      // This is accounted for at ouput of demux (see Stage2Layer2DemuxSumsAlgoFirmwareImp1.cc)
+      if (inMet) {
+        for (int i=0; i<CaloTools::kHBHENrPhi; i++) {
+          const int32_t towEt = pt[i]>metTowThresholdHw_ ? pt[i] : 0;
+          ringEx += towEt * CaloTools::cos_coeff[i];
+          ringEy += towEt * CaloTools::sin_coeff[i];
+        }
+      }
+
+      // MET no HF
+      if (inMet2) {
+        for (int i=0; i<CaloTools::kHBHENrPhi; i++) {
+          const int32_t towEt = pt[i]>metTowThresholdHw2_ ? pt[i] : 0;
+          ringEx2 += towEt * CaloTools::cos_coeff[i];
+          ringEy2 += towEt * CaloTools::sin_coeff[i];
+        }
+      }
+
+      // scalar sum
+      if (inEtt) {
+        for (int i=0; i<CaloTools::kHBHENrPhi; i++)
+          ringEt += pt[i]>ettTowThresholdHw_ ? pt[i] : 0;
+      }
+
+      // count HF tower HCAL flags
+      if (inMB) {
+        for (int i=0; i<CaloTools::kHBHENrPhi; i++)
+          ringMB1 += (qual[i] & 0x4) > 0;
+      }
+
       ex += ringEx;
       ey += ringEy;
       et += ringEt;
@@ -9,6 +9,7 @@
 #include "L1Trigger/L1TCalorimeter/interface/Stage2Layer2JetAlgorithmFirmware.h"
 #include "DataFormats/Math/interface/LorentzVector.h"
 #include "L1Trigger/L1TCalorimeter/interface/CaloTools.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloTowerGrid.h"
 #include "L1Trigger/L1TCalorimeter/interface/BitonicSort.h"
 #include "CondFormats/L1TObjects/interface/CaloParams.h"
 
@@ -70,7 +71,11 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 						       std::vector<l1t::Jet> & jets, 
 						       std::vector<l1t::Jet> & alljets, 
 						       std::string PUSubMethod) {
-  
+
+  // the sliding window reads each tower up to 81 times: look the towers up once
+  const CaloTowerGrid grid(towers);
+  const double seedThreshold = floor(params_->jetSeedThreshold()/params_->towerLsbSum());
+
   // etaSide=1 is positive eta, etaSide=-1 is negative eta
   for (int etaSide=1; etaSide>=-1; etaSide-=2) {
     
@@ -108,14 +113,12 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 	  if (jetsRing.size()==18) break;
 	  
 	  // seed tower
-	  const CaloTower& tow = CaloTools::getTower(towers, ieta, iphi); 
-	  
-	  int seedEt = tow.hwPt();
+	  int seedEt = grid.hwPt(ieta, iphi);
 	  int iEt = seedEt;
 	  bool vetoCandidate = false;
 	  
 	  // check it passes the seed threshold
-	  if(iEt < floor(params_->jetSeedThreshold()/params_->towerLsbSum())) continue;
+	  if(iEt < seedThreshold) continue;
 	  
 	  // loop over towers in this jet
 	  for( int deta = -4; deta < 5; ++deta ) {
@@ -134,8 +137,7 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 	      if (ieta < 0 && ietaTest >=0) ietaTest += 1;
 	   
 	      // check jet mask and sum tower et
-	      const CaloTower& towTest = CaloTools::getTower(towers, ietaTest, iphiTest);
-	      towEt = towTest.hwPt();
+	      towEt = grid.hwPt(ietaTest, iphiTest);
 	      
               if      (mask_[8-(dphi+4)][deta+4] == 0) continue;
 	      else if (mask_[8-(dphi+4)][deta+4] == 1) vetoCandidate = (seedEt < towEt);
@@ -151,8 +153,8 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 	  // add the jet to the list
 	  if (!vetoCandidate) {
 	
-	    if (PUSubMethod == "Donut")       iEt -= donutPUEstimate(ieta, iphi, 5, towers);	    
-	    if (PUSubMethod == "ChunkyDonut") iEt -= chunkyDonutPUEstimate(ieta, iphi, 5, towers);
+	    if (PUSubMethod == "Donut")       iEt -= donutPUEstimate(ieta, iphi, 5, grid);	    
+	    if (PUSubMethod == "ChunkyDonut") iEt -= chunkyDonutPUEstimate(ieta, iphi, 5, grid);
 	    	   
             if (iEt<=0) continue;
  
@@ -213,7 +215,7 @@ void l1t::Stage2Layer2JetAlgorithmFirmwareImp1::create(const std::vector<l1t::Ca
 int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::donutPUEstimate(int jetEta, 
 							       int jetPhi, 
 							       int size, 
-							       const std::vector<l1t::CaloTower> & towers){
+							       const l1t::CaloTowerGrid & grid){
 
   //ring is a vector with 4 ring strips, one for each side of the ring
   std::vector<int> ring(4,0);
@@ -240,12 +242,10 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::donutPUEstimate(int jetEta,
       towerEta=ieta;
     }
     
-    const CaloTower& tow = CaloTools::getTower(towers, towerEta, iphiUp);
-    int towEt = tow.hwPt();
+    int towEt = grid.hwPt(towerEta, iphiUp);
     ring[0]+=towEt;
     
-    const CaloTower& tow2 = CaloTools::getTower(towers, towerEta, iphiDown);
-    towEt = tow2.hwPt();
+    towEt = grid.hwPt(towerEta, iphiDown);
     ring[1]+=towEt;
     
   } 
@@ -257,12 +257,10 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::donutPUEstimate(int jetEta,
     while ( towerPhi > CaloTools::kHBHENrPhi ) towerPhi -= CaloTools::kHBHENrPhi;
     while ( towerPhi < 1 ) towerPhi += CaloTools::kHBHENrPhi;
     
-    const CaloTower& tow = CaloTools::getTower(towers, ietaUp, towerPhi);
-    int towEt = tow.hwPt();
+    int towEt = grid.hwPt(ietaUp, towerPhi);
     ring[2]+=towEt;
     
-    const CaloTower& tow2 = CaloTools::getTower(towers, ietaDown, towerPhi);
-    towEt = tow2.hwPt();
+    towEt = grid.hwPt(ietaDown, towerPhi);
     ring[3]+=towEt;
   } 
   
@@ -275,7 +273,7 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::donutPUEstimate(int jetEta,
 int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::chunkyDonutPUEstimate(int jetEta, 
 								     int jetPhi, 
 								     int size, 
-								     const std::vector<l1t::CaloTower> & towers){
+								     const l1t::CaloTowerGrid & grid){
  
    // ring is a vector with 4 ring strips, one for each side of the ring
   // order is PhiUp, PhiDown, EtaUp, EtaDown
@@ -306,12 +304,10 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::chunkyDonutPUEstimate(int jetEta,
       if (jetEta>0 && towEta<=0) towEta-=1;
       if (jetEta<0 && towEta>=0) towEta+=1;
             
-      const CaloTower& towPhiUp = CaloTools::getTower(towers, towEta, iphiUp);
-      int towEt = towPhiUp.hwPt();
+      int towEt = grid.hwPt(towEta, iphiUp);
       ring[0] += towEt;
             
-      const CaloTower& towPhiDown = CaloTools::getTower(towers, towEta, iphiDown);
-      towEt = towPhiDown.hwPt();
+      towEt = grid.hwPt(towEta, iphiDown);
       ring[1] += towEt;
             
     } 
@@ -324,8 +320,7 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::chunkyDonutPUEstimate(int jetEta,
         while ( towPhi > CaloTools::kHBHENrPhi ) towPhi -= CaloTools::kHBHENrPhi;
         while ( towPhi < 1 ) towPhi += CaloTools::kHBHENrPhi;
 
-        const CaloTower& towEtaUp = CaloTools::getTower(towers, ietaUp, towPhi);
-        int towEt = towEtaUp.hwPt();
+        int towEt = grid.hwPt(ietaUp, towPhi);
         ring[2] += towEt;
       }else{
         ring[2] = 0;
@@ -342,8 +337,7 @@ int l1t::Stage2Layer2JetAlgorithmFirmwareImp1::chunkyDonutPUEstimate(int jetEta,
         while ( towPhi > CaloTools::kHBHENrPhi ) towPhi -= CaloTools::kHBHENrPhi;
         while ( towPhi < 1 ) towPhi += CaloTools::kHBHENrPhi;
 	
-        const CaloTower& towEtaDown = CaloTools::getTower(towers, ietaDown, towPhi);
-        int towEt = towEtaDown.hwPt();
+        int towEt = grid.hwPt(ietaDown, towPhi);
         ring[3] += towEt;
       }else{
         ring[3] = 0;
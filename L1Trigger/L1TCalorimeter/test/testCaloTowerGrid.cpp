@@ -0,0 +1,385 @@
+// Checks that the Stage 2 jet and energy sum algorithms give bit-identical
+// results whether the towers are read with CaloTools::getTower, as before
+// CaloTowerGrid, or from the grid.  The getTower versions of the algorithms
+// are kept here as the reference; the towers are random collections in the
+// layout of the tower producer, shuffled, with towers missing and with
+// duplicated towers.
+
+#include "L1Trigger/L1TCalorimeter/interface/BitonicSort.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloParamsHelper.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloTools.h"
+#include "L1Trigger/L1TCalorimeter/interface/CaloTowerGrid.h"
+#include "L1Trigger/L1TCalorimeter/interface/Stage2Layer2EtSumAlgorithmFirmware.h"
+#include "L1Trigger/L1TCalorimeter/interface/Stage2Layer2JetAlgorithmFirmware.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using l1t::CaloTools;
+
+namespace l1t {
+  // defined with the jet algorithm, used by BitonicSort
+  bool operator > ( l1t::Jet& a, l1t::Jet& b );
+}
+
+namespace {
+
+  const int refMask[9][9] = {
+    { 1,2,2,2,2,2,2,2,2 },
+    { 1,1,2,2,2,2,2,2,2 },
+    { 1,1,1,2,2,2,2,2,2 },
+    { 1,1,1,1,2,2,2,2,2 },
+    { 1,1,1,1,0,2,2,2,2 },
+    { 1,1,1,1,1,2,2,2,2 },
+    { 1,1,1,1,1,1,2,2,2 },
+    { 1,1,1,1,1,1,1,2,2 },
+    { 1,1,1,1,1,1,1,1,2 },
+  };
+
+  int towEt(const std::vector<l1t::CaloTower>& towers, int ieta, int iphi) {
+    return CaloTools::getTower(towers, ieta, iphi).hwPt();
+  }
+
+  // Stage2Layer2JetAlgorithmFirmwareImp1::donutPUEstimate reading getTower
+  int refDonut(int jetEta, int jetPhi, int size, const std::vector<l1t::CaloTower>& towers) {
+    std::vector<int> ring(4,0);
+    int iphiUp = jetPhi + size;
+    while ( iphiUp > CaloTools::kHBHENrPhi ) iphiUp -= CaloTools::kHBHENrPhi;
+    int iphiDown = jetPhi - size;
+    while ( iphiDown < 1 ) iphiDown += CaloTools::kHBHENrPhi;
+    int ietaUp = (jetEta + size > CaloTools::kHFEnd) ? 999 : jetEta+size;
+    int ietaDown = (abs(jetEta - size) > CaloTools::kHFEnd) ? 999 : jetEta-size;
+    for (int ieta = jetEta - size+1; ieta < jetEta + size; ++ieta) {
+      if (abs(ieta) > CaloTools::kHFEnd || abs(ieta) < 1) continue;
+      int towerEta;
+      if (jetEta > 0 && ieta <=0) towerEta = ieta-1;
+      else if (jetEta < 0 && ieta >=0) towerEta = ieta+1;
+      else towerEta=ieta;
+      ring[0] += towEt(towers, towerEta, iphiUp);
+      ring[1] += towEt(towers, towerEta, iphiDown);
+    }
+    for (int iphi = jetPhi - size+1; iphi < jetPhi + size; ++iphi) {
+      int towerPhi = iphi;
+      while ( towerPhi > CaloTools::kHBHENrPhi ) towerPhi -= CaloTools::kHBHENrPhi;
+      while ( towerPhi < 1 ) towerPhi += CaloTools::kHBHENrPhi;
+      ring[2] += towEt(towers, ietaUp, towerPhi);
+      ring[3] += towEt(towers, ietaDown, towerPhi);
+    }
+    std::sort(ring.begin(), ring.end(), std::greater<int>());
+    return 4*( ring[1]+ring[2] );
+  }
+
+  // Stage2Layer2JetAlgorithmFirmwareImp1::chunkyDonutPUEstimate reading getTower
+  int refChunkyDonut(int jetEta, int jetPhi, int size, const std::vector<l1t::CaloTower>& towers) {
+    std::vector<int> ring(4,0);
+    int nStrips = 3;
+    for (int stripIt=0; stripIt<nStrips; stripIt++) {
+      int iphiUp   = jetPhi + size + stripIt;
+      int iphiDown = jetPhi - size - stripIt;
+      while ( iphiUp > CaloTools::kHBHENrPhi )   iphiUp   -= CaloTools::kHBHENrPhi;
+      while ( iphiDown < 1 ) iphiDown += CaloTools::kHBHENrPhi;
+      int ietaUp   = jetEta + size + stripIt;
+      int ietaDown = jetEta - size - stripIt;
+      if ( jetEta<0 && ietaUp>=0 )   ietaUp   += 1;
+      if ( jetEta>0 && ietaDown<=0 ) ietaDown -= 1;
+      for (int ieta=jetEta-size+1; ieta<jetEta+size; ++ieta) {
+	if (abs(ieta) > CaloTools::kHFEnd) continue;
+	int towEta = ieta;
+	if (jetEta>0 && towEta<=0) towEta-=1;
+	if (jetEta<0 && towEta>=0) towEta+=1;
+	ring[0] += towEt(towers, towEta, iphiUp);
+	ring[1] += towEt(towers, towEta, iphiDown);
+      }
+      for (int iphi=jetPhi-size+1; iphi<jetPhi+size; ++iphi) {
+	if (abs(ietaUp) <= CaloTools::kHFEnd-1) {
+	  int towPhi = iphi;
+	  while ( towPhi > CaloTools::kHBHENrPhi ) towPhi -= CaloTools::kHBHENrPhi;
+	  while ( towPhi < 1 ) towPhi += CaloTools::kHBHENrPhi;
+	  ring[2] += towEt(towers, ietaUp, towPhi);
+	} else {
+	  ring[2] = 0;
+	  break;
+	}
+      }
+      for (int iphi=jetPhi-size+1; iphi<jetPhi+size; ++iphi) {
+	if (abs(ietaDown) <= CaloTools::kHFEnd-1) {
+	  int towPhi = iphi;
+	  while ( towPhi > CaloTools::kHBHENrPhi ) towPhi -= CaloTools::kHBHENrPhi;
+	  while ( towPhi < 1 ) towPhi += CaloTools::kHBHENrPhi;
+	  ring[3] += towEt(towers, ietaDown, towPhi);
+	} else {
+	  ring[3] = 0;
+	  break;
+	}
+      }
+    }
+    std::sort( ring.begin(), ring.end() );
+    return ( ring[0] + ring[1] + ring[2] );
+  }
+
+  // Stage2Layer2JetAlgorithmFirmwareImp1::create reading getTower
+  void refJets(const l1t::CaloParamsHelper& params, const std::vector<l1t::CaloTower>& towers,
+	       std::vector<l1t::Jet>& jets, std::vector<l1t::Jet>& alljets,
+	       const std::string& PUSubMethod) {
+    std::vector<l1t::Jet>::iterator start, end;
+    for (int etaSide=1; etaSide>=-1; etaSide-=2) {
+      std::vector<int> ringGroup1, ringGroup2, ringGroup3, ringGroup4;
+      for (int i=1; i<=CaloTools::kHFEnd-5; i++) {
+	if      ( ! ((i-1)%4) ) ringGroup1.push_back( i * etaSide );
+	else if ( ! ((i-2)%4) ) ringGroup2.push_back( i * etaSide );
+	else if ( ! ((i-3)%4) ) ringGroup3.push_back( i * etaSide );
+	else if ( ! ((i-4)%4) ) ringGroup4.push_back( i * etaSide );
+      }
+      std::vector< std::vector<int> > theRings = { ringGroup1, ringGroup2, ringGroup3, ringGroup4 };
+      std::vector<l1t::Jet> jetsHalf;
+      for ( unsigned ringGroupIt=1; ringGroupIt<=theRings.size(); ringGroupIt++ ) {
+	std::vector<l1t::Jet> jetsAccu;
+	for ( unsigned ringIt=0; ringIt<theRings.at(ringGroupIt-1).size(); ringIt++ ) {
+	  int ieta = theRings.at(ringGroupIt-1).at(ringIt);
+	  std::vector<l1t::Jet> jetsRing;
+	  for ( int iphi=1; iphi<=CaloTools::kHBHENrPhi; ++iphi ) {
+	    if (jetsRing.size()==18) break;
+	    int seedEt = towEt(towers, ieta, iphi);
+	    int iEt = seedEt;
+	    bool vetoCandidate = false;
+	    if(iEt < floor(params.jetSeedThreshold()/params.towerLsbSum())) continue;
+	    for( int deta = -4; deta < 5; ++deta ) {
+	      for( int dphi = -4; dphi < 5; ++dphi ) {
+		int ietaTest = ieta+deta;
+		int iphiTest = iphi+dphi;
+		while ( iphiTest > CaloTools::kHBHENrPhi ) iphiTest -= CaloTools::kHBHENrPhi;
+		while ( iphiTest < 1 ) iphiTest += CaloTools::kHBHENrPhi;
+		if (ieta > 0 && ietaTest <=0) ietaTest -= 1;
+		if (ieta < 0 && ietaTest >=0) ietaTest += 1;
+		int et = towEt(towers, ietaTest, iphiTest);
+		if      (refMask[8-(dphi+4)][deta+4] == 0) continue;
+		else if (refMask[8-(dphi+4)][deta+4] == 1) vetoCandidate = (seedEt < et);
+		else if (refMask[8-(dphi+4)][deta+4] == 2) vetoCandidate = (seedEt <= et);
+		if (vetoCandidate) break;
+		else iEt += et;
+	      }
+	      if(vetoCandidate) break;
+	    }
+	    if (!vetoCandidate) {
+	      if (PUSubMethod == "Donut")       iEt -= refDonut(ieta, iphi, 5, towers);
+	      if (PUSubMethod == "ChunkyDonut") iEt -= refChunkyDonut(ieta, iphi, 5, towers);
+	      if (iEt<=0) continue;
+	      math::XYZTLorentzVector p4;
+	      l1t::Jet jet( p4, iEt, CaloTools::caloEta(ieta), iphi, 0);
+	      jetsRing.push_back(jet);
+	      alljets.push_back(jet);
+	    }
+	  }
+	  start = jetsRing.begin(); end = jetsRing.end();
+	  BitonicSort<l1t::Jet>(down, start, end);
+	  if (jetsRing.size()>6) jetsRing.resize(6);
+	  std::vector<l1t::Jet> jetsSort;
+	  jetsSort.insert(jetsSort.end(), jetsAccu.begin(), jetsAccu.end());
+	  jetsSort.insert(jetsSort.end(), jetsRing.begin(), jetsRing.end());
+	  start = jetsSort.begin(); end = jetsSort.end();
+	  BitonicSort<l1t::Jet>(down, start, end);
+	  if (jetsSort.size()>6) jetsSort.resize(6);
+	  jetsAccu = jetsSort;
+	}
+	jetsHalf.insert(jetsHalf.end(), jetsAccu.begin(), jetsAccu.end());
+      }
+      start = jetsHalf.begin(); end = jetsHalf.end();
+      BitonicSort<l1t::Jet>(down, start, end);
+      if (jetsHalf.size()>6) jetsHalf.resize(6);
+      jets.insert(jets.end(), jetsHalf.begin(), jetsHalf.end());
+    }
+  }
+
+  // Stage2Layer2EtSumAlgorithmFirmwareImp1::processEvent reading getTower
+  void refSums(const l1t::CaloParamsHelper& params, const std::vector<l1t::CaloTower>& towers,
+	       std::vector<l1t::EtSum>& etsums) {
+    const int32_t metTowThresholdHw = floor(params.etSumEtThreshold(0)/params.towerLsbSum());
+    const int32_t metTowThresholdHw2 = metTowThresholdHw;
+    const int32_t ettTowThresholdHw = floor(params.etSumEtThreshold(2)/params.towerLsbSum());
+    const int32_t metEtaMax = params.etSumEtaMax(0);
+    const int32_t metEtaMax2 = CaloTools::kHFEnd;
+    const int32_t ettEtaMax = params.etSumEtaMax(2);
+    for (int etaSide=1; etaSide>=-1; etaSide-=2) {
+      int32_t ex(0), ey(0), et(0);
+      int32_t ex2(0), ey2(0);
+      uint32_t mb0(0), mb1(0);
+      for (unsigned absieta=1; absieta<CaloTools::kHFEnd; absieta++) {
+	int ieta = etaSide * absieta;
+	int32_t ringEx(0), ringEy(0), ringEt(0);
+	int32_t ringEx2(0), ringEy2(0);
+	uint32_t ringMB0(0), ringMB1(0);
+	for (int iphi=1; iphi<=CaloTools::kHBHENrPhi; iphi++) {
+	  l1t::CaloTower tower = l1t::CaloTools::getTower(towers, ieta, iphi);
+	  if (tower.hwPt()>metTowThresholdHw && CaloTools::mpEta(abs(tower.hwEta()))<=metEtaMax) {
+	    ringEx += (int32_t) (tower.hwPt() * CaloTools::cos_coeff[iphi - 1] );
+	    ringEy += (int32_t) (tower.hwPt() * CaloTools::sin_coeff[iphi - 1] );
+	  }
+	  if (tower.hwPt()>metTowThresholdHw2 && CaloTools::mpEta(abs(tower.hwEta()))<=metEtaMax2) {
+	    ringEx2 += (int32_t) (tower.hwPt() * CaloTools::cos_coeff[iphi - 1] );
+	    ringEy2 += (int32_t) (tower.hwPt() * CaloTools::sin_coeff[iphi - 1] );
+	  }
+	  if (tower.hwPt()>ettTowThresholdHw && CaloTools::mpEta(abs(tower.hwEta()))<=ettEtaMax)
+	    ringEt += tower.hwPt();
+	  if (CaloTools::mpEta(abs(tower.hwEta()))>CaloTools::kHFBegin &&
+	      CaloTools::mpEta(abs(tower.hwEta()))<CaloTools::kHFEnd &&
+	      (tower.hwQual() & 0x4) > 0)
+	    ringMB1 += 1;
+	}
+	ex += ringEx;
+	ey += ringEy;
+	et += ringEt;
+	ex2 += ringEx2;
+	ey2 += ringEy2;
+	mb0 += ringMB0;
+	mb1 += ringMB1;
+      }
+      if (mb0>0xf) mb0 = 0xf;
+      if (mb1>0xf) mb1 = 0xf;
+      math::XYZTLorentzVector p4;
+      l1t::EtSum::EtSumType type0 = l1t::EtSum::EtSumType::kMinBiasHFP0;
+      l1t::EtSum::EtSumType type1 = l1t::EtSum::EtSumType::kMinBiasHFP1;
+      if (etaSide<0) {
+	type0 = l1t::EtSum::EtSumType::kMinBiasHFM0;
+	type1 = l1t::EtSum::EtSumType::kMinBiasHFM1;
+      }
+      etsums.push_back(l1t::EtSum(p4,l1t::EtSum::EtSumType::kTotalEt,et,0,0,0));
+      etsums.push_back(l1t::EtSum(p4,l1t::EtSum::EtSumType::kTotalEtx,ex,0,0,0));
+      etsums.push_back(l1t::EtSum(p4,l1t::EtSum::EtSumType::kTotalEty,ey,0,0,0));
+      etsums.push_back(l1t::EtSum(p4,l1t::EtSum::EtSumType::kTotalEtx2,ex2,0,0,0));
+      etsums.push_back(l1t::EtSum(p4,l1t::EtSum::EtSumType::kTotalEty2,ey2,0,0,0));
+      etsums.push_back(l1t::EtSum(p4,type0,mb0,0,0,0));
+      etsums.push_back(l1t::EtSum(p4,type1,mb1,0,0,0));
+    }
+  }
+
+  l1t::CaloTower makeTower(int ieta, int iphi, std::mt19937& gen) {
+    // mostly soft towers with a few hard ones, so that jets are found
+    std::exponential_distribution<double> soft(0.3);
+    std::uniform_int_distribution<int> hard(0, 400);
+    std::uniform_int_distribution<int> u(0, 99);
+    std::uniform_int_distribution<int> qual(0, 15);
+    math::XYZTLorentzVector p4;
+    const int pt = (u(gen)<3) ? hard(gen) : std::min(511, int(soft(gen)));
+    const int em = std::min(pt, hard(gen));
+    return l1t::CaloTower(p4, 0., 0., pt, ieta, iphi, qual(gen), em, pt-em, 0);
+  }
+
+  // all towers, at their hashed position where it is free
+  std::vector<l1t::CaloTower> producerTowers(std::mt19937& gen) {
+    std::vector<l1t::CaloTower> towers(CaloTools::caloTowerHashMax());
+    std::vector<l1t::CaloTower> extra;
+    std::vector<bool> used(towers.size(), false);
+    for (int ieta=-CaloTools::kHFEnd; ieta<=CaloTools::kHFEnd; ++ieta) {
+      if (ieta==0) continue;
+      for (int iphi=1; iphi<=CaloTools::kHBHENrPhi; ++iphi) {
+	const size_t hash = CaloTools::caloTowerHash(ieta, iphi);
+	if (hash<towers.size() && !used[hash]) {
+	  towers[hash] = makeTower(ieta, iphi, gen);
+	  used[hash] = true;
+	} else {
+	  extra.push_back(makeTower(ieta, iphi, gen));
+	}
+      }
+    }
+    towers.insert(towers.end(), extra.begin(), extra.end());
+    return towers;
+  }
+
+  bool sameJets(const std::vector<l1t::Jet>& a, const std::vector<l1t::Jet>& b) {
+    if (a.size()!=b.size()) return false;
+    for (size_t i=0; i<a.size(); i++) {
+      if (a[i].hwPt()!=b[i].hwPt() || a[i].hwEta()!=b[i].hwEta() ||
+	  a[i].hwPhi()!=b[i].hwPhi() || a[i].hwQual()!=b[i].hwQual()) return false;
+    }
+    return true;
+  }
+
+}
+
+int main()
+{
+  std::mt19937 gen(4711);
+
+  l1t::CaloParamsHelper params;
+  params.setTowerLsbSum(0.5);
+  params.setJetSeedThreshold(1.5);
+  params.setEtSumEtThreshold(0, 0.5);
+  params.setEtSumEtThreshold(2, 1.0);
+  params.setEtSumEtaMax(0, 28);
+  params.setEtSumEtaMax(2, 40);
+
+  l1t::Stage2Layer2JetAlgorithmFirmwareImp1 jetAlgo(&params);
+  l1t::Stage2Layer2EtSumAlgorithmFirmwareImp1 sumAlgo(&params);
+
+  const char* layouts[] = { "producer", "shuffled", "towers missing", "duplicates", "eta=0 towers" };
+  const char* pusMethods[] = { "None", "Donut", "ChunkyDonut" };
+  unsigned nFail(0);
+
+  for (unsigned ev=0; ev<20; ev++) {
+    for (unsigned layout=0; layout<5; layout++) {
+      std::vector<l1t::CaloTower> towers = producerTowers(gen);
+      if (layout==1) {
+	std::shuffle(towers.begin(), towers.end(), gen);
+      } else if (layout==2) {
+	std::uniform_int_distribution<int> u(0, 9);
+	std::vector<l1t::CaloTower> kept;
+	for (const auto& t : towers) if (u(gen)>2) kept.push_back(t);
+	towers.swap(kept);
+      } else if (layout==3) {
+	std::uniform_int_distribution<size_t> u(0, towers.size()-1);
+	for (int i=0; i<500; i++) {
+	  l1t::CaloTower t = towers[u(gen)];
+	  t.setHwPt(t.hwPt()+7);
+	  towers.push_back(t);
+	}
+      } else if (layout==4) {
+	for (int iphi=1; iphi<=CaloTools::kHBHENrPhi; iphi++) towers.push_back(makeTower(0, iphi, gen));
+      }
+
+      // tower by tower
+      const l1t::CaloTowerGrid grid(towers);
+      for (int ieta=-CaloTools::kHFEnd; ieta<=CaloTools::kHFEnd; ieta++) {
+	for (int iphi=1; iphi<=CaloTools::kNPhi; iphi++) {
+	  const l1t::CaloTower& tow = CaloTools::getTower(towers, ieta, iphi);
+	  if (tow.hwPt()!=grid.hwPt(ieta,iphi) || tow.hwEtEm()!=grid.hwEtEm(ieta,iphi) ||
+	      tow.hwEtHad()!=grid.hwEtHad(ieta,iphi) || tow.hwQual()!=grid.hwQual(ieta,iphi)) {
+	    std::cout << layouts[layout] << ": tower " << ieta << "," << iphi << " differs" << std::endl;
+	    nFail++;
+	  }
+	}
+      }
+
+      // energy sums, including the int32_t cos_coeff/sin_coeff products
+      std::vector<l1t::EtSum> sums;
+      sumAlgo.processEvent(towers, sums);
+      std::vector<l1t::EtSum> refSum;
+      refSums(params, towers, refSum);
+      bool sumsOk = (sums.size()==refSum.size());
+      for (size_t i=0; sumsOk && i<sums.size(); i++)
+	sumsOk = (sums[i].hwPt()==refSum[i].hwPt() && sums[i].getType()==refSum[i].getType());
+      if (!sumsOk) {
+	std::cout << layouts[layout] << ": energy sums differ" << std::endl;
+	nFail++;
+      }
+
+      // jets with each pile-up subtraction
+      for (const char* pus : pusMethods) {
+	std::vector<l1t::Jet> jets, alljets, refJet, refAll;
+	jetAlgo.create(towers, jets, alljets, pus);
+	refJets(params, towers, refJet, refAll, pus);
+	if (!sameJets(jets, refJet) || !sameJets(alljets, refAll)) {
+	  std::cout << layouts[layout] << ", " << pus << ": jets differ" << std::endl;
+	  nFail++;
+	}
+      }
+    }
+  }
+
+  std::cout << (nFail==0 ? "OK" : "FAILED") << std::endl;
+  return nFail==0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -51,6 +51,10 @@ class Forest
         void appendCorrection(Event* e, Int_t treenum);
         void predictEvent(Event* e, unsigned int trees);
 
+        // Predict from a plain array of variables, with the flattened trees.
+        // Gives the same result as predictEvent, without creating an Event.
+        Double_t predict(const Double_t* data, unsigned int trees) const;
+
         Tree* getTree(unsigned int i);
 
     private:
@@ -58,6 +62,21 @@ class Forest
         std::vector< std::vector<Event*> > events;
         std::vector< std::vector<Event*> > subSample;
         std::vector<Tree*> trees;
+
+        // The loaded trees copied into one contiguous array, in depth first
+        // order so that the left daughter of a node is the next node.
+        struct FlatNode
+        {
+            Double_t splitValue;
+            Double_t fitValue;
+            Int_t splitVariable;
+            Int_t rightDaughter;    // -1 for a terminal node
+        };
+        std::vector<FlatNode> flatNodes;
+        std::vector<unsigned int> flatRoots;
+
+        void flatten();
+        void flattenRecursive(Node* node);
 };
 
 #endif
@@ -502,9 +502,80 @@ void Forest::loadForestFromXML(const char* directory, unsigned int numTrees)
 		trees[i]->loadFromXML(edm::FileInPath(ss.str().c_str()).fullPath().c_str());
     }   
 
+    // Lay the trees out for predict().
+    flatten();
+
    // std::cout << "Done." << std::endl << std::endl;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// ----------------------------------------------------------------------
+//////////////////////////////////////////////////////////////////////////
+
+void Forest::flatten()
+{
+// Copy the trees into flatNodes, one after the other.
+
+    flatNodes.clear();
+    flatRoots.clear();
+    for(unsigned int i=0; i < trees.size(); i++)
+    {
+        flatRoots.push_back(flatNodes.size());
+        flattenRecursive(trees[i]->getRootNode());
+    }
+}
+
+void Forest::flattenRecursive(Node* node)
+{
+// Store the node, then its left and its right subtree.
+
+    unsigned int index = flatNodes.size();
+    FlatNode flat;
+    flat.splitValue = node->getSplitValue();
+    flat.fitValue = node->getFitValue();
+    flat.splitVariable = node->getSplitVariable();
+    flat.rightDaughter = -1;
+    flatNodes.push_back(flat);
+
+    // Same definition of a terminal node as Node::filterEventToDaughter.
+    Node* left = node->getLeftDaughter();
+    Node* right = node->getRightDaughter();
+    if(left==0 || right==0) return;
+
+    flattenRecursive(left);
+    flatNodes[index].rightDaughter = flatNodes.size();
+    flattenRecursive(right);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ----------------------------------------------------------------------
+//////////////////////////////////////////////////////////////////////////
+
+Double_t Forest::predict(const Double_t* data, unsigned int numtrees) const
+{
+// Sum the corrections of the first numtrees trees, as predictEvent does
+// starting from a zero prediction.
+
+    if(numtrees > flatRoots.size()) numtrees = flatRoots.size();
+
+    Double_t prediction = 0;
+    for(unsigned int i=0; i < numtrees; i++)
+    {
+        unsigned int n = flatRoots[i];
+        while(flatNodes[n].rightDaughter >= 0)
+        {
+            const FlatNode& node = flatNodes[n];
+            Double_t x = data[node.splitVariable];
+            // A value equal to the split point stops at this node.
+            if(x < node.splitValue) n = n+1;
+            else if(x > node.splitValue) n = node.rightDaughter;
+            else break;
+        }
+        prediction += flatNodes[n].fitValue;
+    }
+    return prediction;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // ___________________Stochastic_Sampling_&_Regression__________________//
 //////////////////////////////////////////////////////////////////////////
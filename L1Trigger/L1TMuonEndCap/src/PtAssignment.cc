@@ -435,14 +435,7 @@ static float getEtafromBin(int etaBin, int bits=5)
 float EmtfPtAssignment::calculatePt(unsigned long Address)
 {
   bool verbose = false;
-  int ModeVariables[13][6];
-
-  //FIXME: use pointer to avoid a copy:
-  for (int i=0;i<13;i++) {
-    for (int j=0;j<6;j++) {
-      ModeVariables[i][j] = ModeVariables_Scheme3[i][j];
-    }
-  }
+  const int (*ModeVariables)[6] = ModeVariables_Scheme3;
   
   int dphi[6] = {-999,-999,-999,-999,-999,-999}, deta[6] = {-999,-999,-999,-999,-999,-999};
   int clct[4] = {-999,-999,-999,-999}, cscid[4] = {-999,-999,-999,-999};
@@ -798,28 +791,24 @@ float EmtfPtAssignment::calculatePt(unsigned long Address)
       if(i != mode_inv)
 	continue;
 			    
-      vector<Double_t> Data;
-      Data.push_back(1.0);
-      Data.push_back(eta);
+      // at most 2+6 variables: evaluate on the stack, with the flattened forest
+      Double_t Data[8];
+      int nData = 0;
+      Data[nData++] = 1.0;
+      Data[nData++] = eta;
       for(int y=0;y<size[mode_inv-3];y++){
-	Data.push_back(Variables[ModeVariables[mode_inv-3][y]]);
+	Data[nData++] = Variables[ModeVariables[mode_inv-3][y]];
 	if(verbose) cout<<"Generalized Variables "<<y<<" "<<Variables[ModeVariables[mode_inv-3][y]]<<"\n";
       }
 		
       if(verbose){
-	cout<<"Data.size() = "<<Data.size()<<"\n";
-	for(int i=0;i<5;i++)  
+	cout<<"Data.size() = "<<nData<<"\n";
+	for(int i=0;i<5 && i<nData;i++)  
 	  cout<<"Data["<<i<<"] = "<<Data[i]<<"\n";
       }
 		
-      Event *event = new Event();
-      event->data = Data;
-		
-      forest_[mode_inv].predictEvent(event,64);
-      float OpT = event->predictedValue;
+      float OpT = forest_[mode_inv].predict(Data,64);
       MpT = 1/OpT;
-
-      delete event;
     
       if (MpT<0.0) MpT = 1.0;
       if (MpT>200.0) MpT = 200.0;
@@ -15,6 +15,7 @@
 
 #include "DataFormats/Candidate/interface/CandidateFwd.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/Candidate/interface/CandidateEtaPhiIndex.h"
 #include "PhysicsTools/IsolationAlgos/interface/CITKIsolationConeDefinitionBase.h"
 #include "DataFormats/Common/interface/OwnVector.h"
 
@@ -24,6 +25,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <algorithm>
 
 namespace edm { class Event; }
 namespace edm { class EventSetup; }
@@ -49,6 +51,10 @@ namespace citk {
     typedef edm::View<reco::Candidate> CandView;
     const TypeMap _typeMap;
     edm::EDGetTokenT<CandView> _to_isolate, _isolate_with;
+    // optional eta-phi index of _isolate_with, shared with the other isolation producers
+    edm::EDGetTokenT<reco::CandidateEtaPhiIndex> _isolate_with_index;
+    bool _use_index;
+    float _max_cone_size;
     // indexed by pf candidate type
     std::array<IsoTypes,kNPFTypes> _isolation_types; 
     std::array<std::vector<std::string>,kNPFTypes> _product_names;
@@ -72,12 +78,20 @@ namespace citk {
       consumes<CandView>(c.getParameter<edm::InputTag>("srcToIsolate"));
     _isolate_with = 
       consumes<CandView>(c.getParameter<edm::InputTag>("srcForIsolationCone"));
+    _use_index = c.existsAs<edm::InputTag>("srcForIsolationConeIndex") &&
+      !c.getParameter<edm::InputTag>("srcForIsolationConeIndex").label().empty();
+    if( _use_index ) {
+      _isolate_with_index =
+	consumes<reco::CandidateEtaPhiIndex>(c.getParameter<edm::InputTag>("srcForIsolationConeIndex"));
+    }
+    _max_cone_size = 0.f;
     const std::vector<edm::ParameterSet>& isoDefs = 
       c.getParameterSetVector("isolationConeDefinitions");
     for( const auto& isodef : isoDefs ) {
       const std::string& name = 
 	isodef.getParameter<std::string>("isolationAlgo");
       const float coneSize = isodef.getParameter<double>("coneSize");
+      _max_cone_size = std::max(_max_cone_size, coneSize);
       char buf[50];
       sprintf(buf,"DR%.2f",coneSize);
       std::string coneName(buf);
@@ -130,7 +144,24 @@ namespace citk {
 	isolator->getEventInfo(ev);
       }
     }
-    reco::PFCandidate helper; // to translate pdg id to type    
+    // the candidate types are the same for all the objects to isolate:
+    // translate them once per event
+    reco::PFCandidate helper; // to translate pdg id to type
+    std::vector<int> isotypes(isolate_with->size());
+    for( size_t ic = 0; ic < isolate_with->size(); ++ic ) {
+      isotypes[ic] = helper.translatePdgIdToType((*isolate_with)[ic].pdgId());
+    }
+    const reco::CandidateEtaPhiIndex* index = nullptr;
+    if( _use_index ) {
+      edm::Handle<reco::CandidateEtaPhiIndex> index_handle;
+      ev.getByToken(_isolate_with_index,index_handle);
+      if( index_handle->id() != isolate_with.id() ) {
+	throw cms::Exception("InvalidIsolationIndex")
+	  << "The eta-phi index given as srcForIsolationConeIndex was not "
+	  << "built from srcForIsolationCone!";
+      }
+      index = index_handle.product();
+    }
     // loop over the candidates we are isolating and fill the values
     for( size_t c = 0; c < to_isolate->size(); ++c ) {
       auto cand_to_isolate = to_isolate->ptrAt(c);
@@ -141,15 +172,23 @@ namespace citk {
 	for( auto& value : cand_values[k] ) value = 0.0;
 	++k;
       }
-      for( size_t ic = 0; ic < isolate_with->size(); ++ic ) {
+      auto add_to_cone = [&]( size_t ic ) {
+        const auto& isolations = _isolation_types[isotypes[ic]];
+        if( isolations.empty() ) return;
         auto isocand = isolate_with->ptrAt(ic);
-	auto isotype = helper.translatePdgIdToType(isocand->pdgId());	
-	const auto& isolations = _isolation_types[isotype];	
 	for( unsigned i = 0; i < isolations.size(); ++ i  ) {
 	  if( isolations[i]->isInIsolationCone(cand_to_isolate,isocand) ) {
-	    cand_values[isotype][i] += isocand->pt();
+	    cand_values[isotypes[ic]][i] += isocand->pt();
 	  }
 	}
+      };
+      // all the cone definitions require deltaR < coneSize, so only the
+      // candidates within the largest cone need to be tested
+      if( index != nullptr ) {
+	index->forEachInCone(cand_to_isolate->eta(), cand_to_isolate->phi(),
+			     _max_cone_size, add_to_cone);
+      } else {
+	for( size_t ic = 0; ic < isolate_with->size(); ++ic ) add_to_cone(ic);
       }
       // add this candidate to isolation value list
       for( unsigned i = 0; i < kNPFTypes; ++i ) {
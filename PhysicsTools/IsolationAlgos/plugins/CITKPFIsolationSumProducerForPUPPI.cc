@@ -11,6 +11,7 @@
 #include "PhysicsTools/IsolationAlgos/interface/EventDependentAbsVeto.h"
 #include "DataFormats/Candidate/interface/CandidateFwd.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/Candidate/interface/CandidateEtaPhiIndex.h"
 #include "PhysicsTools/IsolationAlgos/interface/CITKIsolationConeDefinitionBase.h"
 #include "DataFormats/Common/interface/OwnVector.h"
 
@@ -20,6 +21,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <algorithm>
 
 //module to compute isolation sum weighted with PUPPI weights
 namespace citk {
@@ -43,6 +45,10 @@ namespace citk {
     typedef edm::View<reco::Candidate> CandView;
     const TypeMap _typeMap;
     edm::EDGetTokenT<CandView> _to_isolate, _isolate_with;
+    // optional eta-phi index of _isolate_with, shared with the other isolation producers
+    edm::EDGetTokenT<reco::CandidateEtaPhiIndex> _isolate_with_index;
+    bool _use_index;
+    float _max_cone_size;
     edm::EDGetTokenT<edm::ValueMap<float> > puppiValueMapToken_;//for puppiValueMap
     edm::Handle<edm::ValueMap<float>> puppiValueMap;//puppiValueMap
     // indexed by pf candidate type
@@ -69,6 +75,13 @@ namespace citk {
       consumes<CandView>(c.getParameter<edm::InputTag>("srcToIsolate"));
     _isolate_with = 
       consumes<CandView>(c.getParameter<edm::InputTag>("srcForIsolationCone"));
+    _use_index = c.existsAs<edm::InputTag>("srcForIsolationConeIndex") &&
+      !c.getParameter<edm::InputTag>("srcForIsolationConeIndex").label().empty();
+    if( _use_index ) {
+      _isolate_with_index =
+	consumes<reco::CandidateEtaPhiIndex>(c.getParameter<edm::InputTag>("srcForIsolationConeIndex"));
+    }
+    _max_cone_size = 0.f;
       if (c.getParameter<edm::InputTag>("puppiValueMap").label().size() != 0) {
         puppiValueMapToken_ = mayConsume<edm::ValueMap<float>>(c.getParameter<edm::InputTag>("puppiValueMap")); //getting token for puppiValueMap
         useValueMapForPUPPI = true;
@@ -80,6 +93,7 @@ namespace citk {
       const std::string& name = 
 	isodef.getParameter<std::string>("isolationAlgo");
       const float coneSize = isodef.getParameter<double>("coneSize");
+      _max_cone_size = std::max(_max_cone_size, coneSize);
       char buf[50];
       std::sprintf(buf,"DR%.2f",coneSize);
       std::string coneName(buf);
@@ -134,7 +148,24 @@ namespace citk {
 	isolator->getEventInfo(ev);
       }
     }
-    reco::PFCandidate helper; // to translate pdg id to type    
+    // the candidate types are the same for all the objects to isolate:
+    // translate them once per event
+    reco::PFCandidate helper; // to translate pdg id to type
+    std::vector<int> isotypes(isolate_with->size());
+    for( size_t ic = 0; ic < isolate_with->size(); ++ic ) {
+      isotypes[ic] = helper.translatePdgIdToType((*isolate_with)[ic].pdgId());
+    }
+    const reco::CandidateEtaPhiIndex* index = nullptr;
+    if( _use_index ) {
+      edm::Handle<reco::CandidateEtaPhiIndex> index_handle;
+      ev.getByToken(_isolate_with_index,index_handle);
+      if( index_handle->id() != isolate_with.id() ) {
+	throw cms::Exception("InvalidIsolationIndex")
+	  << "The eta-phi index given as srcForIsolationConeIndex was not "
+	  << "built from srcForIsolationCone!";
+      }
+      index = index_handle.product();
+    }
     // loop over the candidates we are isolating and fill the values
     for( size_t c = 0; c < to_isolate->size(); ++c ) {
       auto cand_to_isolate = to_isolate->ptrAt(c);
@@ -145,20 +176,27 @@ namespace citk {
 	for( auto& value : cand_values[k] ) value = 0.0;
 	++k;
       }
-      for( size_t ic = 0; ic < isolate_with->size(); ++ic ) {
+      auto add_to_cone = [&]( size_t ic ) {
+        const auto& isolations = _isolation_types[isotypes[ic]];
+        if( isolations.empty() ) return;
         auto isocand = isolate_with->ptrAt(ic);
-        edm::Ptr<pat::PackedCandidate> aspackedCandidate(isocand);
-        auto isotype = helper.translatePdgIdToType(isocand->pdgId());	
-	      const auto& isolations = _isolation_types[isotype];	
-    	   for( unsigned i = 0; i < isolations.size(); ++ i  ) {
-    	  if( isolations[i]->isInIsolationCone(cand_to_isolate,isocand) ) {
+	for( unsigned i = 0; i < isolations.size(); ++ i  ) {
+	  if( isolations[i]->isInIsolationCone(cand_to_isolate,isocand) ) {
           double puppiWeight = 0.;
-    	    if (!useValueMapForPUPPI) puppiWeight = aspackedCandidate -> puppiWeight(); // if miniAOD, take puppiWeight directly from the object
+          if (!useValueMapForPUPPI) puppiWeight = edm::Ptr<pat::PackedCandidate>(isocand) -> puppiWeight(); // if miniAOD, take puppiWeight directly from the object
           else  puppiWeight = (*puppiValueMap)[isocand]; // if AOD, take puppiWeight from the valueMap
-          if (puppiWeight > 0.)cand_values[isotype][i] += (isocand->pt())*puppiWeight; // this is basically the main change to Lindsey's code: scale pt with puppiWeight for candidates with puppiWeight > 0.
-    	  }
-    	}
-    }
+          if (puppiWeight > 0.)cand_values[isotypes[ic]][i] += (isocand->pt())*puppiWeight; // this is basically the main change to Lindsey's code: scale pt with puppiWeight for candidates with puppiWeight > 0.
+	  }
+	}
+      };
+      // all the cone definitions require deltaR < coneSize, so only the
+      // candidates within the largest cone need to be tested
+      if( index != nullptr ) {
+	index->forEachInCone(cand_to_isolate->eta(), cand_to_isolate->phi(),
+			     _max_cone_size, add_to_cone);
+      } else {
+	for( size_t ic = 0; ic < isolate_with->size(); ++ic ) add_to_cone(ic);
+      }
       // add this candidate to isolation value list
       for( unsigned i = 0; i < kNPFTypes; ++i ) {
 	for( unsigned j = 0; j < cand_values[i].size(); ++j ) {
@@ -0,0 +1,58 @@
+/* \class CandidateEtaPhiIndexProducer
+ *
+ * Indexes a candidate collection (typically particleFlow or
+ * packedPFCandidates) on an eta-phi grid, once per event, for the
+ * cone queries of the isolation producers
+ *
+ */
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/Candidate/interface/CandidateEtaPhiIndex.h"
+
+#include <memory>
+
+class CandidateEtaPhiIndexProducer : public edm::global::EDProducer<> {
+public:
+  explicit CandidateEtaPhiIndexProducer(const edm::ParameterSet& conf) :
+    src_(consumes<edm::View<reco::Candidate> >(conf.getParameter<edm::InputTag>("src"))),
+    cellSize_(conf.getParameter<double>("cellSize")),
+    etaMax_(conf.getParameter<double>("etaMax")) {
+    produces<reco::CandidateEtaPhiIndex>();
+  }
+
+  static void fillDescriptions(edm::ConfigurationDescriptions& descriptions);
+
+  void produce(edm::StreamID, edm::Event &, edm::EventSetup const &) const override final;
+
+private:
+  const edm::EDGetTokenT<edm::View<reco::Candidate> > src_;
+  const float cellSize_;
+  const float etaMax_;
+};
+
+void CandidateEtaPhiIndexProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+  edm::ParameterSetDescription desc;
+  desc.add<edm::InputTag>("src", edm::InputTag("packedPFCandidates"));
+  desc.add<double>("cellSize", 0.2)->setComment("Size of the eta-phi cells, of the order of the isolation cones");
+  desc.add<double>("etaMax", 5.0)->setComment("Candidates beyond the eta range are kept in the outermost cells");
+  descriptions.add("candidateEtaPhiIndex", desc);
+}
+
+void CandidateEtaPhiIndexProducer::produce(edm::StreamID,
+                                           edm::Event& evt,
+                                           const edm::EventSetup& es ) const {
+  edm::Handle<edm::View<reco::Candidate> > input;
+  evt.getByToken(src_, input);
+
+  std::unique_ptr<reco::CandidateEtaPhiIndex> output(new reco::CandidateEtaPhiIndex(*input, input.id(), cellSize_, etaMax_));
+  evt.put(std::move(output));
+}
+
+DEFINE_FWK_MODULE(CandidateEtaPhiIndexProducer);